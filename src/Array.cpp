@@ -0,0 +1,107 @@
+//
+//  Array.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#include "Array.h"
+
+const ofColor PdArray::ARRAY_BG_COLOR = ofColor(255, 255, 255);
+const ofColor PdArray::ARRAY_LINE_COLOR = ofColor(0, 0, 0);
+
+PdArray::PdArray(ofVec2f position, ofVec2f size, PdSymbol arrayName, size_t arraySize,
+                 float bottom, float top, bool drawPoints)
+    : PdGuiObject(GuiType::ARRAY, position, size, PdSymbol(), arrayName)
+    , drawPoints(drawPoints)
+    , samples(max<size_t>(1, arraySize), 0.0f)
+    , points(samples.size())
+    , pointsSize(0, 0)
+    , dirtyBegin(0)
+    , dirtyEnd(0)
+{
+    // Les valeurs ne passent pas par currentValue
+    minValue = bottom;
+    maxValue = top;
+    invalidatePoints(0, samples.size());
+}
+
+void PdArray::receiveSamples(size_t offset, const float* values, size_t count) {
+    // Valeurs hors du tableau ignorées, comme [tabwrite]
+    if (offset >= samples.size()) return;
+    count = min(count, samples.size() - offset);
+    
+    memcpy(&samples[offset], values, count * sizeof(float));
+    invalidatePoints(offset, offset + count);
+    markForUpdate();
+}
+
+void PdArray::setValueRange(float min, float max) {
+    minValue = min;
+    maxValue = max;
+    invalidatePoints(0, samples.size());
+    markForUpdate();
+}
+
+void PdArray::draw() {
+    uploadPoints();
+    
+    ofFill();
+    ofSetColor(ARRAY_BG_COLOR);
+    ofDrawRectangle(0, 0, size.x, size.y);
+    
+    // Toute la courbe en un appel
+    ofSetColor(ARRAY_LINE_COLOR);
+    if (drawPoints) {
+        glPointSize(2.0f);
+    }
+    vbo.draw(drawPoints ? GL_POINTS : GL_LINE_STRIP, 0, (int)points.size());
+    
+    ofSetColor(DEFAULT_BORDER_COLOR);
+    ofNoFill();
+    ofDrawRectangle(0, 0, size.x, size.y);
+    ofFill();
+}
+
+void PdArray::invalidatePoints(size_t begin, size_t end) {
+    if (dirtyBegin >= dirtyEnd) {
+        dirtyBegin = begin;
+        dirtyEnd = end;
+    } else {
+        dirtyBegin = min(dirtyBegin, begin);
+        dirtyEnd = max(dirtyEnd, end);
+    }
+}
+
+void PdArray::uploadPoints() {
+    // Nouvelle taille (rechargement du patch) : toutes les abscisses changent
+    if (pointsSize != size) {
+        pointsSize = size;
+        invalidatePoints(0, samples.size());
+    }
+    
+    bool allocated = vertexBuffer.isAllocated();
+    if (allocated && dirtyBegin >= dirtyEnd) return;
+    
+    float xStep = size.x / max<size_t>(1, samples.size() - 1);
+    float range = maxValue - minValue;
+    float yScale = range != 0.0f ? size.y / range : 0.0f;
+    
+    for (size_t i = dirtyBegin; i < dirtyEnd; i++) {
+        // Courbe coupée aux bords du graphe
+        float y = ofClamp((maxValue - samples[i]) * yScale, 0.0f, size.y);
+        points[i] = glm::vec2(i * xStep, y);
+    }
+    
+    if (!allocated) {
+        // Allocation dans le contexte GL de la fenêtre qui dessine l'objet
+        vertexBuffer.allocate(points.size() * sizeof(glm::vec2), points.data(), GL_STREAM_DRAW);
+        vbo.setVertexBuffer(vertexBuffer, 2, sizeof(glm::vec2));
+    } else {
+        // Une seule recopie partielle par frame
+        vertexBuffer.updateData(dirtyBegin * sizeof(glm::vec2), (dirtyEnd - dirtyBegin) * sizeof(glm::vec2),
+                                &points[dirtyBegin]);
+    }
+    
+    dirtyBegin = dirtyEnd = 0;
+}
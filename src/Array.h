@@ -0,0 +1,63 @@
+//
+//  Array.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#pragma once
+
+#include "PdGuiObject.h"
+#include <vector>
+
+// Tableau Pd affiché dans un graphe (#X array dans un "#X restore ... graph").
+// Les valeurs arrivent du thread audio par PdMessageRouter::pushSamples() ;
+// à chaque frame, seule la plage modifiée est recopiée dans le tampon de
+// sommets du GPU, et la courbe entière part en un seul appel de dessin.
+class PdArray : public PdGuiObject {
+public:
+    static const ofColor ARRAY_BG_COLOR;
+    static const ofColor ARRAY_LINE_COLOR;
+    
+    // bottom, top : valeurs aux bords bas et haut du graphe
+    PdArray(ofVec2f position, ofVec2f size, PdSymbol arrayName, size_t arraySize,
+            float bottom = -1.0f, float top = 1.0f, bool drawPoints = false);
+    
+    // Méthodes virtuelles de PdGuiObject
+    void update() override {}
+    void draw() override;
+    
+    // Affichage seulement : les clics passent à travers
+    bool onMousePressed(ofMouseEventArgs& args) override { return false; }
+    bool onMouseDragged(ofMouseEventArgs& args) override { return false; }
+    bool onMouseReleased(ofMouseEventArgs& args) override { return false; }
+    bool onMouseMoved(ofMouseEventArgs& args) override { return false; }
+    
+    void receiveFloat(float value) override {}
+    void receiveBang() override {}
+    void receiveSamples(size_t offset, const float* samples, size_t count) override;
+    
+    // Plage de valeurs du graphe (bas, haut)
+    void setValueRange(float min, float max) override;
+    
+    const std::vector<float>& getSamples() const { return samples; }
+    size_t getArraySize() const { return samples.size(); }
+
+private:
+    bool drawPoints;
+    
+    // Copie des valeurs et sommets en coordonnées locales
+    std::vector<float> samples;
+    std::vector<glm::vec2> points;
+    ofVec2f pointsSize;
+    
+    // Plage de sommets à recalculer et à envoyer au GPU
+    size_t dirtyBegin;
+    size_t dirtyEnd;
+    
+    ofBufferObject vertexBuffer;
+    ofVbo vbo;
+    
+    void invalidatePoints(size_t begin, size_t end);
+    void uploadPoints();
+};
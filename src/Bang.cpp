@@ -17,13 +17,16 @@ const ofColor PdBang::BANG_HOVER_COLOR = ofColor(250, 250, 250);
 const float PdBang::TRIGGER_DURATION = 300.0f;
 
 PdBang::PdBang(ofVec2f position, ofVec2f size,
-               const string& sendSymbol, const string& receiveSymbol)
+               PdSymbol sendSymbol, PdSymbol receiveSymbol)
     : PdGuiObject(GuiType::BANG, position, size, sendSymbol, receiveSymbol)
 {
     // Initialiser les valeurs spécifiques au bang
     minValue = 0.0f;
     maxValue = 1.0f;
     currentValue = 0.0f;
+    
+    // Chaque changement d'état doit arriver à Pd
+    sendPolicy = PdSendPolicy::IMMEDIATE;
     triggered = false;
     triggerTime = 0.0f;
 }
@@ -34,6 +37,7 @@ void PdBang::update() {
         float currentTime = ofGetElapsedTimeMillis();
         if (currentTime - triggerTime >= TRIGGER_DURATION) {
             triggered = false;
+            markForUpdate(); // Effacer le cercle plein dans le FBO
         }
     }
 }
@@ -53,6 +57,19 @@ void PdBang::draw() {
     //drawLabel();
 }
 
+bool PdBang::drawBatched(PdPrimitiveBatch& batch) {
+    batch.addRect(0, 0, size.x, size.y, getStateColor());
+    
+    if (triggered) {
+        batch.addCircle(size.x / 2.0f, size.y / 2.0f, getCircleRadius(), BANG_CIRCLE_COLOR);
+    } else {
+        batch.addCircleOutline(size.x / 2.0f, size.y / 2.0f, getCircleRadius(), BANG_CIRCLE_COLOR);
+    }
+    
+    batch.addRectOutline(0, 0, size.x, size.y, getBorderColor());
+    return true;
+}
+
 bool PdBang::onMousePressed(ofMouseEventArgs& args) {
     // Appeler la méthode de base pour la gestion générale
     bool handled = PdGuiObject::onMousePressed(args);
@@ -73,13 +90,30 @@ bool PdBang::onMouseReleased(ofMouseEventArgs& args) {
     return PdGuiObject::onMouseReleased(args);
 }
 
+void PdBang::receiveFloat(float value) {
+    trigger();
+}
+
+void PdBang::receiveBang() {
+    trigger();
+}
+
 void PdBang::trigger() {
     // Activer le bang et enregistrer le temps
     triggered = true;
     triggerTime = ofGetElapsedTimeMillis();
+    // Déjà allumé : le flash est prolongé sans redessin
+    markIfRenderChanged();
+    
+    // Un seul réveil, à la fin du flash
+    scheduleUpdate((uint64_t)(TRIGGER_DURATION * 1000.0f));
 }
 
-void PdBang::drawBangState() {
+uint64_t PdBang::computeRenderKey() const {
+    return getBaseRenderKey() | ((uint64_t)triggered << 4);
+}
+
+ofColor PdBang::getStateColor() const {
     // Couleur de fond
     ofColor bgColor = BANG_BG_COLOR;
     
@@ -95,13 +129,10 @@ void PdBang::drawBangState() {
         bgColor = bgColor * 0.5f;
     }
     
-    // Dessiner le rectangle de fond
-    ofSetColor(bgColor);
-    ofFill();
-    ofDrawRectangle(0, 0, size.x, size.y);
+    return bgColor;
 }
 
-void PdBang::drawBangBorder() {
+ofColor PdBang::getBorderColor() const {
     // Couleur de bordure selon l'état
     ofColor borderColor = BANG_BORDER_COLOR;
     
@@ -113,8 +144,24 @@ void PdBang::drawBangBorder() {
         borderColor = borderColor * 0.5f;
     }
     
+    return borderColor;
+}
+
+float PdBang::getCircleRadius() const {
+    // Cercle circonscrit dans le carré, avec une petite marge
+    return min(size.x, size.y) / 2.0f - 2.0f;
+}
+
+void PdBang::drawBangState() {
+    // Dessiner le rectangle de fond
+    ofSetColor(getStateColor());
+    ofFill();
+    ofDrawRectangle(0, 0, size.x, size.y);
+}
+
+void PdBang::drawBangBorder() {
     // Dessiner la bordure
-    ofSetColor(borderColor);
+    ofSetColor(getBorderColor());
     ofNoFill();
     ofSetLineWidth(1.0f);
     ofDrawRectangle(0, 0, size.x, size.y);
@@ -124,17 +171,9 @@ void PdBang::drawBangBorder() {
 }
 
 void PdBang::drawCircle() {
-    // Couleur du cercle
-    ofColor circleColor = BANG_CIRCLE_COLOR;
-    
-    // Calculer la taille du cercle (circonscrit dans le carré)
-    float radius = min(size.x, size.y) / 2.0f - 2.0f; // Petite marge
-    float centerX = size.x / 2.0f;
-    float centerY = size.y / 2.0f;
-    
-    // Dessiner le cercle
-    ofSetColor(circleColor);
+    // Dessiner le cercle, plein si le bang est déclenché
+    ofSetColor(BANG_CIRCLE_COLOR);
     if(triggered)ofFill();
     else ofNoFill();
-    ofDrawCircle(centerX, centerY, radius);
+    ofDrawCircle(size.x / 2.0f, size.y / 2.0f, getCircleRadius());
 }
@@ -19,16 +19,21 @@ public:
     
     // Constructeur
     PdBang(ofVec2f position, ofVec2f size,
-           const string& sendSymbol, const string& receiveSymbol = "");
+           PdSymbol sendSymbol, PdSymbol receiveSymbol = PdSymbol());
     
     // Méthodes virtuelles de PdGuiObject
     void update() override;
     void draw() override;
+    bool drawBatched(PdPrimitiveBatch& batch) override;
     
     // Gestion des événements souris
     bool onMousePressed(ofMouseEventArgs& args) override;
     bool onMouseReleased(ofMouseEventArgs& args) override;
     
+    // Messages reçus de Pure Data : tout message fait clignoter le bang
+    void receiveFloat(float value) override;
+    void receiveBang() override;
+    
     // Méthodes spécifiques au bang
     void trigger(); // Déclenche le bang
     bool isTriggered() const { return triggered; }
@@ -43,4 +48,10 @@ private:
     void drawBangState();
     void drawBangBorder();
     void drawCircle();
+    ofColor getStateColor() const;
+    ofColor getBorderColor() const;
+    float getCircleRadius() const;
+    
+    // Clé de rendu : cercle allumé et états de la souris
+    uint64_t computeRenderKey() const override;
 };
@@ -0,0 +1,245 @@
+//
+//  BenchmarkSuite.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 24/07/2025.
+//
+
+#include "BenchmarkSuite.h"
+#include "ParserBenchmark.h"
+#include "PatchParser.h"
+#include "PatchCache.h"
+#include "SpatialGrid.h"
+#include "EventRouter.h"
+#include "MessageRouter.h"
+#include "SendQueue.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+namespace {
+    // Générateur pseudo-aléatoire déterministe : mêmes points d'une version à l'autre
+    struct Lcg {
+        uint32_t state = 12345;
+        float next() {
+            state = state * 1664525u + 1013904223u;
+            return (state >> 8) / 16777216.0f;
+        }
+    };
+    
+    ofRectangle getExtent(const PdObjectList& objects) {
+        ofRectangle extent;
+        for (size_t i = 0; i < objects.size(); i++) {
+            if (i == 0) extent = objects[i]->getBounds();
+            else extent.growToInclude(objects[i]->getBounds());
+        }
+        return extent;
+    }
+}
+
+PdBenchmarkResult PdBenchmarkSuite::measure(const string& name, int iterations, size_t items,
+                                            const std::function<void()>& func) {
+    PdBenchmarkResult result;
+    result.name = name;
+    result.iterations = std::max(1, iterations);
+    result.itemsPerIteration = items;
+    result.bestMs = 1e30;
+    
+    double totalMs = 0.0;
+    for (int i = 0; i < result.iterations; i++) {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        auto end = std::chrono::steady_clock::now();
+        
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        totalMs += ms;
+        result.bestMs = std::min(result.bestMs, ms);
+    }
+    
+    result.meanMs = totalMs / result.iterations;
+    return result;
+}
+
+PdBenchmarkResult PdBenchmarkSuite::benchParseFile(const string& path, int iterations) {
+    PdPatchParser parser;
+    size_t numGuiObjects = 0;
+    
+    PdBenchmarkResult result = measure("parse_file", iterations, 0, [&]() {
+        numGuiObjects = parser.parseFile(path).size();
+    });
+    result.itemsPerIteration = numGuiObjects;
+    return result;
+}
+
+PdBenchmarkResult PdBenchmarkSuite::benchCachedLoad(const string& path, int iterations) {
+    // Premier chargement : écrit le cache binaire à côté du patch
+    size_t numGuiObjects = PdPatchCache::loadPatch(path).size();
+    
+    return measure("load_cached", iterations, numGuiObjects, [&]() {
+        PdPatchCache::loadPatch(path, false);
+    });
+}
+
+PdBenchmarkResult PdBenchmarkSuite::benchHitTest(const string& patch, int iterations) {
+    // Même chemin que les gestionnaires souris d'ofApp : index spatial puis routeur
+    PdPatchParser parser;
+    PdObjectList objects = parser.parseBuffer(patch.data(), patch.size());
+    PdSpatialGrid spatialIndex;
+    spatialIndex.build(objects);
+    PdEventRouter eventRouter(spatialIndex);
+    
+    const size_t numEvents = 100000;
+    ofRectangle extent = getExtent(objects);
+    std::vector<ofVec2f> points(numEvents);
+    Lcg random;
+    for (auto& point : points) {
+        point = ofVec2f(extent.x + random.next() * extent.width, extent.y + random.next() * extent.height);
+    }
+    
+    return measure("hit_test", iterations, numEvents * 3, [&]() {
+        for (auto& point : points) {
+            eventRouter.pointerMoved(point.x, point.y);
+            eventRouter.pointerPressed(PdEventRouter::MOUSE_POINTER_ID, point.x, point.y);
+            eventRouter.pointerReleased(PdEventRouter::MOUSE_POINTER_ID, point.x, point.y);
+        }
+    });
+}
+
+PdBenchmarkResult PdBenchmarkSuite::benchMessageStorm(const string& patch, int iterations) {
+    // Un thread joue le rôle du thread audio de Pd et inonde les symboles receive,
+    // le thread principal vide la file comme ofApp::update()
+    PdPatchParser parser;
+    PdObjectList objects = parser.parseBuffer(patch.data(), patch.size());
+    auto router = std::make_unique<PdMessageRouter>();
+    
+    std::vector<string> receiveNames;
+    for (auto& obj : objects) {
+        router->registerReceiver(obj.get());
+        if (!obj->getReceiveSymbol().empty()) {
+            receiveNames.push_back(obj->getReceiveSymbol());
+        }
+    }
+    if (receiveNames.empty()) receiveNames.push_back("none");
+    
+    const size_t numMessages = 1000000;
+    
+    PdBenchmarkResult result = measure("message_storm", iterations, numMessages, [&]() {
+        std::atomic<bool> done(false);
+        
+        std::thread producer([&]() {
+            for (size_t i = 0; i < numMessages; i++) {
+                router->pushFloat(receiveNames[i % receiveNames.size()], (float)(i & 127));
+            }
+            done.store(true);
+        });
+        
+        while (!done.load() || router->hasPendingMessages()) {
+            router->processMessages();
+        }
+        producer.join();
+    });
+    
+    result.dropped = router->getNumDroppedMessages();
+    return result;
+}
+
+PdBenchmarkResult PdBenchmarkSuite::benchSendQueue(const string& patch, int iterations) {
+    // Glissements de sliders : beaucoup d'envois par frame, fusionnés par symbole
+    PdPatchParser parser;
+    PdObjectList objects = parser.parseBuffer(patch.data(), patch.size());
+    
+    PdSendQueue queue;
+    queue.setFlushInterval(0);
+    std::vector<PdSymbolId> symbols;
+    for (auto& obj : objects) {
+        if (obj->getSendSymbolId() != PD_EMPTY_SYMBOL) {
+            queue.reserveSymbol(obj->getSendSymbolId());
+            symbols.push_back(obj->getSendSymbolId());
+        }
+    }
+    if (symbols.empty()) symbols.push_back(PD_EMPTY_SYMBOL);
+    
+    const size_t numFrames = 100;
+    const size_t sendsPerFrame = 10000;
+    uint64_t now = 0;
+    
+    return measure("send_queue", iterations, numFrames * sendsPerFrame, [&]() {
+        for (size_t frame = 0; frame < numFrames; frame++) {
+            for (size_t i = 0; i < sendsPerFrame; i++) {
+                queue.send(symbols[(frame * 7 + i) % symbols.size()], (float)i, PdSendPolicy::COALESCE);
+            }
+            now += 16667;
+            queue.flush(now);
+            queue.consume([](const string&, float) {});
+        }
+    });
+}
+
+void PdBenchmarkSuite::print(const PdBenchmarkResult& result) {
+    printf("  %-16s mean %9.3f ms  best %9.3f ms  %12.0f items/s", result.name.c_str(),
+           result.meanMs, result.bestMs, result.getItemsPerSecond());
+    if (result.dropped > 0) {
+        printf("  (%llu dropped)", (unsigned long long)result.dropped);
+    }
+    printf("\n");
+}
+
+bool PdBenchmarkSuite::writeJson(const string& path, const string& suite, size_t numObjects,
+                                 const std::vector<PdBenchmarkResult>& results) {
+    FILE* file = fopen(path.c_str(), "w");
+    if (!file) {
+        ofLogError("PdBenchmarkSuite") << "Cannot write " << path;
+        return false;
+    }
+    
+    fprintf(file, "{\n  \"suite\": \"%s\",\n  \"objects\": %zu,\n  \"results\": [\n", suite.c_str(), numObjects);
+    for (size_t i = 0; i < results.size(); i++) {
+        const PdBenchmarkResult& r = results[i];
+        fprintf(file, "    {\"name\": \"%s\", \"iterations\": %d, \"mean_ms\": %.4f, \"best_ms\": %.4f, "
+                      "\"items\": %zu, \"items_per_s\": %.1f, \"dropped\": %llu}%s\n",
+                r.name.c_str(), r.iterations, r.meanMs, r.bestMs, r.itemsPerIteration,
+                r.getItemsPerSecond(), (unsigned long long)r.dropped, i + 1 < results.size() ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    
+    fclose(file);
+    return true;
+}
+
+int PdBenchmarkSuite::run(size_t numObjects, int iterations, const string& jsonPath) {
+    // Les logs par appel fausseraient les mesures
+    ofLogLevel previousLevel = ofGetLogLevel();
+    ofSetLogLevel(OF_LOG_WARNING);
+    
+    string patch = PdParserBenchmark::generatePatch(numObjects);
+    string patchPath = ofToDataPath("bench_patch.pd", true);
+    
+    ofBuffer buffer(patch.data(), patch.size());
+    if (!ofBufferToFile(patchPath, buffer)) {
+        ofLogError("PdBenchmarkSuite") << "Cannot write " << patchPath;
+        return 1;
+    }
+    
+    printf("benchmark suite: %zu objects, %zu bytes, %d iterations\n", numObjects, patch.size(), iterations);
+    
+    std::vector<PdBenchmarkResult> results;
+    results.push_back(benchParseFile(patchPath, iterations));
+    results.push_back(benchCachedLoad(patchPath, iterations));
+    results.push_back(benchHitTest(patch, iterations));
+    results.push_back(benchMessageStorm(patch, iterations));
+    results.push_back(benchSendQueue(patch, iterations));
+    
+    for (auto& result : results) {
+        print(result);
+    }
+    
+    ofSetLogLevel(previousLevel);
+    
+    if (!jsonPath.empty()) {
+        if (!writeJson(jsonPath, "headless", numObjects, results)) return 1;
+        printf("results written to %s\n", jsonPath.c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,50 @@
+//
+//  BenchmarkSuite.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 24/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+// Résultat d'une mesure, exporté en JSON pour suivre les régressions
+struct PdBenchmarkResult {
+    std::string name;
+    int iterations = 0;
+    double meanMs = 0.0;
+    double bestMs = 0.0;
+    size_t itemsPerIteration = 0;   // objets, événements ou messages traités par itération
+    uint64_t dropped = 0;           // messages perdus (tempêtes de messages)
+    
+    double getItemsPerSecond() const { return meanMs > 0.0 ? itemsPerIteration / (meanMs / 1000.0) : 0.0; }
+};
+
+// Suite de mesures sans fenêtre sur des patchs synthétiques :
+// lecture de fichier, cache binaire, hit-testing, tempêtes de messages Pd
+// et file sortante. Lancée par :
+//   pd-gui --bench [nombre_objets] [iterations] [resultats.json]
+// Le rendu demande un contexte GL : voir ofApp::runRenderBenchmark (--bench-render).
+class PdBenchmarkSuite {
+public:
+    static int run(size_t numObjects, int iterations, const std::string& jsonPath);
+    
+    // Chronomètre func sur plusieurs itérations (meilleur temps et moyenne)
+    static PdBenchmarkResult measure(const std::string& name, int iterations, size_t items,
+                                     const std::function<void()>& func);
+    
+    static void print(const PdBenchmarkResult& result);
+    static bool writeJson(const std::string& path, const std::string& suite, size_t numObjects,
+                          const std::vector<PdBenchmarkResult>& results);
+    
+private:
+    static PdBenchmarkResult benchParseFile(const std::string& path, int iterations);
+    static PdBenchmarkResult benchCachedLoad(const std::string& path, int iterations);
+    static PdBenchmarkResult benchHitTest(const std::string& patch, int iterations);
+    static PdBenchmarkResult benchMessageStorm(const std::string& patch, int iterations);
+    static PdBenchmarkResult benchSendQueue(const std::string& patch, int iterations);
+};
@@ -3,12 +3,14 @@
 PdCanvas::PdCanvas(ofVec2f position, ofVec2f size,
                    const string& label,
                    ofColor backgroundColor, ofColor textColor)
-    : PdGuiObject(GuiType::UNKNOWN, position, size, "empty", "empty")
+    : PdGuiObject(GuiType::CANVAS, position, size, PdSymbol(), PdSymbol())
     , canvasLabel(label)
     , backgroundColor(backgroundColor)
     , textColor(textColor)  // Renommé de borderColor
     , labelFontSize(12)
+    , labelText(12)
 {
+    labelText.set(label);
     enabled = false;
     visible = true;
 }
@@ -33,6 +35,16 @@ void PdCanvas::draw() {
     ofPopStyle();
 }
 
+bool PdCanvas::drawBatched(PdPrimitiveBatch& batch) {
+    batch.addRect(0, 0, size.x, size.y, backgroundColor);
+    
+    if (!canvasLabel.empty()) {
+        batch.addText(labelText, 4, labelFontSize + 2, textColor);
+    }
+    
+    return true;
+}
+
 // Toutes les méthodes de souris retournent false
 bool PdCanvas::onMousePressed(ofMouseEventArgs& args) {
     return false;
@@ -58,11 +70,13 @@ void PdCanvas::setColors(ofColor backgroundColor, ofColor textColor) {
 
 void PdCanvas::setLabel(const string& label) {
     this->canvasLabel = label;
+    labelText.set(label);
     markForUpdate();
 }
 
 void PdCanvas::setLabelStyle(int fontSize) {
     this->labelFontSize = fontSize;
+    labelText.setFontSize(fontSize);
     markForUpdate();
 }
 
@@ -74,14 +88,11 @@ void PdCanvas::drawCanvasBackground() {
 void PdCanvas::drawCanvasLabel() {
     if (canvasLabel.empty()) return;
     
-    // Utiliser la couleur de texte pour le label
-    ofSetColor(textColor);
-    
     // Positionner le label en haut à gauche avec un petit margin
     float textX = 4;
     float textY = labelFontSize + 2;
     
-    ofDrawBitmapString(canvasLabel, textX, textY);
+    labelText.draw(textX, textY, textColor);
 }
 
 // Surcharger les méthodes de base
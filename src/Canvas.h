@@ -13,6 +13,8 @@ public:
     // Méthodes virtuelles héritées
     virtual void update() override;
     virtual void draw() override;
+    virtual bool drawBatched(PdPrimitiveBatch& batch) override;
+    virtual bool isStatic() const override { return true; }
     
     // Surcharger les événements souris pour qu'ils ne soient PAS interceptés
     virtual bool onMousePressed(ofMouseEventArgs& args) override;
@@ -20,6 +22,10 @@ public:
     virtual bool onMouseReleased(ofMouseEventArgs& args) override;
     virtual bool onMouseMoved(ofMouseEventArgs& args) override;
     
+    // Un canvas n'a pas de valeur
+    virtual void receiveFloat(float value) override {}
+    virtual void receiveBang() override {}
+    
     // Configuration spécifique au canvas
     void setColors(ofColor backgroundColor, ofColor textColor);
     void setLabel(const string& label);
@@ -31,6 +37,7 @@ protected:
     ofColor backgroundColor;
     ofColor textColor;  // Renommé de borderColor
     int labelFontSize;
+    PdTextLabel labelText;
     
     // Dessin spécialisé
     void drawCanvasBackground();
@@ -0,0 +1,141 @@
+//
+//  EventRouter.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 17/07/2025.
+//
+
+#include "EventRouter.h"
+
+using namespace std;
+
+PdEventRouter::PdEventRouter(PdSpatialGrid& spatialIndex)
+    : spatialIndex(spatialIndex)
+    , hoveredObject(nullptr)
+{
+}
+
+bool PdEventRouter::pointerPressed(int pointerId, float x, float y, int button) {
+    // Un pointeur qui n'a pas été relâché proprement perd sa capture
+    if (findCapture(pointerId)) {
+        pointerCancelled(pointerId);
+    }
+    
+    const vector<PdSpatialGrid::Entry>* candidates = spatialIndex.getCandidates(x, y);
+    if (!candidates) return false;
+    
+    ofMouseEventArgs args = makeArgs(x, y, button);
+    
+    // Du dessus vers le dessous, en ignorant les objets déjà tenus par un autre doigt
+    for (const auto& entry : *candidates) {
+        if (isCaptured(entry.object)) continue;
+        
+        if (entry.object->onMousePressed(args)) {
+            captures.push_back({ pointerId, entry.object });
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+bool PdEventRouter::pointerDragged(int pointerId, float x, float y, int button) {
+    Capture* capture = findCapture(pointerId);
+    if (!capture) return false;
+    
+    ofMouseEventArgs args = makeArgs(x, y, button);
+    return capture->object->onMouseDragged(args);
+}
+
+bool PdEventRouter::pointerReleased(int pointerId, float x, float y, int button) {
+    Capture* capture = findCapture(pointerId);
+    if (!capture) return false;
+    
+    PdGuiObject* object = capture->object;
+    *capture = captures.back();
+    captures.pop_back();
+    
+    ofMouseEventArgs args = makeArgs(x, y, button);
+    return object->onMouseReleased(args);
+}
+
+void PdEventRouter::pointerCancelled(int pointerId) {
+    Capture* capture = findCapture(pointerId);
+    if (!capture) return;
+    
+    // Relâcher à la dernière position connue de l'objet
+    PdGuiObject* object = capture->object;
+    *capture = captures.back();
+    captures.pop_back();
+    
+    ofVec2f center = object->getPosition() + object->getSize() * 0.5f;
+    ofMouseEventArgs args = makeArgs(center.x, center.y, 0);
+    object->onMouseReleased(args);
+}
+
+void PdEventRouter::pointerMoved(float x, float y) {
+    PdGuiObject* newHovered = spatialIndex.findTopmost(x, y);
+    
+    if (newHovered != hoveredObject && hoveredObject) {
+        hoveredObject->onMouseExited();
+    }
+    
+    // Seul l'objet survolé reçoit le mouvement
+    if (newHovered) {
+        ofMouseEventArgs args = makeArgs(x, y, 0);
+        newHovered->onMouseMoved(args);
+    }
+    
+    hoveredObject = newHovered;
+}
+
+void PdEventRouter::pointerExited() {
+    if (hoveredObject) {
+        hoveredObject->onMouseExited();
+        hoveredObject = nullptr;
+    }
+}
+
+void PdEventRouter::forget(PdGuiObject* object) {
+    captures.erase(remove_if(captures.begin(), captures.end(),
+                             [object](const Capture& c) { return c.object == object; }),
+                   captures.end());
+    
+    if (hoveredObject == object) {
+        hoveredObject = nullptr;
+    }
+}
+
+void PdEventRouter::reset() {
+    captures.clear();
+    hoveredObject = nullptr;
+}
+
+PdGuiObject* PdEventRouter::getActiveObject(int pointerId) const {
+    for (const Capture& capture : captures) {
+        if (capture.pointerId == pointerId) return capture.object;
+    }
+    return nullptr;
+}
+
+PdEventRouter::Capture* PdEventRouter::findCapture(int pointerId) {
+    for (Capture& capture : captures) {
+        if (capture.pointerId == pointerId) return &capture;
+    }
+    return nullptr;
+}
+
+bool PdEventRouter::isCaptured(const PdGuiObject* object) const {
+    for (const Capture& capture : captures) {
+        if (capture.object == object) return true;
+    }
+    return false;
+}
+
+ofMouseEventArgs PdEventRouter::makeArgs(float x, float y, int button) {
+    ofMouseEventArgs args;
+    args.x = x;
+    args.y = y;
+    args.button = button;
+    return args;
+}
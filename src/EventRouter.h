@@ -0,0 +1,59 @@
+//
+//  EventRouter.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 17/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "PdGuiObject.h"
+#include "SpatialGrid.h"
+#include <vector>
+
+// Routage des événements pointeur vers les objets GUI.
+// Chaque pointeur (souris ou doigt) capture l'objet qui a accepté son appui :
+// drag et relâchement ne sont livrés qu'à cet objet, et seul l'objet survolé
+// reçoit les mouvements et la sortie de survol.
+class PdEventRouter {
+public:
+    static constexpr int MOUSE_POINTER_ID = -1;
+    
+    PdEventRouter(PdSpatialGrid& spatialIndex);
+    
+    // Événements pointeur, retournent true si un objet les a traités
+    bool pointerPressed(int pointerId, float x, float y, int button = 0);
+    bool pointerDragged(int pointerId, float x, float y, int button = 0);
+    bool pointerReleased(int pointerId, float x, float y, int button = 0);
+    void pointerCancelled(int pointerId);
+    
+    // Survol (souris uniquement)
+    void pointerMoved(float x, float y);
+    void pointerExited(); // La souris a quitté la zone (vue voisine, autre fenêtre)
+    
+    // À appeler avant de détruire des objets encore référencés
+    void forget(PdGuiObject* object);
+    void reset();
+    
+    // Accesseurs
+    PdGuiObject* getActiveObject(int pointerId) const;
+    PdGuiObject* getHoveredObject() const { return hoveredObject; }
+    size_t getNumActivePointers() const { return captures.size(); }
+    
+private:
+    struct Capture {
+        int pointerId;
+        PdGuiObject* object;
+    };
+    
+    PdSpatialGrid& spatialIndex;
+    
+    // Quelques pointeurs au plus : un petit vecteur est plus rapide qu'une map
+    std::vector<Capture> captures;
+    PdGuiObject* hoveredObject;
+    
+    Capture* findCapture(int pointerId);
+    bool isCaptured(const PdGuiObject* object) const;
+    static ofMouseEventArgs makeArgs(float x, float y, int button);
+};
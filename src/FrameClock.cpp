@@ -0,0 +1,110 @@
+//
+//  FrameClock.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 23/07/2025.
+//
+
+#include "FrameClock.h"
+
+#if !defined(TARGET_OF_IOS) && !defined(TARGET_ANDROID) && !defined(TARGET_EMSCRIPTEN)
+#define PD_FRAME_CLOCK_GLFW
+#endif
+
+std::atomic<bool> PdFrameClock::waiting(false);
+
+void PdFrameClock::setup(int activeFrameRate, int idleFrameRate) {
+    this->activeFrameRate = activeFrameRate;
+    this->idleFrameRate = idleFrameRate;
+    throttled = false;
+    applyFrameRate();
+}
+
+void PdFrameClock::setMode(Mode mode) {
+    this->mode = mode;
+    idleFrames = 0;
+    requestFrame();
+    
+    if (throttled) {
+        throttled = false;
+        applyFrameRate();
+    }
+}
+
+void PdFrameClock::applyFrameRate() {
+    // 0 : draw() n'attend plus la période avant l'échange de tampons
+    ofSetFrameRate(unlimited ? 0 : throttled ? idleFrameRate : activeFrameRate);
+}
+
+bool PdFrameClock::canBlock() const {
+#ifdef PD_FRAME_CLOCK_GLFW
+    // Fenêtre GLFW seulement (pas en mode sans fenêtre)
+    return dynamic_cast<ofAppGLFWWindow*>(ofGetWindowPtr()) != nullptr;
+#else
+    return false;
+#endif
+}
+
+void PdFrameClock::waitForWork(uint64_t nextDeadlineMicros, const std::function<bool()>& hasPendingWork) {
+    // Limiteur de cadence coupé pour la seule frame qui suit une entrée rapide
+    bool early = earlyFrameRequested;
+    earlyFrameRequested = false;
+    if (early != unlimited) {
+        unlimited = early;
+        applyFrameRate();
+    }
+    
+    if (mode == Mode::CONTINUOUS || lastFrameActive || frameRequested) return;
+    if (!canBlock()) return;
+    
+    uint64_t now = ofGetElapsedTimeMicros();
+    if (nextDeadlineMicros <= now) return;
+    
+    double timeout = MAX_WAIT_SECONDS;
+    if (nextDeadlineMicros != UINT64_MAX) {
+        timeout = std::min(timeout, (nextDeadlineMicros - now) / 1000000.0);
+    }
+    
+    // Publier l'attente avant la dernière vérification : un message poussé
+    // ensuite trouve waiting à true et réveille la boucle
+    waiting.store(true);
+    if (hasPendingWork && hasPendingWork()) {
+        waiting.store(false);
+        return;
+    }
+
+#ifdef PD_FRAME_CLOCK_GLFW
+    // Les événements reçus pendant l'attente sont distribués à l'application
+    glfwWaitEventsTimeout(timeout);
+#endif
+    waiting.store(false);
+    numWaits++;
+}
+
+void PdFrameClock::endFrame() {
+    lastFrameActive = frameRequested;
+    frameRequested = false;
+    
+    if (lastFrameActive) {
+        idleFrames = 0;
+    } else if (idleFrames < IDLE_FRAMES_BEFORE_SLEEP) {
+        idleFrames++;
+    }
+    
+    // Repli sans blocage : réduire la cadence
+    bool throttle = mode == Mode::ON_DEMAND && isIdle() && !canBlock();
+    if (throttle != throttled) {
+        throttled = throttle;
+        applyFrameRate();
+    }
+}
+
+void PdFrameClock::wake() {
+    // Ordonne la publication du message avant la lecture de waiting
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting.load()) {
+#ifdef PD_FRAME_CLOCK_GLFW
+        glfwPostEmptyEvent();
+#endif
+    }
+}
@@ -0,0 +1,73 @@
+//
+//  FrameClock.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 23/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+// Rendu à la demande : une frame n'est produite que si un objet est sale,
+// qu'un événement arrive, qu'un message Pd est reçu ou qu'une échéance tombe.
+// Sinon la boucle bloque sur les événements de la fenêtre (GLFW) ; sans
+// GLFW, la cadence est seulement réduite.
+class PdFrameClock {
+public:
+    enum class Mode {
+        ON_DEMAND,
+        CONTINUOUS  // Débogage : une frame par période, comme avant
+    };
+    
+    void setup(int activeFrameRate, int idleFrameRate);
+    
+    void setMode(Mode mode);
+    Mode getMode() const { return mode; }
+    bool isContinuous() const { return mode == Mode::CONTINUOUS; }
+    
+    // Quelque chose a changé pendant la frame courante
+    void requestFrame() { frameRequested = true; }
+    // Entrée à afficher au plus tôt : la frame suivante n'attend pas la
+    // période de ofSetFrameRate (la synchro verticale reste appliquée)
+    void requestEarlyFrame() { frameRequested = true; earlyFrameRequested = true; }
+    
+    // Début de frame : attend le prochain événement, l'échéance nextDeadlineMicros
+    // ou un réveil. hasPendingWork est revérifié juste avant de bloquer.
+    void waitForWork(uint64_t nextDeadlineMicros, const std::function<bool()>& hasPendingWork);
+    
+    // Fin de frame
+    void endFrame();
+    
+    // Réveil depuis un autre thread (thread audio de Pd), sans effet si la boucle ne dort pas
+    static void wake();
+    
+    bool isIdle() const { return idleFrames >= IDLE_FRAMES_BEFORE_SLEEP; }
+    uint64_t getNumWaits() const { return numWaits; }
+
+private:
+    // Sans blocage possible : cadence réduite après ce nombre de frames inactives
+    static constexpr int IDLE_FRAMES_BEFORE_SLEEP = 30;
+    
+    // Attente maximale, pour rafraîchir l'affichage de debug de temps en temps
+    static constexpr double MAX_WAIT_SECONDS = 1.0;
+    
+    bool canBlock() const;
+    void applyFrameRate();
+    
+    Mode mode = Mode::ON_DEMAND;
+    int activeFrameRate = 60;
+    int idleFrameRate = 10;
+    bool frameRequested = true;
+    bool lastFrameActive = true;
+    bool throttled = false;
+    bool earlyFrameRequested = false;
+    bool unlimited = false;  // Limiteur coupé pour la frame en cours
+    int idleFrames = 0;
+    uint64_t numWaits = 0;
+    
+    static std::atomic<bool> waiting;
+};
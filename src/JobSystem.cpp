@@ -0,0 +1,151 @@
+//
+//  JobSystem.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#include "JobSystem.h"
+#include <thread>
+
+PdJobSystem& PdJobSystem::get() {
+    static PdJobSystem jobSystem;
+    return jobSystem;
+}
+
+PdJobSystem::PdJobSystem() : numQueued(0), numStolen(0) {
+    unsigned cores = std::thread::hardware_concurrency();
+    numWorkers = cores > 1 ? std::min<size_t>(cores - 1, MAX_WORKERS) : 0;
+}
+
+PdJobSystem::~PdJobSystem() {
+    shutdown();
+}
+
+void PdJobSystem::setNumWorkers(size_t count) {
+    // Les threads déjà démarrés sont arrêtés, les suivants démarrent au besoin
+    shutdown();
+    numWorkers = std::min(count, MAX_WORKERS);
+}
+
+void PdJobSystem::startWorkers() {
+    stopping = false;
+    queues.clear();
+    for (size_t i = 0; i <= numWorkers; i++) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    
+    for (size_t i = 1; i <= numWorkers; i++) {
+        workers.push_back(std::make_unique<Worker>(*this, i));
+        workers.back()->startThread();
+    }
+    ofLogNotice("PdJobSystem") << "Started " << numWorkers << " worker threads";
+}
+
+void PdJobSystem::shutdown() {
+    if (workers.empty()) return;
+    
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    
+    for (auto& worker : workers) {
+        worker->waitForThread(false);
+    }
+    workers.clear();
+}
+
+void PdJobSystem::parallelFor(size_t count, size_t minChunk, const RangeFunction& func) {
+    if (count == 0) return;
+    
+    size_t numThreads = numWorkers + 1;
+    size_t numChunks = std::min(count / std::max<size_t>(minChunk, 1), numThreads * CHUNKS_PER_THREAD);
+    if (numWorkers == 0 || numChunks < 2) {
+        func(0, count);
+        return;
+    }
+    
+    if (workers.empty()) {
+        startWorkers();
+    }
+    numParallelLoops++;
+    
+    // Tranches réparties à tour de rôle ; le thread principal a aussi les siennes
+    Batch batch;
+    batch.func = &func;
+    batch.remaining.store(numChunks, std::memory_order_relaxed);
+    
+    for (size_t i = 0; i < numChunks; i++) {
+        Chunk chunk{ &batch, count * i / numChunks, count * (i + 1) / numChunks };
+        Queue& queue = *queues[i % numThreads];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.chunks.push_back(chunk);
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        numQueued.fetch_add(numChunks, std::memory_order_release);
+    }
+    wakeCondition.notify_all();
+    
+    // Travailler jusqu'à la dernière tranche, puis attendre celles en cours
+    Chunk chunk;
+    while (batch.remaining.load(std::memory_order_acquire) > 0) {
+        if (pop(0, chunk) || steal(0, chunk)) {
+            run(chunk);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void PdJobSystem::workerLoop(size_t queue) {
+    Chunk chunk;
+    while (true) {
+        if (pop(queue, chunk) || steal(queue, chunk)) {
+            run(chunk);
+            continue;
+        }
+        
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeCondition.wait(lock, [this]() {
+            return stopping || numQueued.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping) return;
+    }
+}
+
+bool PdJobSystem::pop(size_t index, Chunk& chunk) {
+    // Sa propre file par la fin : les tranches récentes, encore en cache
+    Queue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.chunks.empty()) return false;
+    
+    chunk = queue.chunks.back();
+    queue.chunks.pop_back();
+    numQueued.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool PdJobSystem::steal(size_t thief, Chunk& chunk) {
+    // Les autres files par le début, en partant de la voisine
+    for (size_t i = 1; i < queues.size(); i++) {
+        Queue& queue = *queues[(thief + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.chunks.empty()) continue;
+        
+        chunk = queue.chunks.front();
+        queue.chunks.pop_front();
+        numQueued.fetch_sub(1, std::memory_order_relaxed);
+        numStolen.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void PdJobSystem::run(const Chunk& chunk) {
+    (*chunk.batch->func)(chunk.begin, chunk.end);
+    chunk.batch->remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
@@ -0,0 +1,99 @@
+//
+//  JobSystem.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Boucles parallèles sur des tranches d'objets (lissage, clés de rendu,
+// mise en forme des valeurs). Une file par thread : chaque thread prend ses
+// tranches par la fin et, à court de travail, vole le début de la file d'un
+// autre. Le thread principal découpe, travaille avec les autres et attend la
+// fin. Le GL et tout ce qui marque des objets sales restent sur le thread
+// principal : les fonctions ne font qu'écrire dans leurs propres entrées.
+class PdJobSystem {
+public:
+    static PdJobSystem& get();
+    
+    // Tranches par thread : de quoi rééquilibrer sans multiplier les verrous
+    static constexpr size_t CHUNKS_PER_THREAD = 4;
+    static constexpr size_t MAX_WORKERS = 7;
+    
+    typedef std::function<void(size_t begin, size_t end)> RangeFunction;
+    
+    // Appelle func sur des tranches de [0, count) d'au moins minChunk éléments.
+    // Sous deux tranches (un seul petit patch), appel direct sans aucun
+    // thread. Depuis le thread principal seulement, pas d'appel imbriqué.
+    void parallelFor(size_t count, size_t minChunk, const RangeFunction& func);
+    
+    // Nombre de threads en plus du principal ; démarrés au premier besoin.
+    // Par défaut : cœurs - 1, au plus MAX_WORKERS. 0 = tout sur le thread principal.
+    void setNumWorkers(size_t numWorkers);
+    size_t getNumWorkers() const { return numWorkers; }
+    
+    // Compteurs des boucles lancées en parallèle et des tranches volées
+    uint64_t getNumParallelLoops() const { return numParallelLoops; }
+    uint64_t getNumStolenChunks() const { return numStolen.load(std::memory_order_relaxed); }
+    
+    // À la sortie (avant la destruction des statiques)
+    void shutdown();
+
+private:
+    PdJobSystem();
+    ~PdJobSystem();
+    
+    struct Batch {
+        const RangeFunction* func;
+        std::atomic<size_t> remaining;
+    };
+    
+    struct Chunk {
+        Batch* batch;
+        size_t begin;
+        size_t end;
+    };
+    
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Chunk> chunks;
+    };
+    
+    class Worker : public ofThread {
+    public:
+        Worker(PdJobSystem& system, size_t queue) : system(system), queue(queue) {}
+        void threadedFunction() override { system.workerLoop(queue); }
+    
+    private:
+        PdJobSystem& system;
+        size_t queue;
+    };
+    
+    size_t numWorkers;
+    std::vector<std::unique_ptr<Queue>> queues; // 0 = thread principal
+    std::vector<std::unique_ptr<Worker>> workers;
+    
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    std::atomic<size_t> numQueued;
+    bool stopping = false;
+    
+    uint64_t numParallelLoops = 0;
+    std::atomic<uint64_t> numStolen;
+    
+    void startWorkers();
+    void workerLoop(size_t queue);
+    bool pop(size_t queue, Chunk& chunk);
+    bool steal(size_t thief, Chunk& chunk);
+    void run(const Chunk& chunk);
+};
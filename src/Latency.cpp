@@ -0,0 +1,116 @@
+//
+//  Latency.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#include "Latency.h"
+#include <cmath>
+#include <cstdio>
+
+PdLatencyHistogram::PdLatencyHistogram()
+    : count(0)
+    , maxMicros(0)
+{
+    for (auto& bucket : buckets) bucket.store(0, std::memory_order_relaxed);
+}
+
+void PdLatencyHistogram::add(uint64_t micros) {
+    size_t bucket = std::min<uint64_t>(micros / BUCKET_MICROS, NUM_BUCKETS - 1);
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    
+    uint64_t previous = maxMicros.load(std::memory_order_relaxed);
+    while (micros > previous && !maxMicros.compare_exchange_weak(previous, micros, std::memory_order_relaxed)) {
+    }
+}
+
+void PdLatencyHistogram::reset() {
+    for (auto& bucket : buckets) bucket.store(0, std::memory_order_relaxed);
+    count.store(0, std::memory_order_relaxed);
+    maxMicros.store(0, std::memory_order_relaxed);
+}
+
+uint64_t PdLatencyHistogram::getPercentile(double fraction) const {
+    uint64_t total = getCount();
+    if (total == 0) return 0;
+    
+    // Rang de l'échantillon cherché, au moins le premier
+    uint64_t rank = std::max<uint64_t>(1, (uint64_t)std::ceil(fraction * total));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < NUM_BUCKETS - 1; i++) {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank) return std::min((i + 1) * BUCKET_MICROS, getMax());
+    }
+    return getMax();
+}
+
+PdLatencyTracker& PdLatencyTracker::get() {
+    static PdLatencyTracker tracker;
+    return tracker;
+}
+
+PdLatencyTracker::PdLatencyTracker()
+    : pendingInput(0)
+    , drawnInput(0)
+{
+}
+
+uint64_t PdLatencyTracker::inputReceived() {
+    uint64_t now = ofGetElapsedTimeMicros();
+    if (pendingInput == 0) {
+        pendingInput = now;
+    }
+    return now;
+}
+
+void PdLatencyTracker::frameDrawn() {
+    // Une entrée arrivée pendant l'attente de l'échange précédent reste pour la frame suivante
+    if (pendingInput != 0 && drawnInput == 0) {
+        drawnInput = pendingInput;
+        pendingInput = 0;
+    }
+}
+
+void PdLatencyTracker::framePresented(uint64_t nowMicros) {
+    if (drawnInput == 0) return;
+    
+    record(PdLatencyStage::PRESENT, drawnInput, nowMicros);
+    drawnInput = 0;
+}
+
+void PdLatencyTracker::record(PdLatencyStage stage, uint64_t inputMicros, uint64_t nowMicros) {
+    histograms[(size_t)stage].add(nowMicros > inputMicros ? nowMicros - inputMicros : 0);
+}
+
+void PdLatencyTracker::reset() {
+    for (auto& histogram : histograms) histogram.reset();
+}
+
+int PdLatencyTracker::formatSummary(PdLatencyStage stage, char* buffer, size_t size) const {
+    const PdLatencyHistogram& histogram = getHistogram(stage);
+    int length = snprintf(buffer, size, "%s: p50 %.2f ms, p99 %.2f ms, max %.2f ms (%llu)",
+                          getStageName(stage),
+                          histogram.getPercentile(0.5) / 1000.0,
+                          histogram.getPercentile(0.99) / 1000.0,
+                          histogram.getMax() / 1000.0,
+                          (unsigned long long)histogram.getCount());
+    return std::max(0, std::min(length, (int)size - 1));
+}
+
+void PdLatencyTracker::logReport() const {
+    char buffer[128];
+    for (size_t i = 0; i < PD_NUM_LATENCY_STAGES; i++) {
+        formatSummary((PdLatencyStage)i, buffer, sizeof(buffer));
+        ofLogNotice("PdLatencyTracker") << buffer;
+    }
+}
+
+const char* PdLatencyTracker::getStageName(PdLatencyStage stage) {
+    switch (stage) {
+        case PdLatencyStage::SEND:    return "Input to send";
+        case PdLatencyStage::PRESENT: return "Input to present";
+        default:                      return "?";
+    }
+}
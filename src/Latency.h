@@ -0,0 +1,82 @@
+//
+//  Latency.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include <atomic>
+#include <cstdint>
+
+// Étapes mesurées depuis l'événement d'entrée (souris, doigt, clavier, tablette)
+enum class PdLatencyStage : uint8_t {
+    SEND,     // Message publié vers Pd (consume() de la file sortante)
+    PRESENT,  // Retour de l'échange de tampons de la frame qui affiche l'entrée
+    COUNT
+};
+
+static constexpr size_t PD_NUM_LATENCY_STAGES = (size_t)PdLatencyStage::COUNT;
+
+// Histogramme de latences en seaux de BUCKET_MICROS, le dernier seau
+// recueillant tout ce qui dépasse. Ajouts sans verrou depuis n'importe quel
+// thread ; les percentiles sont donnés à la borne haute de leur seau.
+class PdLatencyHistogram {
+public:
+    static constexpr uint64_t BUCKET_MICROS = 50;
+    static constexpr size_t NUM_BUCKETS = 2000; // 100 ms
+    
+    PdLatencyHistogram();
+    
+    void add(uint64_t micros);
+    void reset();
+    
+    uint64_t getCount() const { return count.load(std::memory_order_relaxed); }
+    uint64_t getMax() const { return maxMicros.load(std::memory_order_relaxed); }
+    uint64_t getPercentile(double fraction) const;
+
+private:
+    std::atomic<uint32_t> buckets[NUM_BUCKETS];
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> maxMicros;
+};
+
+// Latence entrée → envoi à Pd → image affichée. Chaque événement d'entrée est
+// daté (inputReceived) ; la file sortante reporte la date sur les messages
+// qu'il provoque et mesure SEND à leur publication. La première entrée depuis
+// la dernière frame est suivie jusqu'au retour de son échange de tampons,
+// c'est-à-dire au début de la boucle suivante (PRESENT).
+class PdLatencyTracker {
+public:
+    static PdLatencyTracker& get();
+    
+    // Thread principal : début d'un événement, retourne sa date
+    uint64_t inputReceived();
+    
+    // Thread principal : fin de draw(), puis début de la boucle suivante
+    void frameDrawn();
+    void framePresented(uint64_t nowMicros);
+    
+    // N'importe quel thread
+    void record(PdLatencyStage stage, uint64_t inputMicros, uint64_t nowMicros);
+    
+    const PdLatencyHistogram& getHistogram(PdLatencyStage stage) const { return histograms[(size_t)stage]; }
+    void reset();
+    
+    // "p50 0.35 ms, p99 1.20 ms, max 2.10 ms (1234)", retourne la longueur écrite
+    int formatSummary(PdLatencyStage stage, char* buffer, size_t size) const;
+    void logReport() const;
+    
+    static const char* getStageName(PdLatencyStage stage);
+
+private:
+    PdLatencyTracker();
+    
+    PdLatencyHistogram histograms[PD_NUM_LATENCY_STAGES];
+    
+    // Première entrée pas encore dessinée, puis dessinée mais pas encore affichée (0 = aucune)
+    uint64_t pendingInput;
+    uint64_t drawnInput;
+};
@@ -0,0 +1,70 @@
+//
+//  MappedFile.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 22/07/2025.
+//
+
+#include "MappedFile.h"
+
+#if defined(TARGET_OSX) || defined(TARGET_LINUX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PD_HAS_MMAP 1
+#endif
+
+PdMappedFile::PdMappedFile()
+    : data(nullptr)
+    , length(0)
+    , mapped(false)
+{
+}
+
+PdMappedFile::~PdMappedFile() {
+    close();
+}
+
+bool PdMappedFile::open(const string& path) {
+    close();
+    string fullPath = ofToDataPath(path, true);
+    
+#ifdef PD_HAS_MMAP
+    int fd = ::open(fullPath.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* address = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address != MAP_FAILED) {
+                data = static_cast<const char*>(address);
+                length = (size_t)info.st_size;
+                mapped = true;
+            }
+        }
+        ::close(fd);
+        if (mapped) return true;
+    }
+#endif
+    
+    // Pas de mmap : lecture classique
+    if (!ofFile::doesFileExist(fullPath, false)) return false;
+    fallback = ofBufferFromFile(fullPath, true);
+    if (fallback.size() == 0) return false;
+    
+    data = fallback.getData();
+    length = fallback.size();
+    return true;
+}
+
+void PdMappedFile::close() {
+#ifdef PD_HAS_MMAP
+    if (mapped && data) {
+        munmap(const_cast<char*>(data), length);
+    }
+#endif
+    fallback.clear();
+    data = nullptr;
+    length = 0;
+    mapped = false;
+}
@@ -0,0 +1,36 @@
+//
+//  MappedFile.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 22/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+
+// Fichier en lecture seule projeté en mémoire (mmap). Sur les plateformes
+// sans mmap, le contenu est lu dans un ofBuffer.
+class PdMappedFile {
+public:
+    PdMappedFile();
+    ~PdMappedFile();
+    
+    PdMappedFile(const PdMappedFile&) = delete;
+    PdMappedFile& operator=(const PdMappedFile&) = delete;
+    
+    // Le chemin est relatif au dossier data, comme ofBufferFromFile
+    bool open(const string& path);
+    void close();
+    
+    const char* getData() const { return data; }
+    size_t size() const { return length; }
+    bool isOpen() const { return data != nullptr; }
+    bool isMapped() const { return mapped; }
+    
+private:
+    const char* data;
+    size_t length;
+    bool mapped;
+    ofBuffer fallback;
+};
@@ -0,0 +1,132 @@
+//
+//  MessageRouter.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 19/07/2025.
+//
+
+#include "MessageRouter.h"
+#include "FrameClock.h"
+
+PdMessageRouter::PdMessageRouter()
+    : numReceivers(0)
+    , droppedMessages(0)
+{
+}
+
+void PdMessageRouter::registerReceiver(PdGuiObject* object) {
+    if (!object) return;
+    
+    PdSymbolId id = object->getReceiveSymbolId();
+    if (id == PD_EMPTY_SYMBOL) return;
+    
+    if (id >= receivers.size()) {
+        receivers.resize(id + 1);
+    }
+    
+    receivers[id].push_back(object);
+    numReceivers++;
+}
+
+void PdMessageRouter::unregisterReceiver(PdGuiObject* object) {
+    for (auto& list : receivers) {
+        auto it = find(list.begin(), list.end(), object);
+        if (it != list.end()) {
+            list.erase(it);
+            numReceivers--;
+        }
+    }
+}
+
+void PdMessageRouter::clear() {
+    // Les messages en attente visent peut-être des objets détruits
+    inbox.consumeAll([](const PdMessage&) {});
+    sampleInbox.consumeAll([](const PdSampleBlock&) {});
+    receivers.clear();
+    numReceivers = 0;
+}
+
+bool PdMessageRouter::pushFloat(const string& symbol, float value) {
+    return pushFloat(PdSymbolTable::get().find(symbol), value);
+}
+
+bool PdMessageRouter::pushBang(const string& symbol) {
+    return pushBang(PdSymbolTable::get().find(symbol));
+}
+
+bool PdMessageRouter::pushFloat(PdSymbolId symbolId, float value) {
+    if (symbolId == PD_EMPTY_SYMBOL) return false;
+    return push({ symbolId, PdMessage::FLOAT, value });
+}
+
+bool PdMessageRouter::pushBang(PdSymbolId symbolId) {
+    if (symbolId == PD_EMPTY_SYMBOL) return false;
+    return push({ symbolId, PdMessage::BANG, 0.0f });
+}
+
+bool PdMessageRouter::push(const PdMessage& message) {
+    if (!inbox.push(message)) {
+        droppedMessages.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    
+    // Réveiller la boucle principale si elle attend des événements
+    PdFrameClock::wake();
+    return true;
+}
+
+bool PdMessageRouter::pushSamples(const string& arrayName, size_t offset, const float* samples, size_t count) {
+    return pushSamples(PdSymbolTable::get().find(arrayName), offset, samples, count);
+}
+
+bool PdMessageRouter::pushSamples(PdSymbolId arrayName, size_t offset, const float* samples, size_t count) {
+    if (arrayName == PD_EMPTY_SYMBOL) return false;
+    
+    bool complete = true;
+    PdSampleBlock block;
+    block.symbolId = arrayName;
+    
+    for (size_t done = 0; done < count; done += PdSampleBlock::SIZE) {
+        block.offset = (uint32_t)(offset + done);
+        block.count = (uint32_t)min(PdSampleBlock::SIZE, count - done);
+        memcpy(block.samples, samples + done, block.count * sizeof(float));
+        
+        if (!sampleInbox.push(block)) {
+            droppedMessages.fetch_add(1, std::memory_order_relaxed);
+            complete = false;
+        }
+    }
+    
+    PdFrameClock::wake();
+    return complete;
+}
+
+size_t PdMessageRouter::processMessages() {
+    size_t numSampleBlocks = sampleInbox.consumeAll([this](const PdSampleBlock& block) {
+        dispatch(block);
+    });
+    
+    return numSampleBlocks + inbox.consumeAll([this](const PdMessage& message) {
+        dispatch(message);
+    });
+}
+
+void PdMessageRouter::dispatch(const PdMessage& message) {
+    if (message.symbolId >= receivers.size()) return;
+    
+    for (PdGuiObject* object : receivers[message.symbolId]) {
+        if (message.type == PdMessage::BANG) {
+            object->receiveBang();
+        } else {
+            object->receiveFloat(message.value);
+        }
+    }
+}
+
+void PdMessageRouter::dispatch(const PdSampleBlock& block) {
+    if (block.symbolId >= receivers.size()) return;
+    
+    for (PdGuiObject* object : receivers[block.symbolId]) {
+        object->receiveSamples(block.offset, block.samples, block.count);
+    }
+}
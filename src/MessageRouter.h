@@ -0,0 +1,88 @@
+//
+//  MessageRouter.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 19/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "PdGuiObject.h"
+#include "RingBuffer.h"
+#include "Symbol.h"
+#include <atomic>
+#include <vector>
+
+// Message reçu de Pure Data
+struct PdMessage {
+    enum Type : uint8_t {
+        FLOAT,
+        BANG
+    };
+    
+    PdSymbolId symbolId;
+    Type type;
+    float value;
+};
+
+// Valeurs d'un tableau Pd écrites par le thread audio, au plus un tick DSP
+// (64 échantillons) par bloc
+struct PdSampleBlock {
+    static constexpr size_t SIZE = 64;
+    
+    PdSymbolId symbolId;
+    uint32_t offset;
+    uint32_t count;
+    float samples[SIZE];
+};
+
+// Acheminement des messages entrants de Pd vers les objets GUI.
+// Le thread audio remplit une file sans verrou ; update() la vide en un seul
+// lot et chaque message va directement aux objets abonnés au symbole.
+class PdMessageRouter {
+public:
+    PdMessageRouter();
+    
+    // Configuration (thread principal, avant le démarrage de l'audio)
+    void registerReceiver(PdGuiObject* object);
+    void unregisterReceiver(PdGuiObject* object);
+    void clear();
+    
+    // Thread audio : producteur unique, sans verrou ni allocation. Les noms
+    // sont cherchés sans verrou (PdSymbolTable::find) pendant que le thread
+    // principal interne ; les noms inconnus de la table sont ignorés.
+    bool pushFloat(const string& symbol, float value);
+    bool pushBang(const string& symbol);
+    bool pushFloat(PdSymbolId symbolId, float value);
+    bool pushBang(PdSymbolId symbolId);
+    bool push(const PdMessage& message);
+    
+    // Thread audio : écrit count valeurs du tableau à partir de offset. Les
+    // blocs qui ne tiennent plus dans la file sont perdus (comptés).
+    bool pushSamples(const string& arrayName, size_t offset, const float* samples, size_t count);
+    bool pushSamples(PdSymbolId arrayName, size_t offset, const float* samples, size_t count);
+    
+    // Thread principal : distribue tous les messages en attente
+    size_t processMessages();
+    bool hasPendingMessages() const { return !inbox.empty() || !sampleInbox.empty(); }
+    
+    // Statistiques
+    uint64_t getNumDroppedMessages() const { return droppedMessages.load(std::memory_order_relaxed); }
+    size_t getNumReceivers() const { return numReceivers; }
+    
+private:
+    static constexpr size_t INBOX_CAPACITY = 8192;
+    static constexpr size_t SAMPLE_INBOX_CAPACITY = 512; // 32768 valeurs
+    
+    // Objets abonnés, indexés par PdSymbolId
+    std::vector<std::vector<PdGuiObject*>> receivers;
+    size_t numReceivers;
+    
+    PdSpscRing<PdMessage, INBOX_CAPACITY> inbox;
+    PdSpscRing<PdSampleBlock, SAMPLE_INBOX_CAPACITY> sampleInbox;
+    std::atomic<uint64_t> droppedMessages;
+    
+    void dispatch(const PdMessage& message);
+    void dispatch(const PdSampleBlock& block);
+};
@@ -6,13 +6,14 @@
 //
 
 #include "NumberBox.h"
+#include "NumberFormat.h"
 
 // Constantes
 const float PdNumberBox::DEFAULT_DRAG_SENSITIVITY = 0.5f;
 const int PdNumberBox::DEFAULT_FONT_SIZE = 12;
 
 PdNumberBox::PdNumberBox(ofVec2f position, ofVec2f size,
-                         const string& sendSymbol, const string& receiveSymbol,
+                         PdSymbol sendSymbol, PdSymbol receiveSymbol,
                          float min, float max, float initialValue, int precision)
     : PdGuiObject(GuiType::NUMBER_BOX, position, size, sendSymbol, receiveSymbol)
     , displayPrecision(precision)
@@ -47,6 +48,38 @@ void PdNumberBox::draw() {
     ofPopStyle();
 }
 
+ofRectangle PdNumberBox::getDrawBounds() const {
+    ofRectangle bounds = PdGuiObject::getDrawBounds();
+    
+    // Les valeurs longues débordent à droite (textX est bloqué à 2)
+    char buffer[PdNumberFormat::MAX_LENGTH];
+    int maxChars = max(PdNumberFormat::formatFloat(buffer, sizeof(buffer), minValue, displayPrecision),
+                       PdNumberFormat::formatFloat(buffer, sizeof(buffer), maxValue, displayPrecision));
+    maxChars = min(maxChars, 12);
+    bounds.growToInclude(ofRectangle(position.x, position.y,
+                                     2 + maxChars * PdGlyphAtlas::estimateCharWidth(fontSize), size.y));
+    
+    ofRectangle labelBounds = getLabelBounds();
+    if (labelBounds.width > 0) {
+        bounds.growToInclude(labelBounds);
+    }
+    
+    return bounds;
+}
+
+bool PdNumberBox::drawBatched(PdPrimitiveBatch& batch) {
+    // Même ordre que draw() : fond, texte, bordure, labels
+    batchBackground(batch);
+    
+    updateValueLabel();
+    ofVec2f textPos = getTextPosition();
+    batch.addText(valueLabel, textPos.x, textPos.y, getTextColor());
+    
+    batchBorder(batch);
+    batchLabel(batch);
+    return true;
+}
+
 bool PdNumberBox::onMousePressed(ofMouseEventArgs& args) {
     if (!visible || !enabled) return false;
     
@@ -62,7 +95,7 @@ bool PdNumberBox::onMousePressed(ofMouseEventArgs& args) {
         dragStartY = mousePos.y;
         isDraggingValue = false; // Sera activé lors du premier drag
         
-        markForUpdate();
+        markIfRenderChanged();
         return true;
     }
     
@@ -107,7 +140,7 @@ bool PdNumberBox::onMouseReleased(ofMouseEventArgs& args) {
             // avec un champ de texte
         }
         
-        markForUpdate();
+        markIfRenderChanged();
         return true;
     }
     
@@ -122,7 +155,7 @@ bool PdNumberBox::onMouseMoved(ofMouseEventArgs& args) {
     mouseOver = isPointInside(mousePos);
     
     if (wasMouseOver != mouseOver) {
-        markForUpdate();
+        markIfRenderChanged();
     }
     
     return mouseOver;
@@ -155,19 +188,53 @@ void PdNumberBox::setValueRange(float min, float max) {
     PdGuiObject::setValueRange(min, max);
 }
 
+int PdNumberBox::formatValue(char* buffer, size_t bufferSize) const {
+    // Même rendu que formatValue(), sans allocation
+    if (displayPrecision == 0) {
+        return PdNumberFormat::formatInt(buffer, bufferSize, (long long)round(displayValue));
+    }
+    return PdNumberFormat::formatFloat(buffer, bufferSize, displayValue, displayPrecision);
+}
+
+void PdNumberBox::updateValueLabel() {
+    char buffer[PdNumberFormat::MAX_LENGTH];
+    int length = formatValue(buffer, sizeof(buffer));
+    valueLabel.set(buffer, length);
+}
+
+void PdNumberBox::setFontSize(int fontSize) {
+    PdGuiObject::setFontSize(fontSize);
+    valueLabel.setFontSize(fontSize);
+}
+
+uint64_t PdNumberBox::computeRenderKey() const {
+    // Texte affiché (FNV-1a) et couleur de fond pendant le drag
+    char buffer[PdNumberFormat::MAX_LENGTH];
+    int length = formatValue(buffer, sizeof(buffer));
+    
+    uint64_t hash = 14695981039346656037ULL;
+    for (int i = 0; i < length; i++) {
+        hash = (hash ^ (uint8_t)buffer[i]) * 1099511628211ULL;
+    }
+    return mixRenderKey(getBaseRenderKey() | ((uint64_t)isDraggingValue << 4), hash);
+}
+
+float PdNumberBox::getDisplayQuantum() const {
+    // Dernier chiffre affiché ; pas de lissage, le texte montre la dernière valeur
+    return pow(10.0f, -(float)displayPrecision);
+}
+
 string PdNumberBox::formatValue() const {
     if (displayPrecision == 0) {
         // Affichage entier
-        return ofToString((int)round(currentValue));
+        return ofToString((int)round(displayValue));
     } else {
         // Affichage avec décimales
-        return ofToString(currentValue, displayPrecision);
+        return ofToString(displayValue, displayPrecision);
     }
 }
 
-void PdNumberBox::drawNumberText() {
-    string valueStr = formatValue();
-    
+ofColor PdNumberBox::getTextColor() const {
     // Couleur du texte selon l'état
     ofColor textColor = DEFAULT_FG_COLOR;
     if (isDraggingValue) {
@@ -176,10 +243,12 @@ void PdNumberBox::drawNumberText() {
         textColor = textColor * 0.5f;
     }
     
-    ofSetColor(textColor);
-    
-    // Calculer la position pour centrer le texte
-    float textWidth = valueStr.length() * 8; // Approximation pour bitmap font
+    return textColor;
+}
+
+ofVec2f PdNumberBox::getTextPosition() const {
+    // Calculer la position pour centrer le texte avec la largeur mesurée par l'atlas
+    float textWidth = valueLabel.getWidth();
     float textHeight = 8; // Hauteur approximative bitmap font
     
     // CORRECTION: Utiliser les coordonnées locales (0,0 = coin supérieur gauche de l'objet)
@@ -190,10 +259,16 @@ void PdNumberBox::drawNumberText() {
     textX = max(2.0f, textX);
     textY = max(textHeight, textY);
     
-    ofDrawBitmapString(valueStr, textX, textY);
+    return ofVec2f(textX, textY);
+}
+
+void PdNumberBox::drawNumberText() {
+    updateValueLabel();
+    ofVec2f textPos = getTextPosition();
+    valueLabel.draw(textPos.x, textPos.y, getTextColor());
 }
 
-void PdNumberBox::drawBackground() {
+ofColor PdNumberBox::getBackgroundColor() const {
     ofColor bgColor = DEFAULT_BG_COLOR;
     
     if (isDraggingValue) {
@@ -208,9 +283,7 @@ void PdNumberBox::drawBackground() {
         bgColor = bgColor * 0.5f;
     }
     
-    ofSetColor(bgColor);
-    // CORRECTION: Utiliser les coordonnées locales
-    ofDrawRectangle(0, 0, size.x, size.y);
+    return bgColor;
 }
 
 float PdNumberBox::calculateDragDelta(float currentY) const {
@@ -13,13 +13,17 @@ class PdNumberBox : public PdGuiObject {
 public:
     // Constructeur
     PdNumberBox(ofVec2f position, ofVec2f size,
-                const string& sendSymbol, const string& receiveSymbol,
+                PdSymbol sendSymbol, PdSymbol receiveSymbol,
                 float min = -1000000.0f, float max = 1000000.0f,
                 float initialValue = 0.0f, int precision = 2);
     
     // Méthodes virtuelles héritées
     virtual void update() override;
     virtual void draw() override;
+    virtual bool drawBatched(PdPrimitiveBatch& batch) override;
+    virtual ofRectangle getDrawBounds() const override;
+    virtual void setFontSize(int fontSize) override;
+    virtual float getDisplayQuantum() const override;
     
     // Gestion spécifique des événements souris
     virtual bool onMousePressed(ofMouseEventArgs& args) override;
@@ -45,10 +49,20 @@ protected:
     float dragStartY;
     bool isDraggingValue;
     
+    // Valeur affichée, remise en forme seulement quand le texte change
+    PdTextLabel valueLabel;
+    
+    // Clé de rendu : texte affiché et état du drag
+    virtual uint64_t computeRenderKey() const override;
+    
     // Formatage et affichage
     string formatValue() const;
+    int formatValue(char* buffer, size_t bufferSize) const;
+    void updateValueLabel();
     void drawNumberText();
-    void drawBackground() override;
+    ofColor getBackgroundColor() const override;
+    ofColor getTextColor() const;
+    ofVec2f getTextPosition() const;
     
     // Calculs de drag
     float calculateDragDelta(float currentY) const;
@@ -0,0 +1,155 @@
+//
+//  NumberFormat.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 18/07/2025.
+//
+
+#include "NumberFormat.h"
+#include <charconv>
+#include <cmath>
+
+int PdNumberFormat::formatInt(char* buffer, size_t bufferSize, long long value) {
+    if (bufferSize == 0) return 0;
+    
+    // Chiffres écrits à l'envers dans un tampon local
+    char digits[24];
+    int count = 0;
+    bool negative = value < 0;
+    unsigned long long magnitude = negative ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+    
+    do {
+        digits[count++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    
+    int length = 0;
+    if (negative && (size_t)length + 1 < bufferSize) {
+        buffer[length++] = '-';
+    }
+    while (count > 0 && (size_t)length + 1 < bufferSize) {
+        buffer[length++] = digits[--count];
+    }
+    
+    buffer[length] = '\0';
+    return length;
+}
+
+int PdNumberFormat::formatFloat(char* buffer, size_t bufferSize, float value, int precision) {
+    if (bufferSize == 0) return 0;
+    
+    if (std::isnan(value) || std::isinf(value)) {
+        const char* text = std::isnan(value) ? "nan" : (value < 0 ? "-inf" : "inf");
+        int length = 0;
+        while (text[length] && (size_t)length + 1 < bufferSize) {
+            buffer[length] = text[length];
+            length++;
+        }
+        buffer[length] = '\0';
+        return length;
+    }
+    
+    if (precision < 0) precision = 0;
+    if (precision > 9) precision = 9;
+    
+    // Arrondir une seule fois sur l'entier mis à l'échelle
+    long long scale = 1;
+    for (int i = 0; i < precision; i++) scale *= 10;
+    
+    double scaled = std::fabs((double)value) * scale;
+    if (scaled > 9.0e17) scaled = 9.0e17; // Reste dans un long long
+    long long rounded = (long long)std::llround(scaled);
+    
+    long long integerPart = rounded / scale;
+    long long fractionPart = rounded % scale;
+    bool negative = value < 0 && rounded != 0;
+    
+    int length = 0;
+    if (negative && (size_t)length + 1 < bufferSize) {
+        buffer[length++] = '-';
+    }
+    length += formatInt(buffer + length, bufferSize - length, integerPart);
+    
+    if (precision > 0 && (size_t)length + 1 < bufferSize) {
+        buffer[length++] = '.';
+        
+        // Décimales avec les zéros de tête
+        for (long long divisor = scale / 10; divisor > 0 && (size_t)length + 1 < bufferSize; divisor /= 10) {
+            buffer[length++] = (char)('0' + (fractionPart / divisor) % 10);
+        }
+        buffer[length] = '\0';
+    }
+    
+    return length;
+}
+
+bool PdNumberFormat::parseFloat(std::string_view text, float& value) {
+    const char* p = text.data();
+    const char* end = p + text.size();
+    if (p == end) return false;
+    
+    bool negative = false;
+    if (*p == '-' || *p == '+') {
+        negative = (*p == '-');
+        p++;
+    }
+    
+    // Mantisse accumulée en entier : exacte pour les nombres courants de Pd
+    unsigned long long mantissa = 0;
+    int exponent = 0;
+    int digits = 0;
+    
+    for (; p < end && *p >= '0' && *p <= '9'; p++, digits++) {
+        if (mantissa < 100000000000000000ULL) {
+            mantissa = mantissa * 10 + (*p - '0');
+        } else {
+            exponent++;
+        }
+    }
+    
+    if (p < end && *p == '.') {
+        p++;
+        for (; p < end && *p >= '0' && *p <= '9'; p++, digits++) {
+            if (mantissa < 100000000000000000ULL) {
+                mantissa = mantissa * 10 + (*p - '0');
+                exponent--;
+            }
+        }
+    }
+    
+    if (digits == 0) return false;
+    
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        int exponentValue = 0;
+        std::from_chars_result result = std::from_chars(p + (p < end && *p == '+' ? 1 : 0), end, exponentValue);
+        if (result.ec != std::errc()) return false;
+        exponent += exponentValue;
+        p = result.ptr;
+    }
+    
+    if (p != end) return false;
+    
+    double result = (double)mantissa;
+    if (exponent != 0) {
+        result *= std::pow(10.0, exponent);
+    }
+    value = (float)(negative ? -result : result);
+    return true;
+}
+
+bool PdNumberFormat::parseInt(std::string_view text, int& value) {
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+    if (begin != end && *begin == '+') begin++;
+    
+    std::from_chars_result result = std::from_chars(begin, end, value);
+    if (result.ec != std::errc()) return false;
+    if (result.ptr == end) return true;
+    
+    // "12.5" : Pd stocke parfois des entiers sous forme décimale
+    float floatValue;
+    if (!parseFloat(text, floatValue)) return false;
+    value = (int)floatValue;
+    return true;
+}
@@ -0,0 +1,28 @@
+//
+//  NumberFormat.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 18/07/2025.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+// Formatage des nombres sans allocation, dans un tampon fourni par l'appelant.
+// Même rendu que ofToString(value, precision) (notation fixe), sans "-0".
+// Lecture sans allocation ni locale des nombres d'un patch.
+class PdNumberFormat {
+public:
+    // Retournent le nombre de caractères écrits (hors zéro final)
+    static int formatInt(char* buffer, size_t bufferSize, long long value);
+    static int formatFloat(char* buffer, size_t bufferSize, float value, int precision);
+    
+    // Retournent false si le texte n'est pas entièrement un nombre
+    // (std::from_chars sur float n'est pas disponible sur notre cible macOS)
+    static bool parseFloat(std::string_view text, float& value);
+    static bool parseInt(std::string_view text, int& value);
+    
+    static constexpr size_t MAX_LENGTH = 32;
+};
@@ -0,0 +1,134 @@
+//
+//  ParserBenchmark.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 20/07/2025.
+//
+
+#include "ParserBenchmark.h"
+#include "PatchParser.h"
+#include <chrono>
+#include <cstdio>
+
+std::string PdParserBenchmark::generatePatch(size_t numObjects) {
+    std::string patch;
+    patch.reserve(numObjects * 80);
+    patch += "#N canvas 0 50 1200 800 12;\n";
+    
+    char line[768];
+    size_t objectIndex = 0;
+    
+    for (size_t i = 0; i < numObjects; i++) {
+        int x = (int)(i % 40) * 30;
+        int y = (int)((i / 40) % 40) * 30;
+        
+        switch (i % 10) {
+            case 0:
+                snprintf(line, sizeof(line),
+                         "#X obj %d %d hsl 128 15 0 127 0 0 hsl_%zu_s hsl_%zu_r empty -2 -8 0 10 #fcfcfc #000000 #000000 0 1;\n",
+                         x, y, i, i);
+                break;
+            case 1:
+                // Pd coupe les lignes longues : enregistrement sur deux lignes
+                snprintf(line, sizeof(line),
+                         "#X obj %d %d vsl 15 128 0 127 0 0 vsl_%zu_s vsl_%zu_r empty 0 -9 0 10\n#fcfcfc #000000 #000000 0 1;\n",
+                         x, y, i, i);
+                break;
+            case 2:
+                snprintf(line, sizeof(line),
+                         "#X obj %d %d tgl 15 0 tgl_%zu_s tgl_%zu_r empty 17 7 0 10 #fcfcfc #000000 #000000 0 1;\n",
+                         x, y, i, i);
+                break;
+            case 3:
+                snprintf(line, sizeof(line),
+                         "#X obj %d %d bng 15 250 50 0 bng_%zu_s bng_%zu_r empty 17 7 0 10 #fcfcfc #000000 #000000;\n",
+                         x, y, i, i);
+                break;
+            case 4:
+                snprintf(line, sizeof(line),
+                         "#X floatatom %d %d 5 0 0 0 - num_%zu_r num_%zu_s 0, f 8;\n",
+                         x, y, i, i);
+                break;
+            case 5:
+                snprintf(line, sizeof(line),
+                         "#X obj %d %d cnv 15 100 60 empty empty label\\ %zu 20 12 0 14 #e0e0e0 #404040 0;\n",
+                         x, y, i);
+                break;
+            case 6:
+                snprintf(line, sizeof(line), "#X obj %d %d osc~ %zu;\n", x, y, 220 + i % 800);
+                break;
+            case 7:
+                // Virgules et points-virgules échappés dans un message
+                snprintf(line, sizeof(line), "#X msg %d %d set \\$1 \\, %zu \\; dest %zu;\n", x, y, i, i);
+                break;
+            case 8: {
+                // Sous-patch avec un objet GUI, et un niveau imbriqué un sur quatre
+                int length = snprintf(line, sizeof(line),
+                                      "#N canvas 0 50 450 300 sub%zu 0;\n#X obj 10 10 inlet;\n"
+                                      "#X obj 10 40 tgl 15 0 sub%zu_s sub%zu_r empty 17 7 0 10 #fcfcfc #000000 #000000 0 1;\n",
+                                      i, i, i);
+                int outletIndex = 2;
+                if ((i / 10) % 4 == 0) {
+                    length += snprintf(line + length, sizeof(line) - length,
+                                       "#N canvas 0 50 300 200 inner%zu 0;\n"
+                                       "#X obj 10 10 hsl 128 15 0 127 0 0 inner%zu_s inner%zu_r empty -2 -8 0 10 #fcfcfc #000000 #000000 0 1;\n"
+                                       "#X restore 60 40 pd inner%zu;\n",
+                                       i, i, i, i);
+                    outletIndex = 3;
+                }
+                snprintf(line + length, sizeof(line) - length,
+                         "#X obj 10 60 outlet;\n#X connect 0 0 %d 0;\n#X restore %d %d pd sub%zu;\n",
+                         outletIndex, x, y, i);
+                break;
+            }
+            default:
+                snprintf(line, sizeof(line), "#X text %d %d comment number %zu with some words;\n", x, y, i);
+                break;
+        }
+        
+        patch += line;
+        objectIndex++;
+        
+        // Une connexion pour deux objets
+        if (objectIndex > 1 && i % 2 == 0) {
+            snprintf(line, sizeof(line), "#X connect %zu 0 %zu 0;\n", objectIndex - 2, objectIndex - 1);
+            patch += line;
+        }
+    }
+    
+    return patch;
+}
+
+int PdParserBenchmark::run(size_t numObjects, int iterations) {
+    std::string patch = generatePatch(numObjects);
+    iterations = std::max(1, iterations);
+    
+    PdPatchParser parser;
+    size_t numGuiObjects = 0;
+    double totalSeconds = 0.0;
+    double bestSeconds = 1e30;
+    
+    for (int i = 0; i < iterations; i++) {
+        auto start = std::chrono::steady_clock::now();
+        auto objects = parser.parseBuffer(patch.data(), patch.size());
+        auto end = std::chrono::steady_clock::now();
+        
+        double seconds = std::chrono::duration<double>(end - start).count();
+        totalSeconds += seconds;
+        bestSeconds = std::min(bestSeconds, seconds);
+        numGuiObjects = objects.size();
+    }
+    
+    double meanSeconds = totalSeconds / iterations;
+    size_t numLines = parser.getNumLines();
+    size_t numRecords = parser.getNumRecords();
+    
+    printf("parser benchmark: %zu bytes, %zu lines, %zu records, %zu GUI objects\n",
+           patch.size(), numLines, numRecords, numGuiObjects);
+    printf("  mean %.3f ms, best %.3f ms over %d iterations\n",
+           meanSeconds * 1000.0, bestSeconds * 1000.0, iterations);
+    printf("  %.0f lines/s, %.0f records/s, %.0f objects/s\n",
+           numLines / meanSeconds, numRecords / meanSeconds, numGuiObjects / meanSeconds);
+    
+    return 0;
+}
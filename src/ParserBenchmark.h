@@ -0,0 +1,22 @@
+//
+//  ParserBenchmark.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 20/07/2025.
+//
+
+#pragma once
+
+#include <string>
+
+// Mesure du temps de chargement d'un patch synthétique.
+// Lancé par : pd-gui --bench-parser [nombre_objets] [iterations]
+class PdParserBenchmark {
+public:
+    // Patch réaliste : objets GUI, objets audio, messages, connexions,
+    // sous-patchs et enregistrements sur plusieurs lignes
+    static std::string generatePatch(size_t numObjects);
+    
+    // Affiche lignes/s et objets/s ; retourne le code de sortie du programme
+    static int run(size_t numObjects, int iterations);
+};
@@ -0,0 +1,207 @@
+//
+//  PatchCache.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 22/07/2025.
+//
+
+#include "PatchCache.h"
+#include "PatchParser.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+static const char CACHE_MAGIC[4] = { 'P', 'D', 'G', 'C' };
+static const uint32_t CACHE_BYTE_ORDER = 0x01020304;
+
+bool PdPatchCache::open(const string& cachePath, uint64_t sourceHash, uint64_t sourceSize) {
+    close();
+    if (!file.open(cachePath)) return false;
+    
+    if (file.size() < sizeof(PdPatchCacheHeader)) {
+        close();
+        return false;
+    }
+    
+    PdPatchCacheHeader header;
+    memcpy(&header, file.getData(), sizeof(header));
+    
+    // Tout écart (format, machine, texte source) invalide le cache
+    size_t expectedSize = sizeof(header) + (size_t)header.numWidgets * sizeof(PdWidgetDesc) + header.stringSize;
+    if (memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+        header.version != VERSION ||
+        header.byteOrder != CACHE_BYTE_ORDER ||
+        header.descSize != sizeof(PdWidgetDesc) ||
+        header.sourceHash != sourceHash ||
+        header.sourceSize != sourceSize ||
+        file.size() != expectedSize) {
+        close();
+        return false;
+    }
+    
+    const char* widgets = file.getData() + sizeof(header);
+    const char* strings = widgets + (size_t)header.numWidgets * sizeof(PdWidgetDesc);
+    layout.setView(reinterpret_cast<const PdWidgetDesc*>(widgets), header.numWidgets, strings, header.stringSize);
+    layout.setPatchFontSize((int)header.patchFontSize);
+    return true;
+}
+
+void PdPatchCache::close() {
+    layout.setView(nullptr, 0, nullptr, 0);
+    file.close();
+}
+
+void PdPatchCache::serialize(const PdPatchLayout& layout, uint64_t sourceHash, uint64_t sourceSize, string& out) {
+    PdPatchCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = VERSION;
+    header.byteOrder = CACHE_BYTE_ORDER;
+    header.descSize = sizeof(PdWidgetDesc);
+    header.sourceHash = sourceHash;
+    header.sourceSize = sourceSize;
+    header.numWidgets = (uint32_t)layout.getNumWidgets();
+    header.stringSize = (uint32_t)layout.getStringSize();
+    header.patchFontSize = (uint32_t)layout.getPatchFontSize();
+    
+    out.clear();
+    out.reserve(sizeof(header) + layout.getNumWidgets() * sizeof(PdWidgetDesc) + layout.getStringSize());
+    out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.append(reinterpret_cast<const char*>(layout.getWidgets()), layout.getNumWidgets() * sizeof(PdWidgetDesc));
+    out.append(layout.getStringData(), layout.getStringSize());
+}
+
+bool PdPatchCache::write(const string& cachePath, const PdPatchLayout& layout,
+                         uint64_t sourceHash, uint64_t sourceSize) {
+    string data;
+    serialize(layout, sourceHash, sourceSize, data);
+    
+    // Écrire à côté puis renommer : un redémarrage pendant l'écriture
+    // ne laisse jamais un cache tronqué
+    string fullPath = ofToDataPath(cachePath, true);
+    string tempPath = fullPath + ".tmp";
+    
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            ofLogError("PdPatchCache") << "Cannot write cache: " << tempPath;
+            return false;
+        }
+        
+        out.write(data.data(), data.size());
+        
+        if (!out) {
+            ofLogError("PdPatchCache") << "Error while writing cache: " << tempPath;
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+    
+    if (std::rename(tempPath.c_str(), fullPath.c_str()) != 0) {
+        ofLogError("PdPatchCache") << "Cannot replace cache: " << fullPath;
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    
+    return true;
+}
+
+uint64_t PdPatchCache::hashSource(const char* data, size_t size) {
+    // FNV-1a 64 bits
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+string PdPatchCache::getCachePath(const string& patchPath) {
+    // patch.pd -> patch.pdc
+    return patchPath + "c";
+}
+
+PdObjectList PdPatchCache::loadPatch(const string& patchPath, bool updateCache) {
+    PdMappedFile source;
+    if (!source.open(patchPath)) {
+        ofLogError("PdPatchCache") << "Cannot open file or file is empty: " << patchPath;
+        return PdObjectList();
+    }
+    
+    uint64_t sourceHash = hashSource(source.getData(), source.size());
+    string cachePath = getCachePath(patchPath);
+    
+    // Cache à jour : pas de parsing du texte
+    PdPatchCache cache;
+    if (cache.open(cachePath, sourceHash, source.size())) {
+        PdObjectList objects = cache.getLayout().instantiate();
+        ofLogNotice("PdPatchCache") << "Loaded " << objects.size() << " GUI objects from " << cachePath;
+        return objects;
+    }
+    
+    PdPatchLayout layout;
+    parseAndCache(source, cachePath, sourceHash, layout, updateCache, nullptr);
+    
+    PdObjectList objects = layout.instantiate();
+    ofLogNotice("PdPatchCache") << "Parsed " << objects.size() << " GUI objects from " << patchPath;
+    return objects;
+}
+
+bool PdPatchCache::loadLayout(const string& patchPath, PdPatchLayout& layout, bool updateCache,
+                              const std::atomic<bool>* cancelFlag) {
+    PdMappedFile source;
+    if (!source.open(patchPath)) {
+        ofLogError("PdPatchCache") << "Cannot open file or file is empty: " << patchPath;
+        return false;
+    }
+    
+    uint64_t sourceHash = hashSource(source.getData(), source.size());
+    string cachePath = getCachePath(patchPath);
+    
+    PdPatchCache cache;
+    if (cache.open(cachePath, sourceHash, source.size())) {
+        // Le fichier mappé est fermé en sortie : recopier
+        layout.assign(cache.getLayout());
+        return true;
+    }
+    
+    return parseAndCache(source, cachePath, sourceHash, layout, updateCache, cancelFlag);
+}
+
+bool PdPatchCache::parseAndCache(const PdMappedFile& source, const string& cachePath, uint64_t sourceHash,
+                                 PdPatchLayout& layout, bool updateCache, const std::atomic<bool>* cancelFlag) {
+    PdPatchParser parser;
+    parser.setCancelFlag(cancelFlag);
+    parser.parseLayout(source.getData(), source.size(), layout);
+    
+    // Disposition incomplète : ne pas l'écrire dans le cache
+    if (parser.wasCancelled()) return false;
+    
+    if (updateCache && !write(cachePath, layout, sourceHash, source.size())) {
+        ofLogWarning("PdPatchCache") << "Cache not updated for " << cachePath;
+    }
+    return true;
+}
+
+int PdPatchCache::precompile(const string& patchPath, const string& cachePath) {
+    PdMappedFile source;
+    if (!source.open(patchPath)) {
+        fprintf(stderr, "cannot open %s\n", patchPath.c_str());
+        return 1;
+    }
+    
+    PdPatchParser parser;
+    PdPatchLayout layout;
+    parser.parseLayout(source.getData(), source.size(), layout);
+    
+    string outputPath = cachePath.empty() ? getCachePath(patchPath) : cachePath;
+    if (!write(outputPath, layout, hashSource(source.getData(), source.size()), source.size())) {
+        fprintf(stderr, "cannot write %s\n", outputPath.c_str());
+        return 1;
+    }
+    
+    printf("%s -> %s: %zu records, %zu widgets, %zu bytes of strings\n",
+           patchPath.c_str(), outputPath.c_str(), parser.getNumRecords(),
+           layout.getNumWidgets(), layout.getStringSize());
+    return 0;
+}
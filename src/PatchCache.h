@@ -0,0 +1,70 @@
+//
+//  PatchCache.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 22/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "PatchLayout.h"
+#include "MappedFile.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// En-tête du cache binaire, suivi de numWidgets PdWidgetDesc puis de la
+// table de chaînes. Le fichier est projeté en mémoire et lu sans copie.
+struct PdPatchCacheHeader {
+    char magic[4];        // "PDGC"
+    uint32_t version;
+    uint32_t byteOrder;   // 0x01020304 dans l'ordre de la machine qui l'a écrit
+    uint32_t descSize;    // sizeof(PdWidgetDesc)
+    uint64_t sourceHash;  // FNV-1a 64 bits du .pd
+    uint64_t sourceSize;
+    uint32_t numWidgets;
+    uint32_t stringSize;
+    uint32_t patchFontSize;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(PdPatchCacheHeader) == 48, "PdPatchCacheHeader layout changed");
+
+// Cache précompilé d'un patch (patch.pd -> patch.pdc)
+class PdPatchCache {
+public:
+    static constexpr uint32_t VERSION = 3;
+    
+    // Ouvre un cache et vérifie qu'il correspond au texte source
+    bool open(const string& cachePath, uint64_t sourceHash, uint64_t sourceSize);
+    void close();
+    const PdPatchLayout& getLayout() const { return layout; }
+    
+    static bool write(const string& cachePath, const PdPatchLayout& layout,
+                      uint64_t sourceHash, uint64_t sourceSize);
+    
+    // Même format en mémoire (envoi de la disposition aux clients distants)
+    static void serialize(const PdPatchLayout& layout, uint64_t sourceHash, uint64_t sourceSize, string& out);
+    static uint64_t hashSource(const char* data, size_t size);
+    static string getCachePath(const string& patchPath);
+    
+    // Charge un patch depuis son cache s'il est à jour ; sinon parse le
+    // texte et réécrit le cache
+    static PdObjectList loadPatch(const string& patchPath, bool updateCache = true);
+    
+    // Même chargement, sans créer les objets : layout reçoit une copie possédée.
+    // Utilisable depuis un thread de chargement ; false si cancelFlag interrompt le parsing.
+    static bool loadLayout(const string& patchPath, PdPatchLayout& layout, bool updateCache = true,
+                           const std::atomic<bool>* cancelFlag = nullptr);
+    
+    // Outil de déploiement : pd-gui --precompile patch.pd [patch.pdc]
+    static int precompile(const string& patchPath, const string& cachePath);
+    
+private:
+    static bool parseAndCache(const PdMappedFile& source, const string& cachePath, uint64_t sourceHash,
+                              PdPatchLayout& layout, bool updateCache, const std::atomic<bool>* cancelFlag);
+    
+    PdMappedFile file;
+    PdPatchLayout layout;
+};
@@ -0,0 +1,148 @@
+//
+//  PatchDiff.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 24/07/2025.
+//
+
+#include "PatchDiff.h"
+#include <string>
+#include <unordered_map>
+
+namespace {
+    // Clé d'appariement : type et symboles, avec ou sans position
+    std::string makeKey(const PdPatchLayout& layout, const PdWidgetDesc& desc, bool withPosition) {
+        std::string key;
+        key += (char)desc.type;
+        key += layout.getString(desc.sendSymbol);
+        key += '\0';
+        key += layout.getString(desc.receiveSymbol);
+        if (withPosition) {
+            key += '\0';
+            key.append((const char*)&desc.x, sizeof(desc.x));
+            key.append((const char*)&desc.y, sizeof(desc.y));
+        }
+        return key;
+    }
+}
+
+void PdPatchDiff::compute(const PdPatchLayout& oldLayout, const PdPatchLayout& newLayout) {
+    entries.clear();
+    removed.clear();
+    
+    const PdWidgetDesc* oldWidgets = oldLayout.getWidgets();
+    const PdWidgetDesc* newWidgets = newLayout.getWidgets();
+    size_t numOld = oldLayout.getNumWidgets();
+    size_t numNew = newLayout.getNumWidgets();
+    
+    // Anciens objets par clé, dans l'ordre z pour départager les doublons
+    std::unordered_map<std::string, std::vector<int>> byPosition;
+    std::unordered_map<std::string, std::vector<int>> byIdentity;
+    for (size_t i = 0; i < numOld; i++) {
+        // Parcours à rebours : back() donne le premier objet
+        size_t index = numOld - 1 - i;
+        byPosition[makeKey(oldLayout, oldWidgets[index], true)].push_back((int)index);
+        byIdentity[makeKey(oldLayout, oldWidgets[index], false)].push_back((int)index);
+    }
+    
+    std::vector<bool> used(numOld, false);
+    entries.assign(numNew, Entry{Action::CREATE, -1});
+    
+    auto take = [&](std::vector<int>& candidates) {
+        while (!candidates.empty()) {
+            int index = candidates.back();
+            candidates.pop_back();
+            if (!used[index]) {
+                used[index] = true;
+                return index;
+            }
+        }
+        return -1;
+    };
+    
+    // Première passe : même place
+    for (size_t j = 0; j < numNew; j++) {
+        auto it = byPosition.find(makeKey(newLayout, newWidgets[j], true));
+        if (it != byPosition.end()) {
+            entries[j].oldIndex = take(it->second);
+        }
+    }
+    
+    // Seconde passe : objets déplacés
+    for (size_t j = 0; j < numNew; j++) {
+        if (entries[j].oldIndex >= 0) continue;
+        auto it = byIdentity.find(makeKey(newLayout, newWidgets[j], false));
+        if (it != byIdentity.end()) {
+            entries[j].oldIndex = take(it->second);
+        }
+    }
+    
+    for (size_t j = 0; j < numNew; j++) {
+        Entry& entry = entries[j];
+        if (entry.oldIndex < 0) continue;
+        
+        const PdWidgetDesc& oldDesc = oldWidgets[entry.oldIndex];
+        const PdWidgetDesc& newDesc = newWidgets[j];
+        
+        if (!sameProperties(oldLayout, oldDesc, newLayout, newDesc)) {
+            entry.action = Action::REPLACE;
+        } else if (oldDesc.x != newDesc.x || oldDesc.y != newDesc.y
+                   || oldDesc.width != newDesc.width || oldDesc.height != newDesc.height
+                   || oldDesc.minValue != newDesc.minValue || oldDesc.maxValue != newDesc.maxValue) {
+            entry.action = Action::MUTATE;
+        } else {
+            entry.action = Action::KEEP;
+        }
+    }
+    
+    for (size_t i = 0; i < numOld; i++) {
+        if (!used[i]) removed.push_back((int)i);
+    }
+}
+
+size_t PdPatchDiff::count(Action action) const {
+    size_t total = 0;
+    for (const auto& entry : entries) {
+        if (entry.action == action) total++;
+    }
+    return total;
+}
+
+void PdPatchDiff::mutate(PdGuiObject& object, const PdWidgetDesc& desc) {
+    // Chaque setter invalide l'ancienne et la nouvelle zone
+    object.setPosition(ofVec2f(desc.x, desc.y));
+    
+    // Un sous-patch calcule sa taille lui-même (nom ou fenêtre GOP)
+    GuiType type = object.getType();
+    if (type != GuiType::SUBPATCH) {
+        object.setSize(ofVec2f(desc.width, desc.height));
+    }
+    
+    if (type == GuiType::HORIZONTAL_SLIDER || type == GuiType::VERTICAL_SLIDER || type == GuiType::NUMBER_BOX
+        || type == GuiType::ARRAY) {
+        object.setValueRange(desc.minValue, desc.maxValue);
+    }
+}
+
+bool PdPatchDiff::sameIdentity(const PdPatchLayout& a, const PdWidgetDesc& da,
+                               const PdPatchLayout& b, const PdWidgetDesc& db) {
+    return da.type == db.type
+        && a.getString(da.sendSymbol) == b.getString(db.sendSymbol)
+        && a.getString(da.receiveSymbol) == b.getString(db.receiveSymbol);
+}
+
+bool PdPatchDiff::sameProperties(const PdPatchLayout& a, const PdWidgetDesc& da,
+                                 const PdPatchLayout& b, const PdWidgetDesc& db) {
+    // Tout ce que mutate() ne sait pas appliquer ; la valeur initiale est
+    // ignorée puisque la valeur courante est conservée
+    return sameIdentity(a, da, b, db)
+        && da.flags == db.flags
+        && da.fontSize == db.fontSize
+        && da.precision == db.precision
+        && da.backgroundColor == db.backgroundColor
+        && da.foregroundColor == db.foregroundColor
+        && a.getString(da.label) == b.getString(db.label)
+        && a.getString(da.source) == b.getString(db.source)
+        && da.gopX == db.gopX && da.gopY == db.gopY
+        && da.gopWidth == db.gopWidth && da.gopHeight == db.gopHeight;
+}
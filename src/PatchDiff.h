@@ -0,0 +1,52 @@
+//
+//  PatchDiff.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 24/07/2025.
+//
+
+#pragma once
+
+#include "PatchLayout.h"
+#include <vector>
+
+// Différence entre deux dispositions d'un même patch (rechargement à chaud).
+// Les objets sont appariés par type, symboles send/receive et position,
+// puis, pour ceux qui n'ont pas trouvé de partenaire, par type et symboles
+// seulement (objet déplacé).
+class PdPatchDiff {
+public:
+    enum class Action : uint8_t {
+        KEEP,    // Identique : l'objet est conservé tel quel
+        MUTATE,  // Position, taille ou plage changées : modifié sur place
+        REPLACE, // Autre propriété changée : recréé, valeur conservée
+        CREATE   // Nouvel objet
+    };
+    
+    struct Entry {
+        Action action;
+        int oldIndex; // -1 pour CREATE
+    };
+    
+    // Une entrée par objet de la nouvelle disposition, dans son ordre z
+    void compute(const PdPatchLayout& oldLayout, const PdPatchLayout& newLayout);
+    
+    const std::vector<Entry>& getEntries() const { return entries; }
+    
+    // Objets de l'ancienne disposition sans partenaire, à détruire
+    const std::vector<int>& getRemoved() const { return removed; }
+    
+    size_t count(Action action) const;
+    
+    // Modifie sur place un objet MUTATE d'après sa nouvelle description
+    static void mutate(PdGuiObject& object, const PdWidgetDesc& desc);
+    
+private:
+    static bool sameIdentity(const PdPatchLayout& a, const PdWidgetDesc& da,
+                             const PdPatchLayout& b, const PdWidgetDesc& db);
+    static bool sameProperties(const PdPatchLayout& a, const PdWidgetDesc& da,
+                               const PdPatchLayout& b, const PdWidgetDesc& db);
+    
+    std::vector<Entry> entries;
+    std::vector<int> removed;
+};
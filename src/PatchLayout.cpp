@@ -0,0 +1,208 @@
+//
+//  PatchLayout.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 22/07/2025.
+//
+
+#include "PatchLayout.h"
+#include "Toggle.h"
+#include "Bang.h"
+#include "Slider.h"
+#include "NumberBox.h"
+#include "Canvas.h"
+#include "Subpatch.h"
+#include "VuMeter.h"
+#include "Array.h"
+#include "PatchParser.h"
+#include "WidgetStore.h"
+
+PdPatchLayout::PdPatchLayout()
+    : patchFontSize(12)
+    , widgets(nullptr)
+    , numWidgets(0)
+    , strings(nullptr)
+    , stringSize(0)
+{
+}
+
+void PdPatchLayout::addWidget(const PdWidgetDesc& desc) {
+    ownedWidgets.push_back(desc);
+    updateOwnedView();
+}
+
+PdStringRef PdPatchLayout::addString(std::string_view text) {
+    if (text.empty()) return PdStringRef();
+    
+    // Au plus une case sur deux occupée
+    if ((stringList.size() + 1) * 2 > stringSlots.size()) {
+        growStringIndex();
+    }
+    
+    size_t mask = stringSlots.size() - 1;
+    size_t slot = std::hash<std::string_view>()(text) & mask;
+    while (uint32_t entry = stringSlots[slot]) {
+        const PdStringRef& existing = stringList[entry - 1];
+        if (std::string_view(ownedStrings.data() + existing.offset, existing.length) == text) return existing;
+        slot = (slot + 1) & mask;
+    }
+    
+    PdStringRef ref;
+    ref.offset = (uint32_t)ownedStrings.size();
+    ref.length = (uint32_t)text.size();
+    ownedStrings.append(text.data(), text.size());
+    stringList.push_back(ref);
+    stringSlots[slot] = (uint32_t)stringList.size();
+    
+    updateOwnedView();
+    return ref;
+}
+
+void PdPatchLayout::growStringIndex() {
+    stringSlots.assign(std::max<size_t>(64, stringSlots.size() * 2), 0);
+    size_t mask = stringSlots.size() - 1;
+    
+    for (size_t i = 0; i < stringList.size(); i++) {
+        const PdStringRef& ref = stringList[i];
+        size_t slot = std::hash<std::string_view>()(std::string_view(ownedStrings.data() + ref.offset, ref.length)) & mask;
+        while (stringSlots[slot] != 0) slot = (slot + 1) & mask;
+        stringSlots[slot] = (uint32_t)(i + 1);
+    }
+}
+
+void PdPatchLayout::clearStrings() {
+    // Capacités conservées pour le prochain parsing
+    ownedStrings.clear();
+    stringList.clear();
+    std::fill(stringSlots.begin(), stringSlots.end(), 0);
+}
+
+void PdPatchLayout::append(const PdWidgetDesc& desc, const PdPatchLayout& from) {
+    // Les chaînes sont recopiées dans notre propre table
+    PdWidgetDesc copy = desc;
+    copy.sendSymbol = addString(from.getString(desc.sendSymbol));
+    copy.receiveSymbol = addString(from.getString(desc.receiveSymbol));
+    copy.label = addString(from.getString(desc.label));
+    copy.source = addString(from.getString(desc.source));
+    addWidget(copy);
+}
+
+void PdPatchLayout::clear() {
+    ownedWidgets.clear();
+    clearStrings();
+    updateOwnedView();
+}
+
+void PdPatchLayout::assign(const PdPatchLayout& other) {
+    if (&other == this) return;
+    
+    clear();
+    ownedWidgets.reserve(other.getNumWidgets());
+    for (size_t i = 0; i < other.getNumWidgets(); i++) {
+        append(other.getWidgets()[i], other);
+    }
+    patchFontSize = other.getPatchFontSize();
+}
+
+void PdPatchLayout::setView(const PdWidgetDesc* widgets, size_t numWidgets, const char* strings, size_t stringSize) {
+    ownedWidgets.clear();
+    clearStrings();
+    
+    this->widgets = widgets;
+    this->numWidgets = numWidgets;
+    this->strings = strings;
+    this->stringSize = stringSize;
+}
+
+void PdPatchLayout::updateOwnedView() {
+    widgets = ownedWidgets.data();
+    numWidgets = ownedWidgets.size();
+    strings = ownedStrings.data();
+    stringSize = ownedStrings.size();
+}
+
+std::string_view PdPatchLayout::getString(const PdStringRef& ref) const {
+    if (ref.length == 0 || (size_t)ref.offset + ref.length > stringSize) return std::string_view();
+    return std::string_view(strings + ref.offset, ref.length);
+}
+
+uint32_t PdPatchLayout::packColor(const ofColor& color) {
+    return ((uint32_t)color.r << 16) | ((uint32_t)color.g << 8) | (uint32_t)color.b;
+}
+
+ofColor PdPatchLayout::unpackColor(uint32_t rgb) {
+    return ofColor((rgb >> 16) & 0xff, (rgb >> 8) & 0xff, rgb & 0xff);
+}
+
+PdObjectList PdPatchLayout::instantiate() const {
+    PdObjectList objects;
+    objects.reserve(numWidgets);
+    
+    for (size_t i = 0; i < numWidgets; i++) {
+        auto obj = createWidget(widgets[i]);
+        if (obj) {
+            objects.push_back(move(obj));
+        }
+    }
+    
+    return objects;
+}
+
+PdGuiObjectPtr PdPatchLayout::createWidget(const PdWidgetDesc& desc) const {
+    ofVec2f pos(desc.x, desc.y);
+    ofVec2f size(desc.width, desc.height);
+    PdSymbol sendSymbol(getString(desc.sendSymbol));
+    PdSymbol receiveSymbol(getString(desc.receiveSymbol));
+    
+    switch ((GuiType)desc.type) {
+        case GuiType::HORIZONTAL_SLIDER:
+        case GuiType::VERTICAL_SLIDER: {
+            auto slider = PdWidgetStore::get().create<PdSlider>((GuiType)desc.type, pos, size, sendSymbol, receiveSymbol,
+                                                                desc.minValue, desc.maxValue, desc.initValue);
+            if (desc.fontSize > 0) slider->setFontSize(desc.fontSize);
+            return slider;
+        }
+        case GuiType::TOGGLE:
+            return PdWidgetStore::get().create<PdToggle>(pos, size, sendSymbol, receiveSymbol);
+        case GuiType::BANG:
+            return PdWidgetStore::get().create<PdBang>(pos, size, sendSymbol, receiveSymbol);
+        case GuiType::NUMBER_BOX: {
+            auto numberBox = PdWidgetStore::get().create<PdNumberBox>(pos, size, sendSymbol, receiveSymbol,
+                                                                      desc.minValue, desc.maxValue, desc.initValue, desc.precision);
+            if (desc.fontSize > 0) numberBox->setFontSize(desc.fontSize);
+            return numberBox;
+        }
+        case GuiType::CANVAS: {
+            auto canvas = PdWidgetStore::get().create<PdCanvas>(pos, size, string(getString(desc.label)),
+                                                                unpackColor(desc.backgroundColor), unpackColor(desc.foregroundColor));
+            if (desc.fontSize > 0) canvas->setLabelStyle(desc.fontSize);
+            return canvas;
+        }
+        case GuiType::SUBPATCH: {
+            PdGraphOnParent graphOnParent;
+            graphOnParent.enabled = (desc.flags & PdWidgetDesc::GOP_ENABLED) != 0;
+            graphOnParent.hideName = (desc.flags & PdWidgetDesc::GOP_HIDE_NAME) != 0;
+            graphOnParent.window.set(desc.gopX, desc.gopY, desc.gopWidth, desc.gopHeight);
+            return PdWidgetStore::get().create<PdSubpatch>(pos, string(getString(desc.label)), string(getString(desc.source)),
+                                                           graphOnParent, desc.fontSize > 0 ? desc.fontSize : patchFontSize);
+        }
+        case GuiType::VU_METER:
+            return PdWidgetStore::get().create<PdVuMeter>(pos, size, receiveSymbol,
+                                                          (desc.flags & PdWidgetDesc::VU_SCALE) != 0);
+        case GuiType::ARRAY: {
+            auto array = PdWidgetStore::get().create<PdArray>(pos, size, receiveSymbol, (size_t)max(1, desc.precision),
+                                                              desc.minValue, desc.maxValue,
+                                                              (desc.flags & PdWidgetDesc::ARRAY_POINTS) != 0);
+            // Valeurs enregistrées dans le patch
+            vector<float> values;
+            PdPatchParser::parseArrayValues(getString(desc.source), values);
+            if (!values.empty()) {
+                array->receiveSamples(0, values.data(), values.size());
+            }
+            return array;
+        }
+        default:
+            ofLogWarning("PdPatchLayout") << "Unknown widget type " << (int)desc.type;
+            return nullptr;
+    }
+}
@@ -0,0 +1,115 @@
+//
+//  PatchLayout.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 22/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "PdGuiObject.h"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Référence vers une chaîne de la table de chaînes d'une disposition
+struct PdStringRef {
+    uint32_t offset = 0;
+    uint32_t length = 0; // 0 = symbole vide
+};
+
+// Description à plat d'un objet GUI : ce que le parser extrait d'un
+// enregistrement, sans pointeur ni allocation. Stockée telle quelle dans
+// le cache binaire.
+struct PdWidgetDesc {
+    enum Flags : uint8_t {
+        GOP_ENABLED   = 1 << 0,
+        GOP_HIDE_NAME = 1 << 1,
+        VU_SCALE      = 1 << 2,
+        ARRAY_POINTS  = 1 << 3
+    };
+    
+    uint8_t type = 0;    // GuiType
+    uint8_t flags = 0;
+    uint16_t fontSize = 0; // 0 = police par défaut de l'objet
+    int32_t precision = 0; // Nombre de décimales, taille d'un tableau
+    
+    float x = 0, y = 0, width = 0, height = 0;
+    float minValue = 0, maxValue = 0, initValue = 0; // Tableau : valeurs en bas et en haut
+    
+    uint32_t backgroundColor = 0; // 0xRRGGBB
+    uint32_t foregroundColor = 0;
+    
+    PdStringRef sendSymbol;
+    PdStringRef receiveSymbol;
+    PdStringRef label;  // Label du canvas, nom du sous-patch
+    PdStringRef source; // Texte du sous-patch ou du graphe d'un tableau
+    
+    // Fenêtre graph-on-parent, en coordonnées du sous-patch
+    float gopX = 0, gopY = 0, gopWidth = 0, gopHeight = 0;
+};
+
+static_assert(std::is_trivially_copyable<PdWidgetDesc>::value, "PdWidgetDesc must stay POD");
+static_assert(sizeof(PdWidgetDesc) == 92, "PdWidgetDesc layout changed: bump PdPatchCache::VERSION");
+
+// Enregistrements d'un patch et leur table de chaînes. Peut posséder ses
+// données (parser) ou pointer dans un fichier mappé (cache).
+class PdPatchLayout {
+public:
+    PdPatchLayout();
+    
+    // Construction (parser)
+    void addWidget(const PdWidgetDesc& desc);
+    PdStringRef addString(std::string_view text);
+    void append(const PdWidgetDesc& desc, const PdPatchLayout& from);
+    void clear();
+    
+    // Copie possédée d'une autre disposition (par exemple d'une vue sur le cache)
+    void assign(const PdPatchLayout& other);
+    
+    // Vue sur des données externes (cache mappé), sans copie
+    void setView(const PdWidgetDesc* widgets, size_t numWidgets, const char* strings, size_t stringSize);
+    
+    const PdWidgetDesc* getWidgets() const { return widgets; }
+    size_t getNumWidgets() const { return numWidgets; }
+    const char* getStringData() const { return strings; }
+    size_t getStringSize() const { return stringSize; }
+    std::string_view getString(const PdStringRef& ref) const;
+    
+    // Police du patch principal (héritée par les sous-patchs)
+    int getPatchFontSize() const { return patchFontSize; }
+    void setPatchFontSize(int fontSize) { patchFontSize = fontSize; }
+    
+    // Création des objets GUI
+    PdObjectList instantiate() const;
+    PdGuiObjectPtr createWidget(const PdWidgetDesc& desc) const;
+    
+    static uint32_t packColor(const ofColor& color);
+    static ofColor unpackColor(uint32_t rgb);
+    
+private:
+    int patchFontSize;
+    
+    // Données possédées (construction par le parser)
+    std::vector<PdWidgetDesc> ownedWidgets;
+    std::string ownedStrings;
+    
+    // Une seule copie par chaîne : index à adressage ouvert sur le texte de
+    // ownedStrings (case = position dans stringList + 1, 0 = libre), sans
+    // clé std::string à construire pour chaque recherche
+    std::vector<PdStringRef> stringList;
+    std::vector<uint32_t> stringSlots;
+    
+    // Vue courante (données possédées ou mappées)
+    const PdWidgetDesc* widgets;
+    size_t numWidgets;
+    const char* strings;
+    size_t stringSize;
+    
+    void updateOwnedView();
+    void clearStrings();
+    void growStringIndex();
+};
@@ -0,0 +1,115 @@
+//
+//  PatchLoader.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#include "PatchLoader.h"
+#include "PatchCache.h"
+#include "FrameClock.h"
+#include "Profiler.h"
+
+PdPatchLoader::~PdPatchLoader() {
+    cancel();
+}
+
+void PdPatchLoader::load(const string& patchPath) {
+    cancel();
+    
+    path = patchPath;
+    loading = true;
+    startThread();
+}
+
+void PdPatchLoader::cancel() {
+    if (isThreadRunning()) {
+        cancelFlag = true;
+        waitForThread(true);
+    }
+    reset();
+}
+
+void PdPatchLoader::reset() {
+    // Une disposition envoyée avant l'annulation n'est plus attendue
+    std::unique_ptr<PdPatchLayout> stale;
+    while (parsed.tryReceive(stale)) {}
+    
+    cancelFlag = false;
+    layout.reset();
+    nextWidget = 0;
+    loading = false;
+    complete = false;
+    failed = false;
+}
+
+float PdPatchLoader::getProgress() const {
+    if (complete) return 1.0f;
+    if (!layout || layout->getNumWidgets() == 0) return 0.0f;
+    return (float)nextWidget / layout->getNumWidgets();
+}
+
+size_t PdPatchLoader::instantiate(PdObjectList& objects, uint64_t budgetMicros) {
+    if (!loading) return 0;
+    
+    if (!layout) {
+        if (!parsed.tryReceive(layout)) return 0;
+        PdProfiler::get().addTime(PdProfileSection::PARSE, parseStartMicros, parseMicros);
+        if (!layout) {
+            ofLogError("PdPatchLoader") << "Failed to load " << path;
+            loading = false;
+            failed = true;
+            return 0;
+        }
+        objects.reserve(objects.size() + layout->getNumWidgets());
+    }
+    
+    uint64_t start = ofGetElapsedTimeMicros();
+    size_t created = 0;
+    size_t numWidgets = layout->getNumWidgets();
+    const PdWidgetDesc* widgets = layout->getWidgets();
+    
+    while (nextWidget < numWidgets) {
+        auto object = layout->createWidget(widgets[nextWidget++]);
+        if (object) {
+            objects.push_back(std::move(object));
+            created++;
+        }
+        
+        // Lire l'horloge coûte plus cher que créer un objet simple
+        if (nextWidget % CLOCK_CHECK_INTERVAL == 0 &&
+            ofGetElapsedTimeMicros() - start >= budgetMicros) {
+            break;
+        }
+    }
+    
+    if (nextWidget == numWidgets) {
+        loading = false;
+        complete = true;
+    }
+    return created;
+}
+
+std::unique_ptr<PdPatchLayout> PdPatchLoader::takeLayout() {
+    if (!complete) return nullptr;
+    complete = false;
+    return std::move(layout);
+}
+
+void PdPatchLoader::threadedFunction() {
+    auto parsedLayout = std::make_unique<PdPatchLayout>();
+    
+    uint64_t start = ofGetElapsedTimeMicros();
+    bool loaded = PdPatchCache::loadLayout(path, *parsedLayout, true, &cancelFlag);
+    parseStartMicros = start;
+    parseMicros = ofGetElapsedTimeMicros() - start;
+    
+    if (!loaded) {
+        // Annulé : personne n'attend le résultat
+        if (cancelFlag) return;
+        parsedLayout.reset();
+    }
+    
+    parsed.send(std::move(parsedLayout));
+    PdFrameClock::wake();
+}
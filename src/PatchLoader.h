@@ -0,0 +1,62 @@
+//
+//  PatchLoader.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "PatchLayout.h"
+#include <atomic>
+#include <memory>
+#include <string>
+
+// Chargement d'un patch en arrière-plan. Le thread lit et parse le fichier
+// (cache compris) ; les objets GUI, qui touchent à OpenGL, sont créés sur le
+// thread principal par lots, sous un budget de temps par image, pour que
+// l'interface se remplisse progressivement.
+class PdPatchLoader : public ofThread {
+public:
+    ~PdPatchLoader();
+    
+    // Annule le chargement en cours éventuel et démarre le suivant
+    void load(const string& patchPath);
+    void cancel();
+    
+    bool isLoading() const { return loading; }
+    bool isComplete() const { return complete; }
+    bool hasFailed() const { return failed; }
+    float getProgress() const;
+    const string& getPath() const { return path; }
+    
+    // Thread principal : crée les objets suivants dans la limite du budget.
+    // Retourne le nombre d'objets ajoutés à la fin de objects.
+    size_t instantiate(PdObjectList& objects, uint64_t budgetMicros);
+    
+    // Disposition complète, une fois le chargement terminé
+    std::unique_ptr<PdPatchLayout> takeLayout();
+    
+private:
+    static constexpr size_t CLOCK_CHECK_INTERVAL = 16;
+    
+    void threadedFunction() override;
+    void reset();
+    
+    string path;
+    std::atomic<bool> cancelFlag{false};
+    ofThreadChannel<std::unique_ptr<PdPatchLayout>> parsed;
+    
+    // Durée du parsing mesurée par le thread, reportée au profileur par le
+    // thread principal (PdProfiler ignore les autres threads)
+    std::atomic<uint64_t> parseStartMicros{0};
+    std::atomic<uint64_t> parseMicros{0};
+    
+    // Thread principal uniquement
+    std::unique_ptr<PdPatchLayout> layout;
+    size_t nextWidget = 0;
+    bool loading = false;
+    bool complete = false;
+    bool failed = false;
+};
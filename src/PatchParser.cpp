@@ -6,320 +6,447 @@
 //
 
 #include "PatchParser.h"
+#include "Profiler.h"
+#include <charconv>
 
 using namespace std;
 
-vector<unique_ptr<PdGuiObject>> PdPatchParser::parseFile(const string& filename) {
-    vector<unique_ptr<PdGuiObject>> objects;
-    
+PdObjectList PdPatchParser::parseFile(const string& filename) {
     // Utiliser ofBuffer pour lire le fichier
     ofBuffer buffer = ofBufferFromFile(filename);
     
     if(buffer.size() == 0) {
         ofLogError("PdPatchParser") << "Cannot open file or file is empty: " << filename;
-        return objects;
+        return PdObjectList();
     }
     
-    // Parser ligne par ligne
-    for(auto line : buffer.getLines()) {
-        auto obj = parseLine(line);
-        if(obj) {
-            objects.push_back(move(obj));
-        }
-    }
+    PdObjectList objects = parseBuffer(buffer.getData(), buffer.size());
     
     ofLogNotice("PdPatchParser") << "Parsed " << objects.size() << " GUI objects from " << filename;
     return objects;
 }
 
-unique_ptr<PdGuiObject> PdPatchParser::parseLine(const string& line) {
-    vector<string> tokens = splitString(line, ' ');
-    if(tokens.size() < 3) return nullptr;
-    
-    try {
-        // Gérer les différents types de lignes Pure Data
-        if(line.find("#X obj") == 0) {
-            // Format: #X obj x y type params...
-            if(tokens.size() < 5) return nullptr;
-            
-            float x = ofToFloat(tokens[2]);
-            float y = ofToFloat(tokens[3]);
-            string type = tokens[4];
-            
-            if(type == "hsl") {
-                return parseHorizontalSlider(tokens, ofVec2f(x, y));
-            } else if(type == "vsl") {
-                return parseVerticalSlider(tokens, ofVec2f(x, y));
-            } else if(type == "tgl") {
-                return parseToggle(tokens, ofVec2f(x, y));
-            } else if(type == "bng") {
-                return parseBang(tokens, ofVec2f(x, y));
-            }  else if(type == "cnv") {  // NOUVEAU: Canvas
-                return parseCanvas(tokens, ofVec2f(x, y));
-            }
-        }
-        else if(line.find("#X floatatom") == 0) {
-            // Format: #X floatatom x y width min max label_pos label font_size send receive label
-            if(tokens.size() < 4) return nullptr;
-            
-            float x = ofToFloat(tokens[2]);
-            float y = ofToFloat(tokens[3]);
-            
-            return parseNumberBox(tokens, ofVec2f(x, y));
-        }
-    } catch(exception& e) {
-        ofLogError("PdPatchParser") << "Error parsing line: " << line;
-    }
-    
-    return nullptr;
+PdObjectList PdPatchParser::parseFile(const string& filename, PdSpatialGrid& spatialIndex) {
+    PdObjectList objects = parseFile(filename);
+    spatialIndex.build(objects);
+    return objects;
 }
 
-
-
-unique_ptr<PdGuiObject> PdPatchParser::parseHorizontalSlider(const vector<string>& tokens, ofVec2f pos) {
-    // Format: #X obj x y hsl width height min max lin_log iem_init_i send receive label x_off y_off font font_size bg_color fg_color label_color val;
-    if(tokens.size() < 12) return nullptr;
-    
-    string sendSym = tokens[10];
-    string receiveSym = tokens[11];
-    
-    // Ignorer les objets sans send/receive
-    if(sendSym == "empty" && receiveSym == "empty") return nullptr;
-    
-    ofVec2f size = ofVec2f(ofToFloat(tokens[5]), ofToFloat(tokens[6]));
-    float minVal = ofToFloat(tokens[7]);
-    float maxVal = ofToFloat(tokens[8]);
-    
-    // Valeur initiale (si disponible dans les tokens)
-    float initialValue = minVal; // Valeur par défaut
-    if(tokens.size() > 20) {
-        // La valeur initiale est souvent dans le dernier token pour les sliders PD
-        initialValue = ofToFloat(tokens[tokens.size() - 1]);
-        // S'assurer que la valeur est dans la plage
-        initialValue = ofClamp(initialValue, minVal, maxVal);
-    }
-    
-    return make_unique<PdSlider>(
-        GuiType::HORIZONTAL_SLIDER,
-        pos,
-        size,
-        sendSym,
-        receiveSym,
-        minVal,
-        maxVal,
-        initialValue
-    );
+PdObjectList PdPatchParser::parseBuffer(const char* data, size_t size) {
+    PdPatchLayout layout;
+    parseLayout(data, size, layout);
+    return layout.instantiate();
 }
 
-unique_ptr<PdGuiObject> PdPatchParser::parseVerticalSlider(const vector<string>& tokens, ofVec2f pos) {
-    // Format: #X obj x y vsl width height min max lin_log iem_init_i send receive label x_off y_off font font_size bg_color fg_color label_color val;
-    if(tokens.size() < 12) return nullptr;
-    
-    string sendSym = tokens[10];
-    string receiveSym = tokens[11];
-    
-    // Ignorer les objets sans send/receive
-    if(sendSym == "empty" && receiveSym == "empty") return nullptr;
-    
-    ofVec2f size = ofVec2f(ofToFloat(tokens[5]), ofToFloat(tokens[6]));
-    float minVal = ofToFloat(tokens[7]);
-    float maxVal = ofToFloat(tokens[8]);
-    
-    // Valeur initiale (si disponible dans les tokens)
-    float initialValue = minVal; // Valeur par défaut
-    if(tokens.size() > 20) {
-        // La valeur initiale est souvent dans le dernier token pour les sliders PD
-        initialValue = ofToFloat(tokens[tokens.size() - 1]);
-        // S'assurer que la valeur est dans la plage
-        initialValue = ofClamp(initialValue, minVal, maxVal);
+PdObjectList PdPatchParser::parseSubpatch(const PdSubpatch& subpatch) {
+    PdProfileScope scope(PdProfileSection::PARSE);
+    PdPatchLayout layout;
+    parseSubpatchLayout(subpatch.getSource(), subpatch.getPatchFontSize(), layout);
+    
+    // Les objets exposés en graph-on-parent sont déjà créés dans le parent
+    // (addSubpatch) : une seconde copie doublerait receivers et envois
+    const PdGraphOnParent& graphOnParent = subpatch.getGraphOnParent();
+    PdObjectList objects;
+    objects.reserve(layout.getNumWidgets());
+    for(size_t i = 0; i < layout.getNumWidgets(); i++) {
+        const PdWidgetDesc& desc = layout.getWidgets()[i];
+        if(graphOnParent.exposes(ofRectangle(desc.x, desc.y, desc.width, desc.height))) continue;
+        
+        auto obj = layout.createWidget(desc);
+        if(obj) objects.push_back(move(obj));
     }
-    
-    return make_unique<PdSlider>(
-        GuiType::VERTICAL_SLIDER,
-        pos,
-        size,
-        sendSym,
-        receiveSym,
-        minVal,
-        maxVal,
-        initialValue
-    );
+    return objects;
 }
 
-unique_ptr<PdGuiObject> PdPatchParser::parseToggle(const vector<string>& tokens, ofVec2f pos) {
-    if(tokens.size() < 10) return nullptr;
-    
-    string sendSym = tokens[8];
-    string receiveSym = tokens[9];
+void PdPatchParser::parseLayout(const char* data, size_t size, PdPatchLayout& layout) {
+    PdProfileScope scope(PdProfileSection::PARSE);
     
-    if(sendSym == "empty" && receiveSym == "empty") return nullptr;
+    patchFontSize = 12;
+    patchFontParsed = false;
+    numRecords = 0;
+    cancelled = false;
     
-    ofVec2f size = ofVec2f(ofToFloat(tokens[5]), ofToFloat(tokens[5])); // Carré
-    
-    return make_unique<PdToggle>(pos, size, sendSym, receiveSym);
+    layout.clear();
+    parseRecords(data, size, true, layout);
+    layout.setPatchFontSize(patchFontSize);
+}
+
+void PdPatchParser::parseSubpatchLayout(string_view source, int fontSize, PdPatchLayout& layout) {
+    // Le contenu d'un sous-patch n'a pas de "#N canvas" principal
+    patchFontSize = fontSize;
+    patchFontParsed = true;
+    numRecords = 0;
+    
+    layout.clear();
+    parseRecords(source.data(), source.size(), false, layout);
+    layout.setPatchFontSize(patchFontSize);
 }
 
-unique_ptr<PdGuiObject> PdPatchParser::parseBang(const vector<string>& tokens, ofVec2f pos) {
-    if(tokens.size() < 9) return nullptr;
+void PdPatchParser::parseRecords(const char* data, size_t size, bool hasRootCanvas, PdPatchLayout& layout) {
+    // Un seul passage sur le tampon ; le vecteur d'atomes est réutilisé
+    PdPatchTokenizer tokenizer(data, size);
+    PdAtoms atoms;
     
-    string sendSym = tokens[7];
-    string receiveSym = tokens[8];
+    // Sous-patchs ouverts entre "#N canvas" et "#X restore"
+    vector<CanvasFrame> canvasStack;
+    bool rootCanvasSeen = !hasRootCanvas;
     
-    if(sendSym == "empty" && receiveSym == "empty") return nullptr;
+    while(tokenizer.next(atoms)) {
+        numRecords++;
+        
+        if(cancelFlag && numRecords % CANCEL_CHECK_INTERVAL == 0 && cancelFlag->load(std::memory_order_relaxed)) {
+            cancelled = true;
+            break;
+        }
+        
+        // Ignorer les arguments après une virgule ("..., f 10" = largeur de la boîte)
+        for(size_t i = 0; i < atoms.size(); i++) {
+            if(atoms[i] == ",") {
+                atoms.resize(i);
+                break;
+            }
+        }
+        if(atoms.size() < 2) continue;
+        
+        if(atoms[0] == "#N" && atoms[1] == "canvas") {
+            if(!rootCanvasSeen) {
+                // Format: #N canvas x y width height font_size; (seul le patch principal compte)
+                if(!patchFontParsed && atoms.size() >= 7) {
+                    patchFontSize = max(1, toInt(atoms[6]));
+                    patchFontParsed = true;
+                }
+                rootCanvasSeen = true;
+            } else {
+                // Format: #N canvas x y width height name vis;
+                CanvasFrame frame;
+                frame.bodyStart = tokenizer.getPosition();
+                frame.name = atoms.size() > 6 ? atoms[6] : string_view();
+                canvasStack.push_back(frame);
+            }
+            continue;
+        }
+        
+        if(canvasStack.empty()) {
+            parseRecord(atoms, tokenizer.getRecordLine(), layout);
+            continue;
+        }
+        
+        // Contenu d'un sous-patch : conservé en texte, seuls coords et restore sont lus
+        if(atoms[0] == "#X" && atoms[1] == "coords") {
+            parseCoords(atoms, canvasStack.back());
+        }
+        else if(atoms[0] == "#X" && atoms[1] == "array" && atoms.size() >= 4) {
+            // Format: #X array name size float flags;
+            CanvasFrame& frame = canvasStack.back();
+            if(frame.arrayName.empty()) {
+                frame.arrayName = atoms[2];
+                frame.arraySize = max(1, toInt(atoms[3]));
+                frame.arrayFlags = atoms.size() > 5 ? toInt(atoms[5]) : 0;
+            }
+        }
+        else if(atoms[0] == "#X" && atoms[1] == "restore") {
+            CanvasFrame frame = canvasStack.back();
+            canvasStack.pop_back();
+            
+            // Les sous-patchs imbriqués font partie du texte de leur parent
+            if(canvasStack.empty()) {
+                // Format: #X restore x y graph; (graphe d'un tableau)
+                if(!frame.arrayName.empty() && atoms.size() > 4 && atoms[4] == "graph") {
+                    addArray(frame, tokenizer.getRecordStart(), atoms, layout);
+                } else {
+                    addSubpatch(frame, tokenizer.getRecordStart(), atoms, layout);
+                }
+            }
+        }
+    }
     
-    ofVec2f size = ofVec2f(ofToFloat(tokens[5]), ofToFloat(tokens[5]));
+    if(!canvasStack.empty()) {
+        ofLogWarning("PdPatchParser") << canvasStack.size() << " subpatch(es) without #X restore";
+    }
     
-    return make_unique<PdBang>(pos, size, sendSym, receiveSym);
+    numLines = tokenizer.getNumLines();
 }
 
-unique_ptr<PdGuiObject> PdPatchParser::parseNumberBox(const vector<string>& tokens, ofVec2f pos) {
-    // Format: #X floatatom x y width min max label_pos label font_size send receive label
-    // Exemple: #X floatatom 91 112 5 0 0 0 - - - 0;
-    if(tokens.size() < 7) return nullptr;
+void PdPatchParser::parseCoords(const PdAtoms& tokens, CanvasFrame& frame) {
+    // Format: #X coords x1 y1 x2 y2 width height gop xmargin ymargin
+    if(tokens.size() < 9) return;
     
-    float width = ofToFloat(tokens[4]) * 8; // Largeur en caractères * largeur approximative d'un caractère
-    float height = 20; // Hauteur standard
-    ofVec2f size(width, height);
+    frame.valueTop = toFloat(tokens[3]);
+    frame.valueBottom = toFloat(tokens[5]);
     
-    float minVal = ofToFloat(tokens[5]);
-    float maxVal = ofToFloat(tokens[6]);
+    PdGraphOnParent& graphOnParent = frame.graphOnParent;
+    int flags = toInt(tokens[8]);
+    graphOnParent.enabled = (flags & 1) != 0;
+    graphOnParent.hideName = (flags & 2) != 0;
     
-    // Si min == max == 0, utiliser une plage par défaut
-    if(minVal == 0 && maxVal == 0) {
-        minVal = -1000000.0f;
-        maxVal = 1000000.0f;
+    float xMargin = tokens.size() > 9 ? toFloat(tokens[9]) : 0.0f;
+    float yMargin = tokens.size() > 10 ? toFloat(tokens[10]) : 0.0f;
+    graphOnParent.window.set(xMargin, yMargin, toFloat(tokens[6]), toFloat(tokens[7]));
+}
+
+void PdPatchParser::addSubpatch(const CanvasFrame& frame, const char* bodyEnd, const PdAtoms& restore,
+                                PdPatchLayout& layout) {
+    // Format: #X restore x y pd name;
+    if(restore.size() < 4) return;
+    
+    const PdGraphOnParent& graphOnParent = frame.graphOnParent;
+    string_view source(frame.bodyStart, bodyEnd - frame.bodyStart);
+    
+    PdWidgetDesc desc;
+    desc.type = (uint8_t)GuiType::SUBPATCH;
+    desc.x = toFloat(restore[2]);
+    desc.y = toFloat(restore[3]);
+    desc.fontSize = (uint16_t)patchFontSize;
+    desc.label = frame.name.empty() ? layout.addString("subpatch") : addAtom(frame.name, layout);
+    desc.source = layout.addString(source);
+    if(graphOnParent.enabled) desc.flags |= PdWidgetDesc::GOP_ENABLED;
+    if(graphOnParent.hideName) desc.flags |= PdWidgetDesc::GOP_HIDE_NAME;
+    desc.gopX = graphOnParent.window.x;
+    desc.gopY = graphOnParent.window.y;
+    desc.gopWidth = graphOnParent.window.width;
+    desc.gopHeight = graphOnParent.window.height;
+    layout.addWidget(desc);
+    
+    // Sans graph-on-parent, le contenu n'est créé qu'à l'ouverture
+    if(!graphOnParent.enabled) return;
+    
+    // Graph-on-parent : exposer dans le parent les objets entièrement dans la fenêtre,
+    // position parent = restore + (objet - marge)
+    PdPatchParser childParser;
+    PdPatchLayout children;
+    childParser.parseSubpatchLayout(source, patchFontSize, children);
+    numRecords += childParser.getNumRecords();
+    
+    for(size_t i = 0; i < children.getNumWidgets(); i++) {
+        PdWidgetDesc child = children.getWidgets()[i];
+        if(!graphOnParent.exposes(ofRectangle(child.x, child.y, child.width, child.height))) continue;
+        
+        child.x = desc.x + child.x - graphOnParent.window.x;
+        child.y = desc.y + child.y - graphOnParent.window.y;
+        layout.append(child, children);
     }
+}
+
+void PdPatchParser::addArray(const CanvasFrame& frame, const char* bodyEnd, const PdAtoms& restore,
+                             PdPatchLayout& layout) {
+    // Le nom du tableau sert de symbole receive (PdMessageRouter::pushSamples)
+    PdWidgetDesc desc;
+    desc.type = (uint8_t)GuiType::ARRAY;
+    desc.x = toFloat(restore[2]);
+    desc.y = toFloat(restore[3]);
+    desc.width = frame.graphOnParent.window.width;
+    desc.height = frame.graphOnParent.window.height;
+    desc.receiveSymbol = addAtom(frame.arrayName, layout);
+    desc.precision = frame.arraySize;
+    desc.minValue = frame.valueBottom;
+    desc.maxValue = frame.valueTop;
+    
+    // Style de tracé (flags >> 1) : 0 = points, 1 = polygone, 2 = bézier (tracé en polygone)
+    if(((frame.arrayFlags >> 1) & 3) == 0) desc.flags |= PdWidgetDesc::ARRAY_POINTS;
+    
+    // Texte du graphe, pour les valeurs enregistrées (#A)
+    desc.source = layout.addString(string_view(frame.bodyStart, bodyEnd - frame.bodyStart));
+    layout.addWidget(desc);
+}
+
+void PdPatchParser::parseArrayValues(string_view source, vector<float>& values) {
+    PdPatchTokenizer tokenizer(source.data(), source.size());
+    PdAtoms atoms;
     
-    // Symboles send/receive (peuvent être "-" pour indiquer vide)
-    string sendSym = "";
-    string receiveSym = "";
-    
-    if(tokens.size() > 9 && tokens[9] != "-") {
-        sendSym = tokens[9];
+    while(tokenizer.next(atoms)) {
+        // Format: #A start v1 v2 ...;
+        if(atoms.size() < 3 || atoms[0] != "#A") continue;
+        
+        size_t start = (size_t)max(0, toInt(atoms[1]));
+        size_t count = atoms.size() - 2;
+        if(values.size() < start + count) values.resize(start + count, 0.0f);
+        
+        for(size_t i = 0; i < count; i++) {
+            values[start + i] = toFloat(atoms[i + 2]);
+        }
     }
+}
+
+void PdPatchParser::parseRecord(const PdAtoms& tokens, size_t line, PdPatchLayout& layout) {
+    if(tokens.size() < 4 || tokens[0] != "#X") return;
     
-    if(tokens.size() > 10 && tokens[10] != "-") {
-        receiveSym = tokens[10];
-    }
+    // Format: #X obj x y class params... ou #X floatatom x y params...
+    bool isObject = tokens[1] == "obj";
+    if(isObject && tokens.size() < 5) return;
     
-    // Si pas de symboles, on peut quand même créer l'objet pour l'affichage
-    // mais on utilise des symboles génériques
-    if(sendSym.empty() && receiveSym.empty()) {
-        sendSym = "floatatom-" + ofToString(pos.x) + "-" + ofToString(pos.y);
-        receiveSym = sendSym;
-    }
+    const PdWidgetClass* widgetClass = PdWidgetClasses::find(isObject ? tokens[4] : tokens[1]);
+    if(!widgetClass || widgetClass->isObject != isObject) return;
     
-    // Valeur initiale (souvent dans le dernier token)
-    float initialValue = 0.0f;
-    if(tokens.size() > 11) {
-        string lastToken = tokens[tokens.size() - 1];
-        // Enlever le point-virgule final si présent
-        if(lastToken.back() == ';') {
-            lastToken.pop_back();
-        }
-        initialValue = ofToFloat(lastToken);
-        initialValue = ofClamp(initialValue, minVal, maxVal);
-    }
+    PdWidgetDesc desc;
+    bool parsed = false;
     
-    // Déterminer la précision basée sur la valeur initiale ou utiliser 2 par défaut
-    int precision = 2;
-    if(initialValue == floor(initialValue)) {
-        precision = 0; // Nombre entier
+    try {
+        parsed = parseWidget(*widgetClass, tokens, desc, layout);
+    } catch(exception& e) {
+        ofLogError("PdPatchParser") << "Error parsing record at line " << line << ": " << e.what();
+        parsed = false;
     }
     
-    return make_unique<PdNumberBox>(
-        pos,
-        size,
-        sendSym,
-        receiveSym,
-        minVal,
-        maxVal,
-        initialValue,
-        precision
-    );
+    if(parsed) {
+        layout.addWidget(desc);
+    }
 }
 
-unique_ptr<PdGuiObject> PdPatchParser::parseCanvas(const vector<string>& tokens, ofVec2f pos) {
-    // Format: #X obj x y cnv size width height send receive label x_off y_off font font_size bg_color fg_color label_color
-    // Exemple: #X obj 167 111 cnv 19 126 76 empty empty empty 20 12 0 12 #ff0400 #ffffff 0;
-    if(tokens.size() < 7) return nullptr;
-    
-    // Taille du canvas
-    float width = ofToFloat(tokens[6]);
-    float height = ofToFloat(tokens[7]);
-    ofVec2f size(width, height);
-    
-    // Label (peut être "empty")
-    string label = "";
-    if(tokens.size() > 10 && tokens[10] != "empty") {
-        label = tokens[10];
+bool PdPatchParser::parseWidget(const PdWidgetClass& widgetClass, const PdAtoms& tokens, PdWidgetDesc& desc,
+                                PdPatchLayout& layout) {
+    if(tokens.size() < widgetClass.minTokens) return false;
+    
+    desc.type = (uint8_t)widgetClass.type;
+    desc.x = toFloat(tokens[2]);
+    desc.y = toFloat(tokens[3]);
+    desc.width = widgetClass.width;
+    desc.height = widgetClass.height;
+    desc.backgroundColor = widgetClass.backgroundColor;
+    desc.foregroundColor = widgetClass.foregroundColor;
+    if(widgetClass.patchFont) desc.fontSize = (uint16_t)patchFontSize;
+    
+    // Champs dans l'ordre de la table : min et max avant la position du curseur
+    for(uint8_t i = 0; i < widgetClass.numFields; i++) {
+        const PdFieldSpec& spec = widgetClass.fields[i];
+        if(spec.index < tokens.size()) {
+            parseField(spec, tokens, desc, layout);
+        } else if(spec.field == PdField::SLIDER_VALUE) {
+            desc.initValue = desc.minValue;
+        }
     }
     
-    // Couleurs par défaut
-    ofColor backgroundColor(224, 224, 224); // Gris clair par défaut
-    ofColor textColor(0, 0, 0);             // Noir par défaut pour le texte
-    
-    // CORRECTION: Parser la couleur de fond (bg_color) - tokens[15]
-    if(tokens.size() > 15) {
-        string bgColorStr = tokens[15];
-        if(bgColorStr.length() > 1 && bgColorStr[0] == '#') {
-            backgroundColor = parseHexColor(bgColorStr);
-        }
+    // Si min == max == 0, utiliser une plage par défaut
+    if(widgetClass.defaultRange && desc.minValue == 0 && desc.maxValue == 0) {
+        desc.minValue = -1000000.0f;
+        desc.maxValue = 1000000.0f;
     }
     
-    // CORRECTION: Parser la couleur de texte (fg_color) - tokens[16]
-    if(tokens.size() > 16) {
-        string textColorStr = tokens[16];
-        if(textColorStr.length() > 1 && textColorStr[0] == '#') {
-            textColor = parseHexColor(textColorStr);
+    bool hasSend = desc.sendSymbol.length > 0;
+    bool hasReceive = desc.receiveSymbol.length > 0;
+    switch(widgetClass.symbols) {
+        case PdSymbolRule::NONE:
+            return true;
+        case PdSymbolRule::SEND_OR_RECEIVE:
+            return hasSend || hasReceive;
+        case PdSymbolRule::RECEIVE:
+            return hasReceive;
+        case PdSymbolRule::GENERATED:
+            // Sans symboles, l'objet reste affiché avec un symbole générique
+            if(!hasSend && !hasReceive) {
+                char name[64];
+                snprintf(name, sizeof(name), "%.*s-%g-%g", (int)widgetClass.name.size(), widgetClass.name.data(),
+                         desc.x, desc.y);
+                desc.sendSymbol = layout.addString(name);
+                desc.receiveSymbol = desc.sendSymbol;
+            }
+            return true;
+    }
+    return false;
+}
+
+void PdPatchParser::parseField(const PdFieldSpec& spec, const PdAtoms& tokens, PdWidgetDesc& desc,
+                               PdPatchLayout& layout) {
+    string_view atom = tokens[spec.index];
+    
+    switch(spec.field) {
+        case PdField::WIDTH:
+            desc.width = toFloat(atom);
+            break;
+        case PdField::HEIGHT:
+            desc.height = toFloat(atom);
+            break;
+        case PdField::SIZE:
+            desc.width = desc.height = toFloat(atom); // Carré
+            break;
+        case PdField::CHAR_WIDTH:
+            desc.width = toFloat(atom) * 8; // Largeur en caractères * largeur approximative d'un caractère
+            break;
+        case PdField::MIN_VALUE:
+            desc.minValue = toFloat(atom);
+            break;
+        case PdField::MAX_VALUE:
+            desc.maxValue = toFloat(atom);
+            break;
+        case PdField::SLIDER_VALUE: {
+            // Position en 1/100 de pixel sur la longueur du curseur, gardée
+            // seulement si l'init est actif (sinon le curseur part du min)
+            desc.initValue = desc.minValue;
+            float length = (desc.type == (uint8_t)GuiType::HORIZONTAL_SLIDER ? desc.width : desc.height) - 1;
+            if(toInt(tokens[spec.aux]) == 0 || length <= 0) break;
+            
+            float position = ofClamp(toFloat(atom) / (100.0f * length), 0.0f, 1.0f);
+            desc.initValue = desc.minValue + (desc.maxValue - desc.minValue) * position;
+            break;
         }
+        case PdField::SEND:
+            desc.sendSymbol = addSymbol(atom, layout);
+            break;
+        case PdField::RECEIVE:
+            desc.receiveSymbol = addSymbol(atom, layout);
+            break;
+        case PdField::LABEL:
+            // Label (peut être "empty")
+            if(atom != "empty") desc.label = addAtom(atom, layout);
+            break;
+        case PdField::FONT_SIZE:
+            desc.fontSize = (uint16_t)max(1, toInt(atom));
+            break;
+        case PdField::BACKGROUND:
+            if(atom.length() > 1 && atom[0] == '#') desc.backgroundColor = PdPatchLayout::packColor(parseHexColor(atom));
+            break;
+        case PdField::FOREGROUND:
+            if(atom.length() > 1 && atom[0] == '#') desc.foregroundColor = PdPatchLayout::packColor(parseHexColor(atom));
+            break;
+        case PdField::VU_SCALE:
+            if(toInt(atom) != 0) desc.flags |= PdWidgetDesc::VU_SCALE;
+            break;
     }
+}
+
+float PdPatchParser::toFloat(string_view atom) {
+    // Même comportement que ofToFloat : 0 si l'atome n'est pas un nombre
+    float value = 0.0f;
+    return PdNumberFormat::parseFloat(atom, value) ? value : 0.0f;
+}
+
+int PdPatchParser::toInt(string_view atom) {
+    int value = 0;
+    return PdNumberFormat::parseInt(atom, value) ? value : 0;
+}
+
+PdStringRef PdPatchParser::addSymbol(string_view atom, PdPatchLayout& layout) {
+    // "empty" et "-" : symbole vide
+    if(PdSymbolTable::isEmptyName(atom)) return PdStringRef();
+    return addAtom(atom, layout);
+}
+
+PdStringRef PdPatchParser::addAtom(string_view atom, PdPatchLayout& layout) {
+    if(!PdPatchTokenizer::isEscaped(atom)) return layout.addString(atom);
     
-    return make_unique<PdCanvas>(pos, size, label, backgroundColor, textColor);
+    PdPatchTokenizer::unescape(atom, scratch);
+    return layout.addString(scratch);
 }
 
 // Méthode utilitaire pour parser les couleurs hexadécimales
-ofColor PdPatchParser::parseHexColor(const string& hexStr) {
+ofColor PdPatchParser::parseHexColor(string_view hexStr) {
     if(hexStr.length() < 7 || hexStr[0] != '#') {
         ofLogWarning("PdCanvas") << "Invalid hex color format: " << hexStr;
         return ofColor(128, 128, 128); // Gris par défaut
     }
     
-    try {
-        // Enlever le #
-        string hex = hexStr.substr(1);
-        
-        // S'assurer qu'on a exactement 6 caractères
-        if(hex.length() != 6) {
-            ofLogWarning("PdCanvas") << "Hex color should be 6 characters: " << hexStr;
-            return ofColor(128, 128, 128);
-        }
-        
-        // Convertir en valeurs RGB
-        int r = stoi(hex.substr(0, 2), nullptr, 16);
-        int g = stoi(hex.substr(2, 2), nullptr, 16);
-        int b = stoi(hex.substr(4, 2), nullptr, 16);
-        
-        ofLogNotice("PdCanvas") << "Parsed color " << hexStr
-                               << " -> R:" << r << " G:" << g << " B:" << b;
-        
-        return ofColor(r, g, b);
-    } catch(exception& e) {
-        ofLogError("PdPatchParser") << "Error parsing hex color: " << hexStr << " - " << e.what();
+    // S'assurer qu'on a exactement 6 caractères après le #
+    if(hexStr.length() != 7) {
+        ofLogWarning("PdCanvas") << "Hex color should be 6 characters: " << hexStr;
         return ofColor(128, 128, 128);
     }
-}
-
-vector<string> PdPatchParser::splitString(const string& str, char delimiter) {
-    vector<string> tokens;
-    stringstream ss(str);
-    string token;
-    
-    while(getline(ss, token, delimiter)) {
-        if(!token.empty()) {
-            tokens.push_back(token);
-        }
+    
+    // Convertir en valeurs RGB
+    unsigned int rgb = 0;
+    from_chars_result result = from_chars(hexStr.data() + 1, hexStr.data() + hexStr.size(), rgb, 16);
+    if(result.ec != errc() || result.ptr != hexStr.data() + hexStr.size()) {
+        ofLogError("PdPatchParser") << "Error parsing hex color: " << hexStr;
+        return ofColor(128, 128, 128);
     }
     
-    return tokens;
+    return ofColor((rgb >> 16) & 0xff, (rgb >> 8) & 0xff, rgb & 0xff);
 }
@@ -14,29 +14,95 @@
 #include "Slider.h"
 #include "NumberBox.h"
 #include "Canvas.h"
+#include "Subpatch.h"
+#include "VuMeter.h"
+#include "Array.h"
+#include "PatchLayout.h"
+#include "SpatialGrid.h"
+#include "PatchTokenizer.h"
+#include "NumberFormat.h"
+#include "WidgetClasses.h"
 #include <vector>
 #include <string>
+#include <string_view>
 #include <memory>
-#include <fstream>
-#include <sstream>
+#include <atomic>
+
+// Atomes d'un enregistrement, pointant dans le tampon du fichier
+typedef std::vector<std::string_view> PdAtoms;
 
 class PdPatchParser {
 public:
     // Méthode principale pour parser un fichier patch
-    std::vector<std::unique_ptr<PdGuiObject>> parseFile(const std::string& filename);
+    PdObjectList parseFile(const std::string& filename);
+    
+    // Idem, en construisant l'index spatial des objets pour le hit-testing
+    PdObjectList parseFile(const std::string& filename, PdSpatialGrid& spatialIndex);
+    
+    // Parser un patch déjà en mémoire (le tampon n'est lu qu'une fois)
+    PdObjectList parseBuffer(const char* data, size_t size);
+    
+    // Contenu d'un sous-patch, instancié à son ouverture
+    PdObjectList parseSubpatch(const PdSubpatch& subpatch);
+    
+    // Descriptions à plat, sans créer les objets (cache binaire)
+    void parseLayout(const char* data, size_t size, PdPatchLayout& layout);
+    void parseSubpatchLayout(std::string_view source, int fontSize, PdPatchLayout& layout);
+    
+    // Valeurs enregistrées d'un tableau ("#A début v1 v2 ...;" du graphe)
+    static void parseArrayValues(std::string_view source, std::vector<float>& values);
+    
+    // Interruption depuis un autre thread (chargement annulé) ; vérifié
+    // tous les CANCEL_CHECK_INTERVAL enregistrements
+    void setCancelFlag(const std::atomic<bool>* flag) { cancelFlag = flag; }
+    bool wasCancelled() const { return cancelled; }
+    
+    // Statistiques du dernier parsing
+    size_t getNumLines() const { return numLines; }
+    size_t getNumRecords() const { return numRecords; }
     
 private:
+    // Sous-patch en cours de lecture (pile des canvas)
+    struct CanvasFrame {
+        const char* bodyStart = nullptr;
+        std::string_view name;
+        PdGraphOnParent graphOnParent;
+        
+        // Premier tableau d'un graphe ("#X array name size float flags")
+        std::string_view arrayName;
+        int arraySize = 0;
+        int arrayFlags = 0;
+        float valueTop = 1.0f;    // "#X coords x1 y1 x2 y2" : y1 en haut, y2 en bas
+        float valueBottom = -1.0f;
+    };
+    
     // Méthodes privées pour le parsing
-    std::unique_ptr<PdGuiObject> parseLine(const std::string& line);
-    std::unique_ptr<PdGuiObject> parseHorizontalSlider(const std::vector<std::string>& tokens, ofVec2f pos);
-    std::unique_ptr<PdGuiObject> parseVerticalSlider(const std::vector<std::string>& tokens, ofVec2f pos);
-    std::unique_ptr<PdGuiObject> parseToggle(const std::vector<std::string>& tokens, ofVec2f pos);
-    std::unique_ptr<PdGuiObject> parseBang(const std::vector<std::string>& tokens, ofVec2f pos);
-    std::unique_ptr<PdGuiObject> parseCanvas(const vector<string>& tokens, ofVec2f pos);
-    std::unique_ptr<PdGuiObject> parseNumberBox(const std::vector<std::string>& tokens, ofVec2f pos);
-    
-    // Utilitaire pour diviser une chaîne
-    std::vector<std::string> splitString(const std::string& str, char delimiter);
-    
-    ofColor parseHexColor(const string& hexStr);
+    void parseRecords(const char* data, size_t size, bool hasRootCanvas, PdPatchLayout& layout);
+    void parseCoords(const PdAtoms& tokens, CanvasFrame& frame);
+    void addSubpatch(const CanvasFrame& frame, const char* bodyEnd, const PdAtoms& restore, PdPatchLayout& layout);
+    void addArray(const CanvasFrame& frame, const char* bodyEnd, const PdAtoms& restore, PdPatchLayout& layout);
+    void parseRecord(const PdAtoms& tokens, size_t line, PdPatchLayout& layout);
+    // Objets GUI décrits par la table PD_WIDGET_CLASSES
+    bool parseWidget(const PdWidgetClass& widgetClass, const PdAtoms& tokens, PdWidgetDesc& desc, PdPatchLayout& layout);
+    void parseField(const PdFieldSpec& spec, const PdAtoms& tokens, PdWidgetDesc& desc, PdPatchLayout& layout);
+    
+    // Conversion des atomes
+    static float toFloat(std::string_view atom);
+    static int toInt(std::string_view atom);
+    PdStringRef addSymbol(std::string_view atom, PdPatchLayout& layout);
+    PdStringRef addAtom(std::string_view atom, PdPatchLayout& layout);
+    
+    ofColor parseHexColor(std::string_view hexStr);
+    
+    // Taille de police du patch (#N canvas x y w h font)
+    int patchFontSize = 12;
+    bool patchFontParsed = false;
+    
+    size_t numLines = 0;
+    size_t numRecords = 0;
+    
+    static constexpr size_t CANCEL_CHECK_INTERVAL = 1024;
+    const std::atomic<bool>* cancelFlag = nullptr;
+    bool cancelled = false;
+    std::string scratch; // Atome désechappé réutilisé
 };
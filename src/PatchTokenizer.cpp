@@ -0,0 +1,90 @@
+//
+//  PatchTokenizer.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 20/07/2025.
+//
+
+#include "PatchTokenizer.h"
+
+PdPatchTokenizer::PdPatchTokenizer(const char* data, size_t size)
+    : current(data)
+    , end(data + size)
+    , recordStart(data)
+    , line(1)
+    , recordLine(1)
+{
+}
+
+static inline bool isSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+bool PdPatchTokenizer::next(std::vector<std::string_view>& atoms) {
+    atoms.clear();
+    bool started = false;
+    
+    while (current < end) {
+        char c = *current;
+        
+        if (isSpace(c)) {
+            if (c == '\n') line++;
+            current++;
+            continue;
+        }
+        
+        if (!started) {
+            recordLine = line;
+            recordStart = current;
+            started = true;
+        }
+        
+        if (c == ';') {
+            current++;
+            if (atoms.empty()) {
+                // Enregistrement vide (";;") : passer au suivant
+                started = false;
+                continue;
+            }
+            return true;
+        }
+        
+        if (c == ',') {
+            atoms.emplace_back(current, 1);
+            current++;
+            continue;
+        }
+        
+        // Atome : jusqu'au prochain séparateur non échappé
+        const char* atomStart = current;
+        while (current < end) {
+            c = *current;
+            if (c == '\\' && current + 1 < end) {
+                if (current[1] == '\n') line++;
+                current += 2;
+                continue;
+            }
+            if (isSpace(c) || c == ';' || c == ',') break;
+            current++;
+        }
+        atoms.emplace_back(atomStart, current - atomStart);
+    }
+    
+    // Dernier enregistrement sans ';' (fichier tronqué)
+    return !atoms.empty();
+}
+
+bool PdPatchTokenizer::isEscaped(std::string_view atom) {
+    return atom.find('\\') != std::string_view::npos;
+}
+
+void PdPatchTokenizer::unescape(std::string_view atom, std::string& out) {
+    out.clear();
+    out.reserve(atom.size());
+    for (size_t i = 0; i < atom.size(); i++) {
+        if (atom[i] == '\\' && i + 1 < atom.size()) {
+            i++;
+        }
+        out.push_back(atom[i]);
+    }
+}
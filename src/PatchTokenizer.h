@@ -0,0 +1,48 @@
+//
+//  PatchTokenizer.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 20/07/2025.
+//
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Lecture en un seul passage d'un fichier .pd.
+// Découpe le tampon en enregistrements terminés par un ';' non échappé,
+// quel que soit le nombre de lignes qu'ils occupent (Pd coupe les lignes
+// longues). Les atomes sont des string_view dans le tampon, sans copie :
+// le tampon doit rester valide pendant l'utilisation des atomes.
+class PdPatchTokenizer {
+public:
+    PdPatchTokenizer(const char* data, size_t size);
+    
+    // Remplit atoms avec l'enregistrement suivant (le ';' final est retiré,
+    // une ',' non échappée devient un atome à part). false en fin de fichier.
+    bool next(std::vector<std::string_view>& atoms);
+    
+    // Ligne (à partir de 1) où commence le dernier enregistrement lu
+    size_t getRecordLine() const { return recordLine; }
+    size_t getNumLines() const { return line; }
+    
+    // Début du dernier enregistrement lu et position juste après son ';'
+    // (permet de conserver le texte brut d'un sous-patch)
+    const char* getRecordStart() const { return recordStart; }
+    const char* getPosition() const { return current; }
+    
+    // Un atome contient-il des échappements (\; \, \$ "\ ") ?
+    static bool isEscaped(std::string_view atom);
+    
+    // Retire les '\' d'échappement d'un atome
+    static void unescape(std::string_view atom, std::string& out);
+    
+private:
+    const char* current;
+    const char* end;
+    const char* recordStart;
+    size_t line;
+    size_t recordLine;
+};
@@ -0,0 +1,671 @@
+//
+//  PatchView.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#include "PatchView.h"
+#include "PatchDiff.h"
+#include "WidgetStore.h"
+#include "Profiler.h"
+
+namespace {
+    // 0 est réservé aux objets sans vue (PdWidgetPoolBase::NO_OWNER)
+    uint16_t nextOwnerId = 1;
+}
+
+PdPatchView::PdPatchView(const PdPatchResources& resources)
+    : resources(resources)
+    , ownerId(nextOwnerId++) {
+    // Une région du canevas, repère et scissor déjà en place (PdTiledTarget)
+    drawRegion = [this](const ofRectangle& region) {
+        float density = tiles.getPixelDensity();
+        PdProfiler::get().addCount(PdProfileCounter::DIRTY_AREA,
+                                   (uint64_t)(region.width * region.height * density * density));
+        drawGuiObjectList(&region, DrawLayer::INTERACTIVE);
+    };
+    
+    // Canvas et labels : rendus une fois par tuile, recopiés sous les redessins
+    drawStaticRegion = [this](const ofRectangle& region) {
+        drawGuiObjectList(&region, DrawLayer::STATIC);
+    };
+    tiles.setStaticLayer([this](const ofRectangle& region) { return hasStaticObject(region); }, drawStaticRegion);
+    updateTitle();
+}
+
+PdPatchView::~PdPatchView() {
+    patchLoader.cancel();
+    patchWatcher.stop();
+    clearObjects();
+}
+
+void PdPatchView::setViewport(const ofRectangle& viewport) {
+    this->viewport = viewport;
+    
+    // Les tuiles déjà dessinées restent valides : seules les nouvelles tuiles
+    // visibles seront dessinées. Changement d'écran (densité) : tout réallouer.
+    displayScale = PdDisplayScale::query();
+    tiles.setPixelDensity(displayScale.pixelDensity);
+    clampScroll();
+    notifyActivity();
+}
+
+ofRectangle PdPatchView::getVisibleArea() const {
+    return ofRectangle(scrollOffset.x, scrollOffset.y,
+                       viewport.width / displayScale.contentScale, viewport.height / displayScale.contentScale);
+}
+
+void PdPatchView::scroll(float dx, float dy) {
+    scrollOffset.x += dx;
+    scrollOffset.y += dy;
+    clampScroll();
+    notifyActivity();
+}
+
+void PdPatchView::clampScroll() {
+    // Jusqu'au bord du contenu le plus éloigné, jamais avant l'origine
+    float maxX = 0, maxY = 0;
+    for (auto& obj : getVisibleObjects()) {
+        ofRectangle bounds = obj->getDrawBounds();
+        maxX = max(maxX, bounds.getMaxX());
+        maxY = max(maxY, bounds.getMaxY());
+    }
+    
+    ofRectangle area = getVisibleArea();
+    scrollOffset.x = ofClamp(scrollOffset.x, 0, max(0.0f, maxX - area.width));
+    scrollOffset.y = ofClamp(scrollOffset.y, 0, max(0.0f, maxY - area.height));
+}
+
+ofVec2f PdPatchView::toCanvas(float x, float y) const {
+    return ofVec2f((x - viewport.x) / displayScale.contentScale + scrollOffset.x,
+                   (y - viewport.y) / displayScale.contentScale + scrollOffset.y);
+}
+
+ofVec2f PdPatchView::toWindow(float x, float y) const {
+    return ofVec2f((x - scrollOffset.x) * displayScale.contentScale + viewport.x,
+                   (y - scrollOffset.y) * displayScale.contentScale + viewport.y);
+}
+
+void PdPatchView::notifyActivity() {
+    if (onActivity) onActivity(*this);
+}
+
+void PdPatchView::notifyRedrawn() {
+    notifyActivity();
+    if (onRedrawn) onRedrawn(*this);
+}
+
+bool PdPatchView::hasPendingWork() const {
+    return pendingSubpatch != nullptr || patchWatcher.hasPendingLayout() || patchLoader.isLoading();
+}
+
+//--------------------------------------------------------------
+// Patch
+
+void PdPatchView::load(const string& path) {
+    // Le patch courant est abandonné, même à moitié chargé
+    patchLoader.cancel();
+    patchWatcher.stop();
+    clearObjects();
+    
+    patchLoader.load(path);
+    updateTitle();
+    notifyRedrawn();
+}
+
+void PdPatchView::setObjects(PdObjectList objects) {
+    patchLoader.cancel();
+    patchWatcher.stop();
+    clearObjects();
+    
+    guiObjects = std::move(objects);
+    setupCallbacks(guiObjects);
+    spatialIndex.build(guiObjects);
+    updateTitle();
+}
+
+void PdPatchView::clearObjects() {
+    // Le routeur de messages est partagé : ne désabonner que nos objets
+    for (auto& obj : guiObjects) {
+        retireObject(*obj);
+    }
+    
+    eventRouter.reset();
+    spatialIndex.clear();
+    subpatchStack.clear();
+    pendingSubpatch = nullptr;
+    invalidatedRegions.clear();
+    guiObjects.clear();
+    patchLayout.reset();
+    layoutVersion++;
+    fboNeedsUpdate = true;
+}
+
+void PdPatchView::update() {
+    // Patch modifié sur disque : déjà parsé par le thread de surveillance
+    std::unique_ptr<PdPatchLayout> reloadedLayout;
+    if (patchWatcher.poll(reloadedLayout)) {
+        reloadPatch(std::move(reloadedLayout));
+    }
+    
+    // Chargement en cours : créer le lot d'objets suivant
+    if (patchLoader.isLoading()) {
+        updateLoading();
+    }
+    
+    // Ouvrir le sous-patch cliqué pendant la frame précédente
+    if (pendingSubpatch) {
+        PdSubpatch* subpatch = pendingSubpatch;
+        pendingSubpatch = nullptr;
+        openSubpatch(*subpatch);
+    }
+}
+
+void PdPatchView::updateObjects() {
+    for (auto& obj : getVisibleObjects()) {
+        if (!obj->isPooled()) {
+            obj->update();
+        }
+    }
+}
+
+void PdPatchView::updateLoading() {
+    size_t first = guiObjects.size();
+    patchLoader.instantiate(guiObjects, LOAD_BUDGET_MICROS);
+    
+    for (size_t i = first; i < guiObjects.size(); i++) {
+        PdGuiObject& obj = *guiObjects[i];
+        setupCallbacks(obj);
+        // Un sous-patch ouvert entre-temps : l'index sera reconstruit à sa fermeture
+        if (subpatchStack.empty()) {
+            spatialIndex.insert(&obj, (int)i);
+        }
+        obj.markForUpdate();
+    }
+    
+    if (patchLoader.isComplete()) {
+        // Disposition gardée pour comparer les rechargements à chaud
+        patchLayout = patchLoader.takeLayout();
+        layoutVersion++;
+        patchWatcher.start(patchLoader.getPath());
+        ofLogNotice("PdPatchView") << "Loaded " << patchLoader.getPath() << ": " << guiObjects.size() << " objects";
+    }
+    
+    // Rester actif jusqu'à la fin du chargement
+    notifyActivity();
+    updateTitle();
+}
+
+void PdPatchView::updateTitle() {
+    if (!subpatchStack.empty()) {
+        title = "pd " + subpatchStack.back()->getName() + " - Backspace to close";
+    } else if (patchLoader.isLoading()) {
+        title = "Loading " + patchLoader.getPath() + " ("
+              + ofToString((int)(patchLoader.getProgress() * 100)) + " %)";
+    } else if (!patchLoader.getPath().empty()) {
+        title = ofFilePath::getFileName(patchLoader.getPath()) + " - Click on toggles";
+    } else {
+        title = "Pure Data Toggle Test - Click on toggles";
+    }
+}
+
+void PdPatchView::setupCallbacks(PdObjectList& objects) {
+    for (auto& obj : objects) {
+        setupCallbacks(*obj);
+    }
+}
+
+void PdPatchView::setupCallbacks(PdGuiObject& obj) {
+    // Régions sales collectées par cette vue seulement
+    PdWidgetStore::get().setOwner(obj, ownerId);
+    
+    // Abonner l'objet à son symbole receive
+    resources.messageRouter.registerReceiver(&obj);
+    
+    // Envoi des floats vers Pure Data par la file sortante
+    obj.setSendQueue(&resources.sendQueue);
+    
+    // Callback pour l'envoi de strings vers Pure Data
+    obj.onSendToPdString = [](const string& symbol, const string& message) {
+        ofLogNotice("PD Send String") << symbol << " = " << message;
+        // Ici on appellerait ofxPd::sendSymbol(symbol, message);
+    };
+    
+    // Garder l'index spatial à jour quand un objet bouge ou change de taille
+    obj.onBoundsChanged = [this](PdGuiObject& object) {
+        spatialIndex.update(&object);
+    };
+    
+    // Ouvrir les sous-patchs au clic ; leur contenu déjà instancié est abonné aussi
+    if (obj.getType() == GuiType::SUBPATCH) {
+        PdSubpatch& subpatch = static_cast<PdSubpatch&>(obj);
+        subpatch.onOpen = [this](PdSubpatch& opened) {
+            // Appelé pendant le routage du clic : changer de canvas à la frame suivante
+            pendingSubpatch = &opened;
+        };
+        if (subpatch.isInstantiated()) {
+            setupCallbacks(subpatch.getObjects());
+        }
+    }
+}
+
+void PdPatchView::reloadPatch(std::unique_ptr<PdPatchLayout> layout) {
+    // Sans disposition de référence (objets créés à la main), tout est recréé
+    PdPatchLayout empty;
+    bool comparable = patchLayout && patchLayout->getNumWidgets() == guiObjects.size();
+    
+    PdPatchDiff diff;
+    diff.compute(comparable ? *patchLayout : empty, *layout);
+    
+    PdObjectList next;
+    next.reserve(layout->getNumWidgets());
+    PdObjectList retired;
+    const PdWidgetDesc* widgets = layout->getWidgets();
+    int lastOldIndex = -1;
+    
+    for (size_t j = 0; j < diff.getEntries().size(); j++) {
+        const PdPatchDiff::Entry& entry = diff.getEntries()[j];
+        PdGuiObjectPtr obj;
+        
+        switch (entry.action) {
+            case PdPatchDiff::Action::KEEP:
+            case PdPatchDiff::Action::MUTATE:
+                obj = move(guiObjects[entry.oldIndex]);
+                if (entry.action == PdPatchDiff::Action::MUTATE) {
+                    PdPatchDiff::mutate(*obj, widgets[j]);
+                }
+                // Ordre z changé : l'objet passe devant ou derrière ses voisins
+                if (entry.oldIndex < lastOldIndex) {
+                    obj->markForUpdate();
+                }
+                lastOldIndex = max(lastOldIndex, entry.oldIndex);
+                break;
+            
+            case PdPatchDiff::Action::REPLACE:
+                obj = layout->createWidget(widgets[j]);
+                if (obj) {
+                    obj->setValue(guiObjects[entry.oldIndex]->getValue());
+                    setupCallbacks(*obj);
+                }
+                retired.push_back(move(guiObjects[entry.oldIndex]));
+                break;
+            
+            case PdPatchDiff::Action::CREATE:
+                obj = layout->createWidget(widgets[j]);
+                if (obj) {
+                    setupCallbacks(*obj);
+                }
+                break;
+        }
+        
+        if (obj) {
+            next.push_back(move(obj));
+        }
+    }
+    
+    for (auto& obj : guiObjects) {
+        // Objets sans partenaire (ou tous, sans disposition de référence)
+        if (obj) retired.push_back(move(obj));
+    }
+    
+    bool wasInSubpatch = !subpatchStack.empty();
+    for (auto& obj : retired) {
+        retireObject(*obj);
+    }
+    
+    guiObjects = move(next);
+    patchLayout = move(layout);
+    layoutVersion++;
+    
+    // L'index spatial ne doit plus pointer vers les objets détruits
+    if (wasInSubpatch && subpatchStack.empty()) {
+        showVisibleObjects();
+    } else if (subpatchStack.empty()) {
+        spatialIndex.build(guiObjects);
+    }
+    notifyActivity();
+    
+    ofLogNotice("PdPatchView") << "Reloaded " << patchWatcher.getPath() << ": "
+                               << diff.count(PdPatchDiff::Action::KEEP) << " kept, "
+                               << diff.count(PdPatchDiff::Action::MUTATE) << " changed, "
+                               << diff.count(PdPatchDiff::Action::REPLACE) << " replaced, "
+                               << diff.count(PdPatchDiff::Action::CREATE) << " created, "
+                               << retired.size() - diff.count(PdPatchDiff::Action::REPLACE) << " removed";
+    
+    // Les objets retirés sont détruits ici, après la mise à jour des index
+}
+
+void PdPatchView::retireObject(PdGuiObject& obj) {
+    // Sa zone doit être effacée du FBO
+    invalidatedRegions.push_back(obj.getDrawBounds());
+    resources.messageRouter.unregisterReceiver(&obj);
+    eventRouter.forget(&obj);
+    
+    if (obj.getType() == GuiType::SUBPATCH) {
+        PdSubpatch& subpatch = static_cast<PdSubpatch&>(obj);
+        if (pendingSubpatch == &subpatch) {
+            pendingSubpatch = nullptr;
+        }
+        if (!subpatchStack.empty() && subpatchStack.front() == &subpatch) {
+            // Le sous-patch affiché disparaît : reloadPatch revient au patch principal
+            subpatchStack.clear();
+        }
+        if (subpatch.isInstantiated()) {
+            for (auto& child : subpatch.getObjects()) {
+                retireObject(*child);
+            }
+        }
+    }
+}
+
+//--------------------------------------------------------------
+// Canvas affiché
+
+PdObjectList& PdPatchView::getVisibleObjects() {
+    return subpatchStack.empty() ? guiObjects : subpatchStack.back()->getObjects();
+}
+
+void PdPatchView::openSubpatch(PdSubpatch& subpatch) {
+    // Création paresseuse : le contenu n'existe qu'à partir de la première ouverture
+    if (!subpatch.isInstantiated()) {
+        setupCallbacks(subpatch.instantiate());
+        ofLogNotice("PdPatchView") << "Instantiated subpatch " << subpatch.getName()
+                                   << " (" << subpatch.getObjects().size() << " objects)";
+    }
+    
+    subpatchStack.push_back(&subpatch);
+    showVisibleObjects();
+}
+
+void PdPatchView::closeSubpatch() {
+    if (subpatchStack.empty()) return;
+    
+    subpatchStack.pop_back();
+    showVisibleObjects();
+}
+
+void PdPatchView::showVisibleObjects() {
+    // Le pointeur capturé peut appartenir au canvas qu'on quitte
+    eventRouter.reset();
+    spatialIndex.build(getVisibleObjects());
+    updateTitle();
+    
+    scrollOffset = ofVec2f();
+    fboNeedsUpdate = true;
+    notifyActivity();
+}
+
+//--------------------------------------------------------------
+// Événements pointeur
+
+bool PdPatchView::pointerPressed(int pointerId, float x, float y, int button) {
+    notifyActivity();
+    ofVec2f point = toCanvas(x, y);
+    return eventRouter.pointerPressed(pointerId, point.x, point.y, button);
+}
+
+bool PdPatchView::pointerDragged(int pointerId, float x, float y, int button) {
+    notifyActivity();
+    ofVec2f point = toCanvas(x, y);
+    return eventRouter.pointerDragged(pointerId, point.x, point.y, button);
+}
+
+bool PdPatchView::pointerReleased(int pointerId, float x, float y, int button) {
+    notifyActivity();
+    ofVec2f point = toCanvas(x, y);
+    return eventRouter.pointerReleased(pointerId, point.x, point.y, button);
+}
+
+void PdPatchView::pointerCancelled(int pointerId) {
+    notifyActivity();
+    eventRouter.pointerCancelled(pointerId);
+}
+
+void PdPatchView::pointerMoved(float x, float y) {
+    notifyActivity();
+    // Hors de la zone : les objets qui débordent ne sont pas visibles
+    if (contains(x, y)) {
+        ofVec2f point = toCanvas(x, y);
+        eventRouter.pointerMoved(point.x, point.y);
+    } else {
+        eventRouter.pointerExited();
+    }
+}
+
+//--------------------------------------------------------------
+// Rendu
+
+void PdPatchView::setFboRenderer(bool enabled) {
+    useFboRenderer = enabled;
+    fboNeedsUpdate = true;
+}
+
+void PdPatchView::setBatchRenderer(bool enabled) {
+    useBatchRenderer = enabled;
+    fboNeedsUpdate = true;
+}
+
+void PdPatchView::draw() {
+    // Méthode 1: Rendu retenu dans les tuiles, seules les régions sales sont redessinées
+    if (useFboRenderer) {
+        PdProfileScope scope(PdProfileSection::RENDER_FBO);
+        drawToFboMerged();
+        return;
+    }
+    
+    // Méthode 2: Dessin direct des objets visibles (pour comparaison)
+    PdProfileScope scope(PdProfileSection::RENDER_DIRECT);
+    PdProfiler::get().addCount(PdProfileCounter::DIRTY_AREA, (uint64_t)(viewport.width * viewport.height));
+    drawDirect();
+}
+
+void PdPatchView::pushViewport() {
+    // Une zone de la fenêtre par vue : ce qui déborde est coupé
+    ofPushView();
+    ofViewport(viewport);
+    ofSetupScreen();
+}
+
+void PdPatchView::drawDirect() {
+    pushViewport();
+    ofScale(displayScale.contentScale, displayScale.contentScale);
+    ofTranslate(-scrollOffset.x, -scrollOffset.y);
+    
+    ofRectangle area = getVisibleArea();
+    drawGuiObjectList(&area);
+    ofPopView();
+}
+
+void PdPatchView::drawGuiObject(PdGuiObject& obj) {
+    // draw() compté comme un seul appel de dessin (borne basse)
+    PdProfiler::get().addCount(PdProfileCounter::DRAW_CALLS, 1);
+    ofPushMatrix();
+    ofTranslate(obj.getPosition().x, obj.getPosition().y);
+    obj.draw();
+    ofPopMatrix();
+}
+
+bool PdPatchView::hasStaticObject(const ofRectangle& region) {
+    // Appelé au rendu complet d'une tuile et par redrawStatic, pour une tuile
+    // qui n'avait pas encore de couche statique
+    for (auto& obj : getVisibleObjects()) {
+        if (obj->isVisible() && obj->isStatic() && obj->getDrawBounds().intersects(region)) return true;
+    }
+    return false;
+}
+
+void PdPatchView::drawGuiObjectList(const ofRectangle* region, DrawLayer layer) {
+    // Dessine dans l'ordre z les objets visibles, ou seulement ceux qui touchent
+    // la région, d'une seule couche ou des deux
+    PdProfiler& profiler = PdProfiler::get();
+    
+    if (!useBatchRenderer) {
+        for (auto& obj : getVisibleObjects()) {
+            if (layer != DrawLayer::ALL && obj->isStatic() != (layer == DrawLayer::STATIC)) continue;
+            if (obj->isVisible() && (!region || obj->getDrawBounds().intersects(*region))) {
+                profiler.addCount(PdProfileCounter::OBJECTS_REDRAWN, 1);
+                drawGuiObject(*obj);
+            }
+        }
+        return;
+    }
+    
+    PdPrimitiveBatch& primitiveBatch = resources.primitiveBatch;
+    primitiveBatch.begin();
+    
+    for (auto& obj : getVisibleObjects()) {
+        if (!obj->isVisible()) continue;
+        if (region && !obj->getDrawBounds().intersects(*region)) continue;
+        if (layer != DrawLayer::ALL && obj->isStatic() != (layer == DrawLayer::STATIC)) continue;
+        
+        profiler.addCount(PdProfileCounter::OBJECTS_REDRAWN, 1);
+        primitiveBatch.setOrigin(obj->getPosition());
+        if (!obj->drawBatched(primitiveBatch)) {
+            // Objet personnalisé : vider le tampon d'abord pour garder l'ordre z
+            primitiveBatch.draw();
+            drawGuiObject(*obj);
+        }
+    }
+    
+    primitiveBatch.draw();
+}
+
+void PdPatchView::prepareTiles() {
+    if (fboNeedsUpdate) {
+        // Tout redessiner : les régions sales en attente n'ont plus d'objet
+        invalidatedRegions.clear();
+        tiles.invalidate();
+        for (auto& obj : getVisibleObjects()) {
+            obj->clearUpdateFlag();
+        }
+        fboNeedsUpdate = false;
+        notifyRedrawn();
+    }
+    
+    // Tuiles devenues visibles (défilement, agrandissement) ou invalidées
+    tiles.update(getVisibleArea(), drawRegion);
+}
+
+void PdPatchView::drawTiles() {
+    pushViewport();
+    float scale = displayScale.contentScale;
+    tiles.draw(ofVec2f(-scrollOffset.x * scale, -scrollOffset.y * scale), scale);
+    ofPopView();
+}
+
+void PdPatchView::drawToFbo() {
+    // Version simple : chaque objet sale est effacé puis redessiné seul,
+    // sans tenir compte des objets qui le chevauchent
+    if (!invalidatedRegions.empty()) {
+        // Pas de région hors objet dans cette version : tout redessiner
+        invalidatedRegions.clear();
+        fboNeedsUpdate = true;
+    }
+    prepareTiles();
+    
+    for (auto& obj : getVisibleObjects()) {
+        if (!obj->needsUpdate()) continue;
+        notifyRedrawn();
+        
+        PdGuiObject& object = *obj;
+        if (object.isStatic()) {
+            tiles.redrawStatic({ object.getUpdateRegion() });
+        }
+        tiles.redraw(object.getUpdateRegion(), [&object, this](const ofRectangle&) {
+            if (object.isVisible() && !object.isStatic()) {
+                PdProfiler::get().addCount(PdProfileCounter::OBJECTS_REDRAWN, 1);
+                drawGuiObject(object);
+            }
+        });
+        
+        object.clearUpdateFlag();
+    }
+    
+    // Dessiner les tuiles
+    drawTiles();
+}
+
+void PdPatchView::drawToFboWithScissor() {
+    // Une région par objet sale, sans fusion
+    prepareTiles();
+    collectDirtyRegions();
+    if (!dirtyRegions.empty()) {
+        tiles.redraw(dirtyRegions, drawRegion);
+    }
+    
+    drawTiles();
+}
+
+void PdPatchView::drawToFboMerged() {
+    // Régions sales fusionnées : une frame inactive ne coûte qu'un blit des tuiles visibles
+    prepareTiles();
+    collectDirtyRegions();
+    if (!dirtyRegions.empty()) {
+        tiles.redraw(mergeAdjacentRectangles(dirtyRegions), drawRegion);
+    }
+    
+    drawTiles();
+}
+
+void PdPatchView::collectDirtyRegions() {
+    // Les objets du store sont parcourus par leurs drapeaux DIRTY, sans toucher
+    // aux objets propres ; un objet d'un canvas caché ne coûte qu'un redessin inutile
+    // et une région hors de l'écran ne fait qu'invalider les tuiles qu'elle touche
+    dirtyRegions.clear();
+    staticRegions.clear();
+    PdWidgetStore::get().collectDirtyRegions(ownerId, dirtyRegions, &staticRegions);
+    
+    // Zones des objets détruits par un rechargement (canvas compris)
+    staticRegions.insert(staticRegions.end(), invalidatedRegions.begin(), invalidatedRegions.end());
+    invalidatedRegions.clear();
+    
+    for (auto& obj : getVisibleObjects()) {
+        if (!obj->isPooled() && obj->needsUpdate()) {
+            (obj->isStatic() ? staticRegions : dirtyRegions).push_back(obj->getUpdateRegion());
+            obj->clearUpdateFlag();
+        }
+    }
+    
+    // Fond refait d'abord, puis recomposé avec les autres régions
+    if (!staticRegions.empty()) {
+        tiles.redrawStatic(mergeAdjacentRectangles(staticRegions));
+        dirtyRegions.insert(dirtyRegions.end(), staticRegions.begin(), staticRegions.end());
+    }
+    
+    if (!dirtyRegions.empty()) {
+        notifyRedrawn();
+    }
+}
+
+vector<ofRectangle> PdPatchView::mergeAdjacentRectangles(const vector<ofRectangle>& rectangles) {
+    vector<ofRectangle> merged(rectangles);
+    
+    // Fusionner jusqu'à ce qu'aucune paire ne se touche plus
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (size_t i = 0; i < merged.size(); i++) {
+            size_t j = i + 1;
+            while (j < merged.size()) {
+                if (areAdjacent(merged[i], merged[j])) {
+                    merged[i].growToInclude(merged[j]);
+                    merged[j] = merged.back();
+                    merged.pop_back();
+                    changed = true;
+                } else {
+                    j++;
+                }
+            }
+        }
+    }
+    
+    return merged;
+}
+
+bool PdPatchView::areAdjacent(const ofRectangle& a, const ofRectangle& b) {
+    // Vrai si les rectangles se chevauchent ou sont séparés de moins de 2 pixels
+    const float tolerance = 2.0f;
+    return a.getMinX() <= b.getMaxX() + tolerance && b.getMinX() <= a.getMaxX() + tolerance
+        && a.getMinY() <= b.getMaxY() + tolerance && b.getMinY() <= a.getMaxY() + tolerance;
+}
@@ -0,0 +1,179 @@
+//
+//  PatchView.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "PdGuiObject.h"
+#include "Subpatch.h"
+#include "PatchLayout.h"
+#include "PatchLoader.h"
+#include "PatchWatcher.h"
+#include "SpatialGrid.h"
+#include "EventRouter.h"
+#include "MessageRouter.h"
+#include "SendQueue.h"
+#include "PrimitiveBatch.h"
+#include "RenderTarget.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Ressources communes à toutes les vues. L'atlas de glyphes (PdGlyphAtlas),
+// la table des symboles (PdSymbol) et le store des objets sont déjà uniques.
+struct PdPatchResources {
+    PdMessageRouter& messageRouter;
+    PdSendQueue& sendQueue;
+    PdPrimitiveBatch& primitiveBatch;
+};
+
+// Un patch affiché dans une zone de fenêtre : ses objets, le canvas ouvert,
+// l'index spatial, le rechargement à chaud et le rendu par régions sales
+// dans des tuiles (PdTiledTarget) à la densité de pixels de l'écran.
+// Plusieurs vues tournent côte à côte, dans des fenêtres séparées ou dans
+// une même fenêtre.
+class PdPatchView {
+public:
+    PdPatchView(const PdPatchResources& resources);
+    ~PdPatchView();
+    
+    // Zone de la fenêtre, en coordonnées OF. À appeler dans le contexte GL de
+    // la fenêtre qui dessine la vue (densité de pixels, tuiles).
+    void setViewport(const ofRectangle& viewport);
+    const ofRectangle& getViewport() const { return viewport; }
+    bool contains(float x, float y) const { return viewport.inside(x, y); }
+    
+    // Défilement du canevas, en points du patch (SCROLL_STEP par cran de molette)
+    static constexpr float SCROLL_STEP = 40.0f;
+    void scroll(float dx, float dy);
+    ofVec2f getScroll() const { return scrollOffset; }
+    ofRectangle getVisibleArea() const;
+    const PdTiledTarget& getTiles() const { return tiles; }
+    
+    // Chargement en arrière-plan (abandonne le patch courant)
+    void load(const string& path);
+    // Objets créés hors d'un fichier (mesure du rendu, tests manuels)
+    void setObjects(PdObjectList objects);
+    
+    const string& getPath() const { return patchLoader.getPath(); }
+    const string& getTitle() const { return title; }
+    bool isLoading() const { return patchLoader.isLoading(); }
+    bool hasPendingWork() const;
+    
+    // Canvas affiché (patch principal ou dernier sous-patch ouvert)
+    PdObjectList& getVisibleObjects();
+    
+    // Patch principal et sa disposition (un objet par description, dans l'ordre).
+    // La version change à chaque nouvelle disposition (chargement, rechargement).
+    PdObjectList& getObjects() { return guiObjects; }
+    const PdPatchLayout* getLayout() const { return patchLayout.get(); }
+    uint32_t getLayoutVersion() const { return layoutVersion; }
+    void closeSubpatch();
+    
+    // Début de frame, avant les messages : rechargement, chargement, sous-patch cliqué
+    void update();
+    // Après les messages : update() des objets créés hors du store
+    void updateObjects();
+    
+    // Rendu dans la zone de la vue
+    void draw();
+    void drawDirect();
+    void drawToFbo();             // Un objet par région, sans chevauchement
+    void drawToFboWithScissor();  // Une région par objet sale
+    void drawToFboMerged();       // Régions sales fusionnées
+    void invalidate() { fboNeedsUpdate = true; }
+    
+    void setFboRenderer(bool enabled);
+    void setBatchRenderer(bool enabled);
+    
+    // Passage des coordonnées du canevas à celles de la fenêtre
+    ofVec2f toWindow(float x, float y) const;
+    
+    // Événements pointeur, en coordonnées de la fenêtre
+    bool pointerPressed(int pointerId, float x, float y, int button = 0);
+    bool pointerDragged(int pointerId, float x, float y, int button = 0);
+    bool pointerReleased(int pointerId, float x, float y, int button = 0);
+    void pointerCancelled(int pointerId);
+    void pointerMoved(float x, float y);
+    PdGuiObject* getActiveObject(int pointerId) const { return eventRouter.getActiveObject(pointerId); }
+    
+    // Travail visible (événement, redessin, chargement) : la boucle doit produire une frame
+    std::function<void(PdPatchView&)> onActivity;
+    // Des régions ont été redessinées : valeurs et compteurs à recalculer
+    std::function<void(PdPatchView&)> onRedrawn;
+
+private:
+    // Chargement : au plus LOAD_BUDGET_MICROS de création d'objets par frame
+    static constexpr uint64_t LOAD_BUDGET_MICROS = 4000;
+    
+    PdPatchResources resources;
+    uint16_t ownerId;   // Marque des objets de la vue dans le store
+    ofRectangle viewport;
+    PdDisplayScale displayScale;
+    ofVec2f scrollOffset;
+    string title;
+    
+    // Objets du patch et disposition dont ils sont issus (un objet par description)
+    PdObjectList guiObjects;
+    std::unique_ptr<PdPatchLayout> patchLayout;
+    uint32_t layoutVersion = 0;
+    PdPatchLoader patchLoader;
+    PdPatchWatcher patchWatcher;
+    vector<ofRectangle> invalidatedRegions;
+    
+    // Sous-patchs ouverts (le dernier est affiché), vide = patch principal
+    vector<PdSubpatch*> subpatchStack;
+    PdSubpatch* pendingSubpatch = nullptr;
+    
+    // Index spatial et routage des événements pointeur
+    PdSpatialGrid spatialIndex;
+    PdEventRouter eventRouter{spatialIndex};
+    
+    // Tuiles du rendu optimisé
+    // Couche statique (canvas) rendue à part, sous les objets interactifs
+    enum class DrawLayer {
+        ALL,
+        STATIC,
+        INTERACTIVE
+    };
+    PdTiledTarget tiles;
+    PdTiledTarget::DrawFunction drawRegion;
+    PdTiledTarget::DrawFunction drawStaticRegion;
+    bool fboNeedsUpdate = true;
+    bool useFboRenderer = true;
+    bool useBatchRenderer = true;
+    
+    // Régions sales collectées à chaque frame (réutilisées pour éviter les allocations)
+    vector<ofRectangle> dirtyRegions;
+    vector<ofRectangle> staticRegions;
+    
+    void notifyActivity();
+    void notifyRedrawn();
+    void updateLoading();
+    void updateTitle();
+    void clearObjects();
+    void setupCallbacks(PdObjectList& objects);
+    void setupCallbacks(PdGuiObject& obj);
+    void reloadPatch(std::unique_ptr<PdPatchLayout> layout);
+    void retireObject(PdGuiObject& obj);
+    void openSubpatch(PdSubpatch& subpatch);
+    void showVisibleObjects();
+    void collectDirtyRegions();
+    void clampScroll();
+    ofVec2f toCanvas(float x, float y) const;
+    void pushViewport();
+    void prepareTiles();
+    void drawTiles();
+    void drawGuiObject(PdGuiObject& obj);
+    void drawGuiObjectList(const ofRectangle* region, DrawLayer layer = DrawLayer::ALL);
+    bool hasStaticObject(const ofRectangle& region);
+    
+    // Méthodes utilitaires pour l'optimisation FBO
+    vector<ofRectangle> mergeAdjacentRectangles(const vector<ofRectangle>& rectangles);
+    bool areAdjacent(const ofRectangle& a, const ofRectangle& b);
+};
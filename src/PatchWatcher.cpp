@@ -0,0 +1,89 @@
+//
+//  PatchWatcher.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 24/07/2025.
+//
+
+#include "PatchWatcher.h"
+#include "PatchParser.h"
+#include "FrameClock.h"
+#include "Profiler.h"
+
+PdPatchWatcher::~PdPatchWatcher() {
+    stop();
+}
+
+void PdPatchWatcher::start(const string& patchPath) {
+    stop();
+    
+    path = patchPath;
+    fullPath = ofToDataPath(patchPath, true);
+    
+    // Le patch déjà chargé sert de référence
+    if (!readModificationTime(lastWriteTime)) {
+        lastWriteTime = std::filesystem::file_time_type();
+    }
+    
+    startThread();
+}
+
+void PdPatchWatcher::stop() {
+    if (isThreadRunning()) {
+        waitForThread(true);
+    }
+}
+
+bool PdPatchWatcher::poll(std::unique_ptr<PdPatchLayout>& layout) {
+    // Plusieurs versions en attente : seule la plus récente compte
+    bool received = false;
+    std::unique_ptr<PdPatchLayout> next;
+    while (parsed.tryReceive(next)) {
+        layout = std::move(next);
+        received = true;
+    }
+    
+    if (received) {
+        PdProfiler::get().addTime(PdProfileSection::PARSE, parseStartMicros, parseMicros.exchange(0));
+    }
+    return received;
+}
+
+bool PdPatchWatcher::readModificationTime(std::filesystem::file_time_type& time) const {
+    std::error_code error;
+    time = std::filesystem::last_write_time(fullPath, error);
+    return !error;
+}
+
+void PdPatchWatcher::threadedFunction() {
+    PdPatchParser parser;
+    
+    while (isThreadRunning()) {
+        sleep(POLL_INTERVAL_MS);
+        
+        std::filesystem::file_time_type writeTime;
+        if (!readModificationTime(writeTime) || writeTime == lastWriteTime) continue;
+        
+        // Attendre que l'éditeur ait fini d'écrire
+        sleep(POLL_INTERVAL_MS);
+        std::filesystem::file_time_type settledTime;
+        if (!readModificationTime(settledTime) || settledTime != writeTime) continue;
+        lastWriteTime = writeTime;
+        
+        ofBuffer buffer = ofBufferFromFile(fullPath);
+        if (buffer.size() == 0) {
+            ofLogWarning("PdPatchWatcher") << "Ignoring empty patch " << path;
+            continue;
+        }
+        
+        auto layout = std::make_unique<PdPatchLayout>();
+        uint64_t start = ofGetElapsedTimeMicros();
+        parser.parseLayout(buffer.getData(), buffer.size(), *layout);
+        parseStartMicros = start;
+        parseMicros += ofGetElapsedTimeMicros() - start;
+        parsed.send(std::move(layout));
+        
+        // La boucle principale peut dormir (rendu à la demande)
+        PdFrameClock::wake();
+    }
+}
@@ -0,0 +1,48 @@
+//
+//  PatchWatcher.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 24/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "PatchLayout.h"
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+// Surveille un patch sur disque et le re-parse dans un thread dédié à chaque
+// modification. Le thread ne produit qu'une disposition (PdPatchLayout) : les
+// objets GUI et les symboles sont créés sur le thread principal.
+class PdPatchWatcher : public ofThread {
+public:
+    ~PdPatchWatcher();
+    
+    void start(const string& patchPath);
+    void stop();
+    
+    // Thread principal : dernière disposition parsée, s'il y en a une
+    bool poll(std::unique_ptr<PdPatchLayout>& layout);
+    bool hasPendingLayout() const { return !parsed.empty(); }
+    
+    const string& getPath() const { return path; }
+    
+private:
+    static constexpr long POLL_INTERVAL_MS = 250;
+    
+    void threadedFunction() override;
+    bool readModificationTime(std::filesystem::file_time_type& time) const;
+    
+    string path;
+    string fullPath;
+    std::filesystem::file_time_type lastWriteTime;
+    ofThreadChannel<std::unique_ptr<PdPatchLayout>> parsed;
+    
+    // Durées de parsing cumulées depuis le dernier poll(), reportées au
+    // profileur par le thread principal
+    std::atomic<uint64_t> parseStartMicros{0};
+    std::atomic<uint64_t> parseMicros{0};
+};
@@ -0,0 +1,72 @@
+//
+//  PatchWindow.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#include "PatchWindow.h"
+#include "Profiler.h"
+
+PdPatchWindow::PdPatchWindow(PdPatchView& view, PdPrimitiveBatch& primitiveBatch)
+    : view(view)
+    , primitiveBatch(primitiveBatch) {
+}
+
+void PdPatchWindow::setup() {
+    // Appelé avec le contexte de cette fenêtre : les tuiles de la vue y sont créées
+    ofBackground(50);
+    view.setViewport(ofRectangle(0, 0, ofGetWidth(), ofGetHeight()));
+}
+
+void PdPatchWindow::draw() {
+    view.draw();
+    
+    PdProfileScope scope(PdProfileSection::TEXT);
+    titleLabel.set(view.getTitle());
+    primitiveBatch.begin();
+    primitiveBatch.addText(titleLabel, 20, 30, ofColor(255));
+    primitiveBatch.draw();
+}
+
+void PdPatchWindow::mousePressed(int x, int y, int button) {
+    PdProfileScope scope(PdProfileSection::EVENTS);
+    if (onInputBegin) onInputBegin();
+    view.pointerPressed(PdEventRouter::MOUSE_POINTER_ID, x, y, button);
+    if (onInputEnd) onInputEnd();
+}
+
+void PdPatchWindow::mouseDragged(int x, int y, int button) {
+    PdProfileScope scope(PdProfileSection::EVENTS);
+    if (onInputBegin) onInputBegin();
+    view.pointerDragged(PdEventRouter::MOUSE_POINTER_ID, x, y, button);
+    if (onInputEnd) onInputEnd();
+}
+
+void PdPatchWindow::mouseReleased(int x, int y, int button) {
+    PdProfileScope scope(PdProfileSection::EVENTS);
+    if (onInputBegin) onInputBegin();
+    view.pointerReleased(PdEventRouter::MOUSE_POINTER_ID, x, y, button);
+    if (onInputEnd) onInputEnd();
+}
+
+void PdPatchWindow::mouseMoved(int x, int y) {
+    PdProfileScope scope(PdProfileSection::EVENTS);
+    view.pointerMoved(x, y);
+}
+
+void PdPatchWindow::mouseExited(int x, int y) {
+    view.pointerMoved(-1, -1);
+}
+
+void PdPatchWindow::mouseScrolled(int x, int y, float scrollX, float scrollY) {
+    view.scroll(-scrollX * PdPatchView::SCROLL_STEP, -scrollY * PdPatchView::SCROLL_STEP);
+}
+
+void PdPatchWindow::keyPressed(int key) {
+    if (onKeyPressed) onKeyPressed(view, key);
+}
+
+void PdPatchWindow::windowResized(int w, int h) {
+    view.setViewport(ofRectangle(0, 0, w, h));
+}
@@ -0,0 +1,44 @@
+//
+//  PatchWindow.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "PatchView.h"
+#include "TextRenderer.h"
+#include <functional>
+
+// Fenêtre secondaire affichant une seule vue. Son contexte GL partage celui
+// de la fenêtre principale (textures de l'atlas, tampons du batch) ; la mise
+// à jour des vues et des messages reste faite par ofApp.
+class PdPatchWindow : public ofBaseApp {
+public:
+    PdPatchWindow(PdPatchView& view, PdPrimitiveBatch& primitiveBatch);
+    
+    void setup() override;
+    void draw() override;
+    
+    void mousePressed(int x, int y, int button) override;
+    void mouseDragged(int x, int y, int button) override;
+    void mouseReleased(int x, int y, int button) override;
+    void mouseMoved(int x, int y) override;
+    void mouseExited(int x, int y) override;
+    void mouseScrolled(int x, int y, float scrollX, float scrollY) override;
+    void keyPressed(int key) override;
+    void windowResized(int w, int h) override;
+    
+    // Clavier traité par l'application, pour cette vue
+    std::function<void(PdPatchView&, int)> onKeyPressed;
+    // Autour de chaque événement pointeur (mesure de latence, envoi immédiat)
+    std::function<void()> onInputBegin;
+    std::function<void()> onInputEnd;
+
+private:
+    PdPatchView& view;
+    PdPrimitiveBatch& primitiveBatch;
+    PdTextLabel titleLabel;
+};
@@ -6,6 +6,9 @@
 //
 
 #include "PdGuiObject.h"
+#include "WidgetStore.h"
+#include "UpdateScheduler.h"
+#include "ValueSmoother.h"
 
 // Constantes de style
 const ofColor PdGuiObject::DEFAULT_BG_COLOR = ofColor(220, 220, 220);
@@ -15,13 +18,16 @@ const ofColor PdGuiObject::HOVER_COLOR = ofColor(240, 240, 240);
 const ofColor PdGuiObject::PRESSED_COLOR = ofColor(180, 180, 180);
 
 PdGuiObject::PdGuiObject(GuiType type, ofVec2f position, ofVec2f size,
-                         const string& sendSymbol, const string& receiveSymbol)
+                         PdSymbol sendSymbol, PdSymbol receiveSymbol)
     : type(type)
     , position(position)
     , size(size)
     , sendSymbol(sendSymbol)
     , receiveSymbol(receiveSymbol)
+    , sendQueue(nullptr)
+    , sendPolicy(PdSendPolicy::COALESCE)
     , currentValue(0.0f)
+    , displayValue(0.0f)
     , minValue(0.0f)
     , maxValue(127.0f)
     , visible(true)
@@ -29,15 +35,28 @@ PdGuiObject::PdGuiObject(GuiType type, ofVec2f position, ofVec2f size,
     , mouseOver(false)
     , mousePressed(false)
     , isDragging(false)
+    , animating(false)
+    , fontSize(PdGlyphAtlas::DEFAULT_FONT_SIZE)
     , lastMousePos(0, 0)
     , mousePressPos(0, 0)
+    , renderKey(0)
+    , smootherEntry(-1)
 {
+    // Les labels ne sont mis en forme qu'une fois
+    if (!sendSymbol.isEmpty()) {
+        sendLabel.set("S:" + sendSymbol.getName());
+    }
+    if (!receiveSymbol.isEmpty()) {
+        receiveLabel.set("R:" + receiveSymbol.getName());
+    }
+    
     // Initialiser la région de mise à jour avec les dimensions complètes
     updateRegion = GuiUpdateRegion(getBounds());
     
     // Callbacks par défaut (vides)
     onSendToPd = [](const string&, float) {};
     onSendToPdString = [](const string&, const string&) {};
+    onBoundsChanged = [](PdGuiObject&) {};
 }
 
 void PdGuiObject::drawToFbo(ofFbo& fbo) {
@@ -75,7 +94,7 @@ bool PdGuiObject::onMousePressed(ofMouseEventArgs& args) {
         mousePressed = true;
         mousePressPos = mousePos;
         lastMousePos = mousePos;
-        markForUpdate();
+        markIfRenderChanged();
         return true;
     }
     
@@ -97,7 +116,7 @@ bool PdGuiObject::onMouseDragged(ofMouseEventArgs& args) {
     
     if (isDragging) {
         lastMousePos = mousePos;
-        markForUpdate();
+        markIfRenderChanged();
         return true;
     }
     
@@ -112,7 +131,7 @@ bool PdGuiObject::onMouseReleased(ofMouseEventArgs& args) {
     isDragging = false;
     
     if (wasPressed) {
-        markForUpdate();
+        markIfRenderChanged();
         return true;
     }
     
@@ -127,18 +146,29 @@ bool PdGuiObject::onMouseMoved(ofMouseEventArgs& args) {
     mouseOver = isPointInside(mousePos);
     
     if (wasMouseOver != mouseOver) {
-        markForUpdate();
+        markIfRenderChanged();
     }
     
     return mouseOver;
 }
 
+void PdGuiObject::onMouseExited() {
+    if (mouseOver) {
+        mouseOver = false;
+        markIfRenderChanged();
+    }
+}
+
 void PdGuiObject::setValue(float value) {
     float clampedValue = ofClamp(value, minValue, maxValue);
     
-    if (abs(currentValue - clampedValue) > 0.001f) {
+    // Une valeur posée directement (souris, preset) interrompt le lissage
+    PdValueSmoother::get().cancel(*this);
+    
+    if (abs(currentValue - clampedValue) > 0.001f || abs(displayValue - clampedValue) > 0.001f) {
         currentValue = clampedValue;
-        markForUpdate();
+        displayValue = clampedValue;
+        markIfRenderChanged();
     }
 }
 
@@ -150,12 +180,118 @@ void PdGuiObject::setValueRange(float min, float max) {
     setValue(currentValue);
 }
 
+void PdGuiObject::receiveFloat(float value) {
+    // Mise à jour de l'affichage seulement : Pd connaît déjà la valeur
+    float quantum = getDisplayQuantum();
+    if (quantum <= 0.0f || !isPooled()) {
+        setValue(value);
+        return;
+    }
+    
+    // Valeurs continues : Pd peut en envoyer des centaines par seconde. Seule
+    // la cible change ici, l'affichage suit une fois par frame.
+    currentValue = ofClamp(value, minValue, maxValue);
+    publishHotState();
+    PdValueSmoother::get().setTarget(*this, currentValue, quantum, smoothsDisplay());
+}
+
+void PdGuiObject::receiveBang() {
+    // Comme dans Pd, un bang ressort la valeur courante
+    sendToPd(currentValue);
+}
+
 void PdGuiObject::markForUpdate() {
-    updateRegion = GuiUpdateRegion(getBounds());
+    updateRegion.add(getDrawBounds());
+    renderKey = computeRenderKey();
+    publishHotState();
 }
 
 void PdGuiObject::markForUpdate(ofRectangle region) {
-    updateRegion = GuiUpdateRegion(region);
+    updateRegion.add(region);
+    renderKey = computeRenderKey();
+    publishHotState();
+}
+
+bool PdGuiObject::markIfRenderChanged() {
+    return markIfRenderChanged(computeRenderKey());
+}
+
+bool PdGuiObject::markIfRenderChanged(uint64_t key) {
+    if (key == renderKey) {
+        // Rien ne change à l'écran, mais la valeur du store doit suivre
+        publishHotState();
+        return false;
+    }
+    
+    updateRegion.add(getDrawBounds());
+    renderKey = key;
+    publishHotState();
+    return true;
+}
+
+uint64_t PdGuiObject::getBaseRenderKey() const {
+    return (uint64_t)visible | ((uint64_t)enabled << 1)
+         | ((uint64_t)mouseOver << 2) | ((uint64_t)mousePressed << 3);
+}
+
+uint64_t PdGuiObject::computeRenderKey() const {
+    uint64_t key = getBaseRenderKey();
+    
+    float quantum = getDisplayQuantum();
+    if (quantum > 0.0f) {
+        return mixRenderKey(key, (uint64_t)(int64_t)floor(displayValue / quantum + 0.5f));
+    }
+    
+    // Sans quantum, tout changement de la valeur affichée compte
+    uint32_t bits;
+    memcpy(&bits, &displayValue, sizeof(bits));
+    return mixRenderKey(key, bits);
+}
+
+void PdGuiObject::attachToStore(const PdWidgetHandle& handle) {
+    storeHandle = handle;
+    publishHotState();
+}
+
+void PdGuiObject::setAnimating(bool animating) {
+    if (this->animating == animating) return;
+    this->animating = animating;
+    publishHotState();
+}
+
+void PdGuiObject::scheduleUpdate(uint64_t delayMicros) {
+    PdUpdateScheduler::get().schedule(storeHandle, ofGetElapsedTimeMicros() + delayMicros);
+}
+
+void PdGuiObject::publishHotState() {
+    if (storeHandle.isValid()) {
+        PdWidgetStore::get().publish(*this);
+    }
+}
+
+void PdGuiObject::setFontSize(int fontSize) {
+    this->fontSize = fontSize;
+    sendLabel.setFontSize(fontSize);
+    receiveLabel.setFontSize(fontSize);
+    markForUpdate();
+}
+
+void PdGuiObject::setPosition(ofVec2f newPosition) {
+    setBounds(newPosition, size);
+}
+
+void PdGuiObject::setSize(ofVec2f newSize) {
+    setBounds(position, newSize);
+}
+
+ofRectangle PdGuiObject::getDrawBounds() const {
+    // Marge d'un pixel pour les bordures dessinées en ofNoFill()
+    ofRectangle bounds = getBounds();
+    bounds.x -= 1;
+    bounds.y -= 1;
+    bounds.width += 2;
+    bounds.height += 2;
+    return bounds;
 }
 
 bool PdGuiObject::isPointInside(ofVec2f point) const {
@@ -166,15 +302,28 @@ bool PdGuiObject::isPointInside(float x, float y) const {
     return isPointInside(ofVec2f(x, y));
 }
 
+void PdGuiObject::setSendQueue(PdSendQueue* queue) {
+    sendQueue = queue;
+    if (queue) {
+        queue->reserveSymbol(sendSymbol.getId());
+    }
+}
+
 void PdGuiObject::sendToPd(float value) {
-    if (!sendSymbol.empty() && sendSymbol != "empty") {
-        onSendToPd(sendSymbol, value);
+    if (sendSymbol.isEmpty()) return;
+    
+    if (sendQueue) {
+        // Chemin rapide : symbole déjà interné, pas de copie de string
+        sendQueue->send(sendSymbol.getId(), value, sendPolicy);
+        return;
     }
+    
+    onSendToPd(sendSymbol.getName(), value);
 }
 
 void PdGuiObject::sendToPd(const string& message) {
-    if (!sendSymbol.empty() && sendSymbol != "empty") {
-        onSendToPdString(sendSymbol, message);
+    if (!sendSymbol.isEmpty()) {
+        onSendToPdString(sendSymbol.getName(), message);
     }
 }
 
@@ -186,7 +335,7 @@ ofVec2f PdGuiObject::localToGlobal(ofVec2f localPos) const {
     return localPos + position;
 }
 
-void PdGuiObject::drawBackground() {
+ofColor PdGuiObject::getBackgroundColor() const {
     ofColor bgColor = DEFAULT_BG_COLOR;
     
     if (mousePressed) {
@@ -199,7 +348,11 @@ void PdGuiObject::drawBackground() {
         bgColor = bgColor * 0.5f;
     }
     
-    ofSetColor(bgColor);
+    return bgColor;
+}
+
+void PdGuiObject::drawBackground() {
+    ofSetColor(getBackgroundColor());
     ofDrawRectangle(0, 0, size.x, size.y);
 }
 
@@ -211,17 +364,47 @@ void PdGuiObject::drawBorder() {
 }
 
 void PdGuiObject::drawLabel() {
-    if (!sendSymbol.empty() && sendSymbol != "empty") {
-        ofSetColor(DEFAULT_FG_COLOR);
-        ofDrawBitmapString("S:" + sendSymbol, 2, size.y + 12);
-    }
+    sendLabel.draw(2, size.y + 12, DEFAULT_FG_COLOR);
+    receiveLabel.draw(2, size.y + 24, DEFAULT_FG_COLOR);
+}
+
+void PdGuiObject::batchBackground(PdPrimitiveBatch& batch) const {
+    batch.addRect(0, 0, size.x, size.y, getBackgroundColor());
+}
+
+void PdGuiObject::batchBorder(PdPrimitiveBatch& batch) const {
+    batch.addRectOutline(0, 0, size.x, size.y, DEFAULT_BORDER_COLOR);
+}
+
+void PdGuiObject::batchLabel(PdPrimitiveBatch& batch) const {
+    batch.addText(sendLabel, 2, size.y + 12, DEFAULT_FG_COLOR);
+    batch.addText(receiveLabel, 2, size.y + 24, DEFAULT_FG_COLOR);
+}
+
+ofRectangle PdGuiObject::getLabelBounds() const {
+    // Zone occupée par drawLabel() en coordonnées globales, estimée sans contexte GL
+    size_t maxChars = max(sendLabel.getText().length(), receiveLabel.getText().length());
+    int lines = !receiveLabel.empty() ? 2 : (!sendLabel.empty() ? 1 : 0);
     
-    if (!receiveSymbol.empty() && receiveSymbol != "empty") {
-        ofSetColor(DEFAULT_FG_COLOR);
-        ofDrawBitmapString("R:" + receiveSymbol, 2, size.y + 24);
-    }
+    if (lines == 0) return ofRectangle(position.x, position.y, 0, 0);
+    
+    return ofRectangle(position.x + 2, position.y + size.y,
+                       maxChars * PdGlyphAtlas::estimateCharWidth(fontSize),
+                       lines * 12 + max(4, fontSize - 8));
 }
 
 void PdGuiObject::updateMouseState(ofVec2f mousePos) {
     lastMousePos = mousePos;
 }
+
+void PdGuiObject::setBounds(ofVec2f newPosition, ofVec2f newSize) {
+    if (newPosition == position && newSize == size) return;
+    
+    // L'ancienne zone doit aussi être effacée dans le FBO
+    ofRectangle oldDrawBounds = getDrawBounds();
+    position = newPosition;
+    size = newSize;
+    markForUpdate(oldDrawBounds.getUnion(getDrawBounds()));
+    
+    onBoundsChanged(*this);
+}
@@ -3,6 +3,11 @@
 #pragma once
 
 #include "ofMain.h"
+#include "PrimitiveBatch.h"
+#include "TextRenderer.h"
+#include "SendQueue.h"
+#include "Symbol.h"
+#include "WidgetHandle.h"
 #include <functional>
 
 enum class GuiType {
@@ -11,6 +16,10 @@ enum class GuiType {
     TOGGLE,
     BANG,
     NUMBER_BOX,
+    SUBPATCH,
+    CANVAS,
+    VU_METER,
+    ARRAY,
     UNKNOWN
 };
 
@@ -20,13 +29,20 @@ struct GuiUpdateRegion {
     
     GuiUpdateRegion() : needsUpdate(false) {}
     GuiUpdateRegion(ofRectangle r) : rect(r), needsUpdate(true) {}
+    
+    // Zone à redessiner en plus de celle déjà marquée depuis le dernier rendu
+    // (déplacement puis redimensionnement : les deux anciennes zones restent)
+    void add(const ofRectangle& r) {
+        rect = needsUpdate ? rect.getUnion(r) : r;
+        needsUpdate = true;
+    }
 };
 
 class PdGuiObject {
 public:
     // Constructeur
     PdGuiObject(GuiType type, ofVec2f position, ofVec2f size,
-                const string& sendSymbol, const string& receiveSymbol);
+                PdSymbol sendSymbol, PdSymbol receiveSymbol);
     
     // Destructeur virtuel
     virtual ~PdGuiObject() = default;
@@ -36,17 +52,41 @@ public:
     virtual void draw() = 0;
     virtual void drawToFbo(ofFbo& fbo) final;
     
+    // Dessin groupé : ajoute les primitives de l'objet au tampon partagé.
+    // Retourne false si l'objet doit être dessiné par draw() (objets personnalisés).
+    virtual bool drawBatched(PdPrimitiveBatch& batch) { return false; }
+    
+    // Objet sans état interactif (canvas) : rendu une fois dans la couche
+    // statique des tuiles, toujours sous les objets interactifs
+    virtual bool isStatic() const { return false; }
+    
     // Gestion des événements souris
     virtual bool onMousePressed(ofMouseEventArgs& args);
     virtual bool onMouseDragged(ofMouseEventArgs& args);
     virtual bool onMouseReleased(ofMouseEventArgs& args);
     virtual bool onMouseMoved(ofMouseEventArgs& args);
+    virtual void onMouseExited();
     
     // Gestion des valeurs
     virtual void setValue(float value);
     virtual float getValue() const { return currentValue; }
     virtual void setValueRange(float min, float max);
     
+    // Valeur dessinée : rejoint getValue() aux frames suivantes quand la valeur
+    // vient de Pd (PdValueSmoother), identique sinon
+    float getDisplayValue() const { return displayValue; }
+    
+    // Plus petit écart de valeur visible à l'écran ; 0 = affichage immédiat
+    virtual float getDisplayQuantum() const { return 0.0f; }
+    // Lissage exponentiel de l'affichage, sinon dernière valeur de la frame
+    virtual bool smoothsDisplay() const { return false; }
+    
+    // Messages reçus de Pure Data sur le symbole receive
+    virtual void receiveFloat(float value);
+    virtual void receiveBang();
+    // Valeurs d'un tableau Pd (objets à tableau seulement)
+    virtual void receiveSamples(size_t offset, const float* samples, size_t count) {}
+    
     // Gestion des mises à jour
     void markForUpdate();
     void markForUpdate(ofRectangle region);
@@ -54,39 +94,73 @@ public:
     ofRectangle getUpdateRegion() const { return updateRegion.rect; }
     void clearUpdateFlag() { updateRegion.needsUpdate = false; }
     
+    // Clé de rendu : condensé de l'état visuel (valeur quantifiée au pixel,
+    // survol, appui...). Deux états de même clé se dessinent à l'identique.
+    uint64_t getRenderKey() const { return renderKey; }
+    
     // Accesseurs
     GuiType getType() const { return type; }
     ofVec2f getPosition() const { return position; }
     ofVec2f getSize() const { return size; }
     ofRectangle getBounds() const { return ofRectangle(position.x, position.y, size.x, size.y); }
+    void setPosition(ofVec2f newPosition);
+    void setSize(ofVec2f newSize);
+    
+    // Zone réellement touchée par draw() (bordures, labels et textes qui débordent)
+    virtual ofRectangle getDrawBounds() const;
     
-    string getSendSymbol() const { return sendSymbol; }
-    string getReceiveSymbol() const { return receiveSymbol; }
+    const string& getSendSymbol() const { return sendSymbol.getName(); }
+    const string& getReceiveSymbol() const { return receiveSymbol.getName(); }
+    PdSymbolId getSendSymbolId() const { return sendSymbol.getId(); }
+    PdSymbolId getReceiveSymbolId() const { return receiveSymbol.getId(); }
     
     bool isVisible() const { return visible; }
-    void setVisible(bool v) { visible = v; if(v) markForUpdate(); }
+    void setVisible(bool v) { visible = v; markForUpdate(); }
+    bool isAnimating() const { return animating; }
+    
+    // Taille de police Pd (labels et valeurs affichées)
+    int getFontSize() const { return fontSize; }
+    virtual void setFontSize(int fontSize);
     
     bool isEnabled() const { return enabled; }
     void setEnabled(bool e) { enabled = e; markForUpdate(); }
     
+    // Stockage contigu (PdWidgetStore) : handle stable, invalide hors store
+    bool isPooled() const { return storeHandle.isValid(); }
+    const PdWidgetHandle& getStoreHandle() const { return storeHandle; }
+    void attachToStore(const PdWidgetHandle& handle);
+    
     // Hit testing
     bool isPointInside(ofVec2f point) const;
     bool isPointInside(float x, float y) const;
     
+    // Envoi vers Pure Data par la file sortante (sinon par onSendToPd)
+    void setSendQueue(PdSendQueue* queue);
+    PdSendPolicy getSendPolicy() const { return sendPolicy; }
+    void setSendPolicy(PdSendPolicy policy) { sendPolicy = policy; }
+    
     // Callbacks pour la communication avec Pure Data
     std::function<void(const string&, float)> onSendToPd;
     std::function<void(const string&, const string&)> onSendToPdString;
     
+    // Callback appelé après un déplacement ou un redimensionnement (index spatial)
+    std::function<void(PdGuiObject&)> onBoundsChanged;
+    
 protected:
     // Propriétés de base
     GuiType type;
     ofVec2f position;
     ofVec2f size;
-    string sendSymbol;
-    string receiveSymbol;
+    PdSymbol sendSymbol;
+    PdSymbol receiveSymbol;
+    
+    // File sortante partagée
+    PdSendQueue* sendQueue;
+    PdSendPolicy sendPolicy;
     
     // Valeurs
     float currentValue;
+    float displayValue;
     float minValue;
     float maxValue;
     
@@ -96,10 +170,16 @@ protected:
     bool mouseOver;
     bool mousePressed;
     bool isDragging;
+    bool animating;
     
     // Gestion des mises à jour
     GuiUpdateRegion updateRegion;
     
+    // Textes mis en cache ("S:send" et "R:receive")
+    int fontSize;
+    PdTextLabel sendLabel;
+    PdTextLabel receiveLabel;
+    
     // Positions souris
     ofVec2f lastMousePos;
     ofVec2f mousePressPos;
@@ -108,12 +188,41 @@ protected:
     void sendToPd(float value);
     void sendToPd(const string& message);
     ofVec2f globalToLocal(ofVec2f globalPos) const;
+    
+    // Changement d'état (valeur, survol, appui) : l'objet n'est marqué sale
+    // que si sa clé de rendu change. Retourne true s'il a été marqué.
+    bool markIfRenderChanged();
+    // Idem avec une clé déjà calculée (en parallèle par PdValueSmoother)
+    bool markIfRenderChanged(uint64_t key);
+    
+    // Clé de rendu de chaque type d'objet ; par défaut les états de base et la
+    // valeur affichée (quantifiée par getDisplayQuantum()). Sans effet de bord :
+    // peut être appelée depuis un thread de PdJobSystem.
+    virtual uint64_t computeRenderKey() const;
+    uint64_t getBaseRenderKey() const;
+    static uint64_t mixRenderKey(uint64_t key, uint64_t value) {
+        return key ^ (value + 0x9e3779b97f4a7c15ULL + (key << 6) + (key >> 2));
+    }
+    
+    // Un objet animé est mis à jour à chaque frame par la boucle de son pool
+    void setAnimating(bool animating);
+    
+    // Demande un appel à update() dans delayMicros (objets du store seulement,
+    // les autres sont mis à jour à chaque frame)
+    void scheduleUpdate(uint64_t delayMicros);
     ofVec2f localToGlobal(ofVec2f localPos) const;
     
     // Dessin de base
     virtual void drawBackground();
     virtual void drawBorder();
     virtual void drawLabel();
+    ofRectangle getLabelBounds() const;
+    virtual ofColor getBackgroundColor() const;
+    
+    // Équivalents groupés du dessin de base
+    void batchBackground(PdPrimitiveBatch& batch) const;
+    void batchBorder(PdPrimitiveBatch& batch) const;
+    void batchLabel(PdPrimitiveBatch& batch) const;
     
     // Constantes de style
     static const ofColor DEFAULT_BG_COLOR;
@@ -125,4 +234,17 @@ protected:
 private:
     // Méthodes privées
     void updateMouseState(ofVec2f mousePos);
+    void setBounds(ofVec2f newPosition, ofVec2f newSize);
+    
+    // Recopie valeur, bornes et drapeaux dans les tableaux du store
+    void publishHotState();
+    
+    PdWidgetHandle storeHandle;
+    
+    // Clé de rendu du dernier marquage
+    uint64_t renderKey;
+    
+    // Entrée dans PdValueSmoother, -1 hors lissage
+    int smootherEntry;
+    friend class PdValueSmoother;
 };
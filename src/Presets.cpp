@@ -0,0 +1,255 @@
+//
+//  Presets.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#include "Presets.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+static const char PRESET_MAGIC[4] = { 'P', 'D', 'P', 'R' };
+static const uint32_t PRESET_BYTE_ORDER = 0x01020304;
+
+string PdPresetBank::getPresetPath(const string& patchPath) {
+    return patchPath + "presets";
+}
+
+void PdPresetBank::reset() {
+    file.close();
+    symbols.clear();
+    columnOfSymbol.clear();
+    ownedValues.clear();
+    values = nullptr;
+    numSlots = 0;
+}
+
+bool PdPresetBank::load(const string& presetPath) {
+    reset();
+    path = presetPath;
+    if (!ofFile::doesFileExist(path)) return true;
+    if (!file.open(path)) return false;
+    
+    PdPresetFileHeader header;
+    if (file.size() < sizeof(header)) {
+        ofLogError("PdPresetBank") << "Invalid preset file: " << path;
+        reset();
+        return false;
+    }
+    memcpy(&header, file.getData(), sizeof(header));
+    
+    size_t namesSize = (header.namesSize + 3) & ~(size_t)3;
+    size_t expectedSize = sizeof(header) + namesSize + (size_t)header.numSymbols * header.numSlots * sizeof(float);
+    if (memcmp(header.magic, PRESET_MAGIC, sizeof(PRESET_MAGIC)) != 0 ||
+        header.version != VERSION ||
+        header.byteOrder != PRESET_BYTE_ORDER ||
+        file.size() != expectedSize) {
+        ofLogError("PdPresetBank") << "Invalid preset file: " << path;
+        reset();
+        return false;
+    }
+    
+    // Les identifiants des symboles ne valent que pour ce processus : noms internés ici
+    const char* name = file.getData() + sizeof(header);
+    const char* namesEnd = name + header.namesSize;
+    PdSymbolTable& symbolTable = PdSymbolTable::get();
+    for (uint32_t i = 0; i < header.numSymbols; i++) {
+        size_t length = strnlen(name, namesEnd - name);
+        if (name + length >= namesEnd) {
+            ofLogError("PdPresetBank") << "Truncated symbol table: " << path;
+            reset();
+            return false;
+        }
+        addColumn(symbolTable.intern(std::string_view(name, length)));
+        name += length + 1;
+    }
+    
+    numSlots = header.numSlots;
+    values = reinterpret_cast<const float*>(file.getData() + sizeof(header) + namesSize);
+    ofLogNotice("PdPresetBank") << "Loaded " << numSlots << " presets of " << symbols.size() << " symbols from " << path;
+    return true;
+}
+
+bool PdPresetBank::save() {
+    if (path.empty()) return false;
+    makeOwned();
+    
+    PdPresetFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, PRESET_MAGIC, sizeof(PRESET_MAGIC));
+    header.version = VERSION;
+    header.byteOrder = PRESET_BYTE_ORDER;
+    header.numSymbols = (uint32_t)symbols.size();
+    header.numSlots = (uint32_t)numSlots;
+    
+    string names;
+    const PdSymbolTable& symbolTable = PdSymbolTable::get();
+    for (PdSymbolId symbolId : symbols) {
+        names += symbolTable.getName(symbolId);
+        names += '\0';
+    }
+    header.namesSize = (uint32_t)names.size();
+    names.resize((names.size() + 3) & ~(size_t)3, '\0');
+    
+    // Écrire à côté puis renommer, comme le cache des patchs
+    string fullPath = ofToDataPath(path, true);
+    string tempPath = fullPath + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(names.data(), names.size());
+        out.write(reinterpret_cast<const char*>(values), numSlots * symbols.size() * sizeof(float));
+        if (!out) {
+            ofLogError("PdPresetBank") << "Cannot write presets: " << tempPath;
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+    
+    // La projection de l'ancien fichier n'est plus utilisée (valeurs possédées)
+    file.close();
+    if (std::rename(tempPath.c_str(), fullPath.c_str()) != 0) {
+        ofLogError("PdPresetBank") << "Cannot replace presets: " << fullPath;
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+void PdPresetBank::makeOwned() {
+    if (!ownedValues.empty() || !values) return;
+    ownedValues.assign(values, values + numSlots * symbols.size());
+    values = ownedValues.data();
+    file.close();
+}
+
+int32_t PdPresetBank::findColumn(PdSymbolId symbolId) const {
+    return symbolId < columnOfSymbol.size() ? columnOfSymbol[symbolId] : -1;
+}
+
+int32_t PdPresetBank::addColumn(PdSymbolId symbolId) {
+    if (symbolId >= columnOfSymbol.size()) {
+        columnOfSymbol.resize(symbolId + 1, -1);
+    }
+    if (columnOfSymbol[symbolId] < 0) {
+        columnOfSymbol[symbolId] = (int32_t)symbols.size();
+        symbols.push_back(symbolId);
+    }
+    return columnOfSymbol[symbolId];
+}
+
+void PdPresetBank::capture(size_t slot, const std::vector<PdGuiObject*>& objects) {
+    makeOwned();
+    
+    // Nouveaux symboles : une colonne de plus, absente des presets existants
+    size_t oldColumns = symbols.size();
+    for (PdGuiObject* object : objects) {
+        if (isPresetObject(*object)) addColumn(getPresetSymbol(*object));
+    }
+    size_t numColumns = symbols.size();
+    
+    if (numColumns != oldColumns) {
+        std::vector<float> widened(numSlots * numColumns, NAN);
+        for (size_t s = 0; s < numSlots; s++) {
+            std::copy(ownedValues.begin() + s * oldColumns, ownedValues.begin() + (s + 1) * oldColumns,
+                      widened.begin() + s * numColumns);
+        }
+        ownedValues.swap(widened);
+    }
+    
+    if (slot >= numSlots) {
+        numSlots = slot + 1;
+        ownedValues.resize(numSlots * numColumns, NAN);
+    }
+    values = ownedValues.data();
+    
+    float* row = ownedValues.data() + slot * numColumns;
+    std::fill(row, row + numColumns, NAN);
+    for (PdGuiObject* object : objects) {
+        if (isPresetObject(*object)) {
+            row[columnOfSymbol[getPresetSymbol(*object)]] = object->getValue();
+        }
+    }
+}
+
+bool PdPresetBank::isPresetObject(const PdGuiObject& object) {
+    switch (object.getType()) {
+        case GuiType::HORIZONTAL_SLIDER:
+        case GuiType::VERTICAL_SLIDER:
+        case GuiType::TOGGLE:
+        case GuiType::NUMBER_BOX:
+            return getPresetSymbol(object) != PD_EMPTY_SYMBOL;
+        default:
+            return false;
+    }
+}
+
+PdSymbolId PdPresetBank::getPresetSymbol(const PdGuiObject& object) {
+    PdSymbolId send = object.getSendSymbolId();
+    return send != PD_EMPTY_SYMBOL ? send : object.getReceiveSymbolId();
+}
+
+size_t PdPresetRecall::apply(const PdPresetBank& bank, size_t from, size_t to, float t,
+                             const std::vector<PdGuiObject*>& objects, PdSendQueue& sendQueue) {
+    if (!bank.hasSlot(from) || !bank.hasSlot(to)) return 0;
+    
+    // Objets présents dans la banque et leur colonne
+    targets.clear();
+    columns.clear();
+    discrete.clear();
+    for (PdGuiObject* object : objects) {
+        if (!PdPresetBank::isPresetObject(*object)) continue;
+        int32_t column = bank.findColumn(PdPresetBank::getPresetSymbol(*object));
+        if (column < 0) continue;
+        
+        targets.push_back(object);
+        columns.push_back((uint32_t)column);
+        discrete.push_back(object->getType() == GuiType::TOGGLE);
+    }
+    
+    size_t count = targets.size();
+    fromValues.resize(count);
+    toValues.resize(count);
+    results.resize(count);
+    
+    const float* fromRow = bank.getSlot(from);
+    const float* toRow = bank.getSlot(to);
+    for (size_t i = 0; i < count; i++) {
+        fromValues[i] = fromRow[columns[i]];
+        toValues[i] = toRow[columns[i]];
+    }
+    
+    // Passe sans branche ni appel : vectorisée par le compilateur. Un symbole
+    // absent d'un des deux presets prend la valeur de l'autre.
+    const float* __restrict a = fromValues.data();
+    const float* __restrict b = toValues.data();
+    const uint8_t* __restrict isDiscrete = discrete.data();
+    float* __restrict result = results.data();
+    bool second = t >= 0.5f;
+    
+    for (size_t i = 0; i < count; i++) {
+        float va = a[i] == a[i] ? a[i] : b[i];
+        float vb = b[i] == b[i] ? b[i] : va;
+        float mixed = va + (vb - va) * t;
+        float stepped = second ? vb : va;
+        result[i] = isDiscrete[i] ? stepped : mixed;
+    }
+    
+    // Seuls les objets dont la valeur change sont marqués sales et envoyés
+    size_t numChanged = 0;
+    for (size_t i = 0; i < count; i++) {
+        float value = result[i];
+        PdGuiObject& object = *targets[i];
+        if (std::isnan(value) || value == object.getValue()) continue;
+        
+        object.setValue(value);
+        if (object.getSendSymbolId() != PD_EMPTY_SYMBOL) {
+            sendQueue.send(object.getSendSymbolId(), object.getValue(), object.getSendPolicy());
+        }
+        numChanged++;
+    }
+    return numChanged;
+}
@@ -0,0 +1,99 @@
+//
+//  Presets.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "PdGuiObject.h"
+#include "MappedFile.h"
+#include "SendQueue.h"
+#include "Symbol.h"
+#include <cstdint>
+#include <vector>
+
+// En-tête du fichier de presets, suivi des noms des symboles (séparés par
+// des zéros, complétés à 4 octets) puis de numSlots rangées de numSymbols
+// floats. NaN : symbole absent de ce preset.
+struct PdPresetFileHeader {
+    char magic[4];        // "PDPR"
+    uint32_t version;
+    uint32_t byteOrder;   // 0x01020304 dans l'ordre de la machine qui l'a écrit
+    uint32_t numSymbols;
+    uint32_t numSlots;
+    uint32_t namesSize;
+    uint32_t reserved[2];
+};
+
+static_assert(sizeof(PdPresetFileHeader) == 32, "PdPresetFileHeader layout changed");
+
+// Instantanés des valeurs de tous les objets, une colonne par symbole (send,
+// sinon receive) : un preset survit aux déplacements et aux rechargements du
+// patch. Le fichier est projeté en mémoire et lu sans copie ; une capture
+// copie les valeurs puis réécrit le fichier.
+class PdPresetBank {
+public:
+    static constexpr uint32_t VERSION = 1;
+    
+    // patch.pd -> patch.pdpresets
+    static string getPresetPath(const string& patchPath);
+    
+    // Fichier absent : banque vide, créée à la première capture
+    bool load(const string& path);
+    bool save();
+    
+    // Valeurs actuelles des objets dans un preset (remplacé)
+    void capture(size_t slot, const std::vector<PdGuiObject*>& objects);
+    
+    size_t getNumSlots() const { return numSlots; }
+    size_t getNumSymbols() const { return symbols.size(); }
+    bool hasSlot(size_t slot) const { return slot < numSlots; }
+    const float* getSlot(size_t slot) const { return values + slot * symbols.size(); }
+    
+    // Colonne d'un symbole, -1 s'il n'est dans aucun preset
+    int32_t findColumn(PdSymbolId symbolId) const;
+    
+    // Objets qui ont une valeur de preset (toggle, sliders, number box) et leur symbole
+    static bool isPresetObject(const PdGuiObject& object);
+    static PdSymbolId getPresetSymbol(const PdGuiObject& object);
+
+private:
+    string path;
+    PdMappedFile file;
+    
+    std::vector<PdSymbolId> symbols;     // Symbole de chaque colonne
+    std::vector<int32_t> columnOfSymbol; // Indexé par PdSymbolId
+    size_t numSlots = 0;
+    
+    // Valeurs dans le fichier projeté, ou copie possédée après une capture
+    const float* values = nullptr;
+    std::vector<float> ownedValues;
+    
+    void reset();
+    void makeOwned();
+    int32_t addColumn(PdSymbolId symbolId);
+};
+
+// Rappel d'un preset, ou mélange de deux, sur un ensemble d'objets : lecture
+// des colonnes, interpolation en une passe sans branche sur des tableaux
+// contigus, puis application des seules valeurs qui changent. Les envois vers
+// Pd passent par la file sortante (fusionnés par symbole, publiés en un lot).
+class PdPresetRecall {
+public:
+    // t = 0 : preset from, t = 1 : preset to. Les toggles basculent à mi-course.
+    // Retourne le nombre d'objets modifiés.
+    size_t apply(const PdPresetBank& bank, size_t from, size_t to, float t,
+                 const std::vector<PdGuiObject*>& objects, PdSendQueue& sendQueue);
+
+private:
+    // Tableaux réutilisés d'un rappel à l'autre
+    std::vector<PdGuiObject*> targets;
+    std::vector<uint32_t> columns;
+    std::vector<uint8_t> discrete;
+    std::vector<float> fromValues;
+    std::vector<float> toValues;
+    std::vector<float> results;
+};
@@ -0,0 +1,265 @@
+//
+//  PrimitiveBatch.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 18/07/2025.
+//
+
+#include "PrimitiveBatch.h"
+#include "Profiler.h"
+
+const int PdPrimitiveBatch::CIRCLE_RESOLUTION = 20;
+
+PdPrimitiveBatch::PdPrimitiveBatch()
+    : origin(0, 0)
+    , numDrawCalls(0)
+    , numVertices(0)
+    , hasOverflow(false)
+{
+    textBounds.reserve(MAX_TEXT_BOUNDS);
+    mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+    mesh.setUsage(GL_STREAM_DRAW);
+    
+    unitCircle.reserve(CIRCLE_RESOLUTION + 1);
+    for (int i = 0; i <= CIRCLE_RESOLUTION; i++) {
+        float angle = TWO_PI * i / CIRCLE_RESOLUTION;
+        unitCircle.push_back(ofVec2f(cos(angle), sin(angle)));
+    }
+}
+
+void PdPrimitiveBatch::begin() {
+    clearMeshes();
+    origin = ofVec2f(0, 0);
+}
+
+void PdPrimitiveBatch::clearMeshes() {
+    // clear() garde la capacité des vecteurs : pas de réallocation d'une frame à l'autre
+    mesh.clear();
+    for (auto& group : textGroups) {
+        group.mesh.clear();
+    }
+    textBounds.clear();
+    hasOverflow = false;
+}
+
+void PdPrimitiveBatch::draw() {
+    numDrawCalls = 0;
+    numVertices = 0;
+    submit();
+    begin();
+}
+
+void PdPrimitiveBatch::submit() {
+    size_t submittedCalls = 0;
+    
+    if (mesh.getNumVertices() > 0) {
+        numVertices += mesh.getNumVertices();
+        mesh.draw();
+        submittedCalls++;
+    }
+    
+    for (auto& group : textGroups) {
+        if (group.mesh.getNumVertices() == 0) continue;
+        
+        numVertices += group.mesh.getNumVertices();
+        group.texture->bind();
+        group.mesh.draw();
+        group.texture->unbind();
+        submittedCalls++;
+    }
+    
+    numDrawCalls += submittedCalls;
+    PdProfiler::get().addCount(PdProfileCounter::DRAW_CALLS, submittedCalls);
+    clearMeshes();
+}
+
+void PdPrimitiveBatch::beginGeometry(float x1, float y1, float x2, float y2) {
+    if (textBounds.empty()) return;
+    
+    // Textes dessinés après la géométrie : les envoyer avant ce qui les recouvre
+    auto overlaps = [&](const ofRectangle& r) {
+        return x1 < r.getRight() && x2 > r.x && y1 < r.getBottom() && y2 > r.y;
+    };
+    
+    bool covered = hasOverflow && overlaps(overflowBounds);
+    for (size_t i = 0; i < textBounds.size() && !covered; i++) {
+        covered = overlaps(textBounds[i]);
+    }
+    if (covered) {
+        submit();
+    }
+}
+
+bool PdPrimitiveBatch::isEmpty() const {
+    if (mesh.getNumVertices() > 0) return false;
+    
+    for (const auto& group : textGroups) {
+        if (group.mesh.getNumVertices() > 0) return false;
+    }
+    return true;
+}
+
+void PdPrimitiveBatch::addRect(float x, float y, float w, float h, const ofColor& color) {
+    float x1 = origin.x + x;
+    float y1 = origin.y + y;
+    addQuad(x1, y1, x1 + w, y1 + h, color);
+}
+
+void PdPrimitiveBatch::addRectOutline(float x, float y, float w, float h, const ofColor& color) {
+    ofFloatColor c = color;
+    float x1 = origin.x + x;
+    float y1 = origin.y + y;
+    float x2 = x1 + w;
+    float y2 = y1 + h;
+    
+    // Mêmes pixels qu'un ofDrawRectangle en ofNoFill() : colonnes x1 et x2, lignes y1 et y2
+    addQuad(x1, y1, x2 + 1, y1 + 1, c);
+    addQuad(x1, y2, x2 + 1, y2 + 1, c);
+    addQuad(x1, y1 + 1, x1 + 1, y2, c);
+    addQuad(x2, y1 + 1, x2 + 1, y2, c);
+}
+
+void PdPrimitiveBatch::addCircle(float cx, float cy, float radius, const ofColor& color) {
+    ofFloatColor c = color;
+    float x = origin.x + cx;
+    float y = origin.y + cy;
+    beginGeometry(x - radius, y - radius, x + radius, y + radius);
+    
+    // Éventail de triangles, émis en triangles indépendants pour rester dans un seul maillage
+    for (int i = 0; i < CIRCLE_RESOLUTION; i++) {
+        addVertex(x, y, c);
+        addVertex(x + unitCircle[i].x * radius, y + unitCircle[i].y * radius, c);
+        addVertex(x + unitCircle[i + 1].x * radius, y + unitCircle[i + 1].y * radius, c);
+    }
+}
+
+void PdPrimitiveBatch::addCircleOutline(float cx, float cy, float radius, const ofColor& color) {
+    ofFloatColor c = color;
+    float x = origin.x + cx;
+    float y = origin.y + cy;
+    float inner = max(0.0f, radius - 0.5f);
+    float outer = radius + 0.5f;
+    beginGeometry(x - outer, y - outer, x + outer, y + outer);
+    
+    // Anneau d'un pixel d'épaisseur
+    for (int i = 0; i < CIRCLE_RESOLUTION; i++) {
+        const ofVec2f& a = unitCircle[i];
+        const ofVec2f& b = unitCircle[i + 1];
+        
+        addVertex(x + a.x * inner, y + a.y * inner, c);
+        addVertex(x + a.x * outer, y + a.y * outer, c);
+        addVertex(x + b.x * outer, y + b.y * outer, c);
+        
+        addVertex(x + a.x * inner, y + a.y * inner, c);
+        addVertex(x + b.x * outer, y + b.y * outer, c);
+        addVertex(x + b.x * inner, y + b.y * inner, c);
+    }
+}
+
+void PdPrimitiveBatch::addLine(float x1, float y1, float x2, float y2, const ofColor& color) {
+    ofFloatColor c = color;
+    float ax = origin.x + x1;
+    float ay = origin.y + y1;
+    float bx = origin.x + x2;
+    float by = origin.y + y2;
+    
+    // Quad d'un pixel de large le long de la normale du segment
+    float dx = bx - ax;
+    float dy = by - ay;
+    float length = sqrt(dx * dx + dy * dy);
+    if (length <= 0.0f) return;
+    beginGeometry(min(ax, bx) - 0.5f, min(ay, by) - 0.5f, max(ax, bx) + 0.5f, max(ay, by) + 0.5f);
+    
+    float nx = -dy / length * 0.5f;
+    float ny = dx / length * 0.5f;
+    
+    addVertex(ax + nx, ay + ny, c);
+    addVertex(bx + nx, by + ny, c);
+    addVertex(bx - nx, by - ny, c);
+    
+    addVertex(ax + nx, ay + ny, c);
+    addVertex(bx - nx, by - ny, c);
+    addVertex(ax - nx, ay - ny, c);
+}
+
+void PdPrimitiveBatch::addText(const PdTextLabel& label, float x, float y, const ofColor& color) {
+    if (label.empty()) return;
+    
+    const ofTexture* texture = label.getTexture();
+    const ofMesh& glyphs = label.getMesh();
+    
+    // Un maillage par atlas (en pratique une ou deux tailles de police)
+    TextGroup* group = nullptr;
+    for (auto& g : textGroups) {
+        if (g.texture == texture) {
+            group = &g;
+            break;
+        }
+    }
+    if (!group) {
+        textGroups.push_back(TextGroup());
+        group = &textGroups.back();
+        group->texture = texture;
+        group->mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+        group->mesh.setUsage(GL_STREAM_DRAW);
+    }
+    
+    // Copie des quads déjà mis en forme : aucune mise en page ici
+    ofFloatColor c = color;
+    float ox = origin.x + x;
+    float oy = origin.y + y;
+    const auto& vertices = glyphs.getVertices();
+    const auto& texCoords = glyphs.getTexCoords();
+    const auto& indices = glyphs.getIndices();
+    
+    auto append = [&](size_t i) {
+        group->mesh.addVertex(glm::vec3(vertices[i].x + ox, vertices[i].y + oy, 0));
+        group->mesh.addTexCoord(texCoords[i]);
+        group->mesh.addColor(c);
+    };
+    
+    if (indices.empty()) {
+        for (size_t i = 0; i < vertices.size(); i++) append(i);
+    } else {
+        for (unsigned int index : indices) append(index);
+    }
+    
+    // Zone couverte par les textes en attente (quads des glyphes)
+    if (vertices.empty()) return;
+    float minX = vertices[0].x, maxX = vertices[0].x;
+    float minY = vertices[0].y, maxY = vertices[0].y;
+    for (const auto& v : vertices) {
+        minX = min(minX, v.x);
+        maxX = max(maxX, v.x);
+        minY = min(minY, v.y);
+        maxY = max(maxY, v.y);
+    }
+    ofRectangle bounds(ox + minX, oy + minY, maxX - minX, maxY - minY);
+    if (textBounds.size() < MAX_TEXT_BOUNDS) {
+        textBounds.push_back(bounds);
+    } else if (hasOverflow) {
+        overflowBounds.growToInclude(bounds);
+    } else {
+        overflowBounds = bounds;
+        hasOverflow = true;
+    }
+}
+
+void PdPrimitiveBatch::addQuad(float x1, float y1, float x2, float y2, const ofFloatColor& color) {
+    // Contours testés côté par côté : la bordure d'une boîte ne coupe pas
+    // le lot sur le texte qu'elle entoure
+    beginGeometry(x1, y1, x2, y2);
+    
+    addVertex(x1, y1, color);
+    addVertex(x2, y1, color);
+    addVertex(x2, y2, color);
+    
+    addVertex(x1, y1, color);
+    addVertex(x2, y2, color);
+    addVertex(x1, y2, color);
+}
+
+void PdPrimitiveBatch::addVertex(float x, float y, const ofFloatColor& color) {
+    mesh.addVertex(glm::vec3(x, y, 0));
+    mesh.addColor(color);
+}
@@ -0,0 +1,79 @@
+//
+//  PrimitiveBatch.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 18/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "TextRenderer.h"
+#include <vector>
+#include <string>
+
+// Tampon de primitives partagé par tous les objets GUI d'une frame.
+// Les objets y ajoutent rectangles, lignes, cercles et textes colorés.
+// Les contours et lignes sont émis comme des quads d'un pixel dans le même
+// maillage de triangles que les remplissages : l'ordre de dessin est conservé
+// et toute la géométrie part en un seul appel, suivie des textes regroupés
+// par texture d'atlas de glyphes (un appel par atlas). Une primitive qui
+// recouvre un texte déjà ajouté coupe le lot à cet endroit : ce qui précède
+// part d'abord, et l'objet du dessus cache bien le label de celui du dessous
+// (ordre du peintre de Pd).
+class PdPrimitiveBatch {
+public:
+    PdPrimitiveBatch();
+    
+    // Cycle de vie
+    void begin();
+    void draw();
+    bool isEmpty() const;
+    
+    // Origine appliquée aux primitives suivantes (position de l'objet)
+    void setOrigin(ofVec2f origin) { this->origin = origin; }
+    ofVec2f getOrigin() const { return origin; }
+    
+    // Primitives, en coordonnées locales à l'origine
+    void addRect(float x, float y, float w, float h, const ofColor& color);
+    void addRectOutline(float x, float y, float w, float h, const ofColor& color);
+    void addCircle(float cx, float cy, float radius, const ofColor& color);
+    void addCircleOutline(float cx, float cy, float radius, const ofColor& color);
+    void addLine(float x1, float y1, float x2, float y2, const ofColor& color);
+    void addText(const PdTextLabel& label, float x, float y, const ofColor& color);
+    
+    // Statistiques de la dernière soumission (draw() et ses coupures)
+    size_t getNumDrawCalls() const { return numDrawCalls; }
+    size_t getNumVertices() const { return numVertices; }
+    
+private:
+    struct TextGroup {
+        const ofTexture* texture;
+        ofVboMesh mesh;
+    };
+    
+    ofVboMesh mesh;
+    std::vector<TextGroup> textGroups;
+    
+    ofVec2f origin;
+    size_t numDrawCalls;
+    size_t numVertices;
+    
+    // Zones des textes en attente, en coordonnées absolues. Au-delà de
+    // MAX_TEXT_BOUNDS, les suivantes sont fusionnées dans overflowBounds.
+    static constexpr size_t MAX_TEXT_BOUNDS = 32;
+    std::vector<ofRectangle> textBounds;
+    ofRectangle overflowBounds;
+    bool hasOverflow;
+    
+    // Table de cercle unitaire (même résolution que ofSetCircleResolution par défaut)
+    static const int CIRCLE_RESOLUTION;
+    std::vector<ofVec2f> unitCircle;
+    
+    void submit();
+    void clearMeshes();
+    // Avant chaque primitive : coupe le lot si elle recouvre un texte en attente
+    void beginGeometry(float x1, float y1, float x2, float y2);
+    void addQuad(float x1, float y1, float x2, float y2, const ofFloatColor& color);
+    void addVertex(float x, float y, const ofFloatColor& color);
+};
@@ -0,0 +1,245 @@
+//
+//  Profiler.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 24/07/2025.
+//
+
+#include "Profiler.h"
+#include <cstdio>
+
+PdProfiler& PdProfiler::get() {
+    // Le thread du premier appel (setup) devient le thread mesuré
+    static PdProfiler profiler;
+    return profiler;
+}
+
+PdProfiler::PdProfiler()
+    : ownerThread(std::this_thread::get_id())
+    , frameIndex(0)
+    , frameStart(0)
+    , historyHead(0)
+    , historyCount(0)
+    , recording(false)
+{
+}
+
+void PdProfiler::beginFrame() {
+    frameStart = ofGetElapsedTimeMicros();
+}
+
+void PdProfiler::endFrame() {
+    uint64_t now = ofGetElapsedTimeMicros();
+    
+    current.frameIndex = frameIndex++;
+    current.startMicros = frameStart;
+    current.durationMicros = now - frameStart;
+    
+    history[historyHead] = current;
+    historyHead = (historyHead + 1) % HISTORY_SIZE;
+    historyCount = std::min(historyCount + 1, HISTORY_SIZE);
+    
+    if (recording) {
+        // Seule allocation possible : croissance des vecteurs d'enregistrement, une fois par frame
+        recordedFrames.push_back(current);
+        traceEvents.consumeAll([this](const PdTraceEvent& event) {
+            recordedEvents.push_back(event);
+        });
+    } else {
+        traceEvents.consumeAll([](const PdTraceEvent&) {});
+    }
+    
+    // Les événements reçus entre deux frames comptent pour la suivante
+    current = PdFrameProfile();
+    frameStart = now;
+}
+
+void PdProfiler::addTime(PdProfileSection section, uint64_t startMicros, uint64_t durationMicros) {
+    if (!isOwnerThread()) return;
+    
+    current.sectionMicros[(size_t)section] += (uint32_t)durationMicros;
+    traceEvents.push({startMicros, (uint32_t)durationMicros, section});
+}
+
+void PdProfiler::addCount(PdProfileCounter counter, uint64_t value) {
+    if (!isOwnerThread()) return;
+    
+    current.counters[(size_t)counter] += value;
+}
+
+void PdProfiler::startRecording() {
+    recordedFrames.clear();
+    recordedEvents.clear();
+    traceEvents.consumeAll([](const PdTraceEvent&) {});
+    recording = true;
+}
+
+void PdProfiler::stopRecording() {
+    recording = false;
+}
+
+const PdFrameProfile& PdProfiler::getFrame(size_t age) const {
+    size_t index = (historyHead + HISTORY_SIZE - 1 - (age % HISTORY_SIZE)) % HISTORY_SIZE;
+    return history[index];
+}
+
+bool PdProfiler::exportCsv(const string& path) const {
+    FILE* file = fopen(ofToDataPath(path).c_str(), "w");
+    if (!file) {
+        ofLogError("PdProfiler") << "Cannot write " << path;
+        return false;
+    }
+    
+    fprintf(file, "frame,start_us,duration_us");
+    for (size_t i = 0; i < PD_NUM_PROFILE_SECTIONS; i++) {
+        fprintf(file, ",%s_us", getSectionName((PdProfileSection)i));
+    }
+    for (size_t i = 0; i < PD_NUM_PROFILE_COUNTERS; i++) {
+        fprintf(file, ",%s", getCounterName((PdProfileCounter)i));
+    }
+    fprintf(file, "\n");
+    
+    for (const auto& frame : recordedFrames) {
+        fprintf(file, "%llu,%llu,%llu", (unsigned long long)frame.frameIndex,
+                (unsigned long long)frame.startMicros, (unsigned long long)frame.durationMicros);
+        for (size_t i = 0; i < PD_NUM_PROFILE_SECTIONS; i++) {
+            fprintf(file, ",%u", frame.sectionMicros[i]);
+        }
+        for (size_t i = 0; i < PD_NUM_PROFILE_COUNTERS; i++) {
+            fprintf(file, ",%llu", (unsigned long long)frame.counters[i]);
+        }
+        fprintf(file, "\n");
+    }
+    
+    fclose(file);
+    ofLogNotice("PdProfiler") << "Exported " << recordedFrames.size() << " frames to " << path;
+    return true;
+}
+
+bool PdProfiler::exportChromeTrace(const string& path) const {
+    FILE* file = fopen(ofToDataPath(path).c_str(), "w");
+    if (!file) {
+        ofLogError("PdProfiler") << "Cannot write " << path;
+        return false;
+    }
+    
+    // Format "Trace Event" : intervalles complets (ph X) et compteurs (ph C)
+    fprintf(file, "{\"traceEvents\":[\n");
+    bool first = true;
+    
+    for (const auto& event : recordedEvents) {
+        fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"pd-gui\",\"ph\":\"X\",\"ts\":%llu,\"dur\":%u,\"pid\":1,\"tid\":1}",
+                first ? "" : ",\n", getSectionName(event.section),
+                (unsigned long long)event.startMicros, event.durationMicros);
+        first = false;
+    }
+    
+    for (const auto& frame : recordedFrames) {
+        fprintf(file, "%s{\"name\":\"frame\",\"cat\":\"pd-gui\",\"ph\":\"C\",\"ts\":%llu,\"pid\":1,\"args\":{",
+                first ? "" : ",\n", (unsigned long long)frame.startMicros);
+        for (size_t i = 0; i < PD_NUM_PROFILE_COUNTERS; i++) {
+            fprintf(file, "%s\"%s\":%llu", i == 0 ? "" : ",", getCounterName((PdProfileCounter)i),
+                    (unsigned long long)frame.counters[i]);
+        }
+        fprintf(file, "}}");
+        first = false;
+    }
+    
+    fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    fclose(file);
+    ofLogNotice("PdProfiler") << "Exported " << recordedEvents.size() << " trace events to " << path;
+    return true;
+}
+
+void PdProfiler::drawOverlay(PdPrimitiveBatch& batch, float x, float y, float width, float height) {
+    batch.setOrigin(ofVec2f(x, y));
+    batch.addRect(0, 0, width, height, ofColor(0, 0, 0, 180));
+    
+    // Une barre empilée par frame, la plus récente à droite ; 33 ms = pleine hauteur
+    const float fullScaleMicros = 33333.0f;
+    float barWidth = width / HISTORY_SIZE;
+    uint64_t totals[PD_NUM_PROFILE_SECTIONS] = {};
+    uint64_t totalFrame = 0;
+    
+    for (size_t age = 0; age < historyCount; age++) {
+        const PdFrameProfile& frame = getFrame(age);
+        float barX = width - (age + 1) * barWidth;
+        float barY = height;
+        
+        for (size_t i = 0; i < PD_NUM_PROFILE_SECTIONS; i++) {
+            float barHeight = std::min(height, frame.sectionMicros[i] / fullScaleMicros * height);
+            barY -= barHeight;
+            if (barHeight > 0) {
+                batch.addRect(barX, barY, barWidth, barHeight, getSectionColor((PdProfileSection)i));
+            }
+            totals[i] += frame.sectionMicros[i];
+        }
+        totalFrame += frame.durationMicros;
+    }
+    
+    // Repère 16,7 ms (60 images/s)
+    batch.addLine(0, height * 0.5f, width, height * 0.5f, ofColor(255, 255, 255, 120));
+    
+    // Moyennes par sous-système, puis compteurs de la dernière frame
+    size_t numLines = PD_NUM_PROFILE_SECTIONS + PD_NUM_PROFILE_COUNTERS + 1;
+    overlayLabels.resize(numLines);
+    
+    char buffer[96];
+    double count = std::max<size_t>(1, historyCount);
+    int length = snprintf(buffer, sizeof(buffer), "frame %.2f ms", totalFrame / count / 1000.0);
+    overlayLabels[0].set(buffer, length);
+    batch.addText(overlayLabels[0], 4, 14, ofColor(255));
+    
+    for (size_t i = 0; i < PD_NUM_PROFILE_SECTIONS; i++) {
+        length = snprintf(buffer, sizeof(buffer), "%s %.2f ms", getSectionName((PdProfileSection)i),
+                          totals[i] / count / 1000.0);
+        overlayLabels[i + 1].set(buffer, length);
+        batch.addText(overlayLabels[i + 1], 4, 28 + 14 * i, getSectionColor((PdProfileSection)i));
+    }
+    
+    const PdFrameProfile& last = getFrame(0);
+    for (size_t i = 0; i < PD_NUM_PROFILE_COUNTERS; i++) {
+        length = snprintf(buffer, sizeof(buffer), "%s %llu", getCounterName((PdProfileCounter)i),
+                          historyCount ? (unsigned long long)last.counters[i] : 0ULL);
+        size_t line = PD_NUM_PROFILE_SECTIONS + 1 + i;
+        overlayLabels[line].set(buffer, length);
+        batch.addText(overlayLabels[line], width * 0.5f, 14 + 14 * i, ofColor(220));
+    }
+    
+    batch.setOrigin(ofVec2f(0, 0));
+}
+
+const char* PdProfiler::getSectionName(PdProfileSection section) {
+    switch (section) {
+        case PdProfileSection::PARSE:         return "parse";
+        case PdProfileSection::UPDATE:        return "update";
+        case PdProfileSection::EVENTS:        return "events";
+        case PdProfileSection::RENDER_DIRECT: return "render_direct";
+        case PdProfileSection::RENDER_FBO:    return "render_fbo";
+        case PdProfileSection::TEXT:          return "text";
+        default:                              return "unknown";
+    }
+}
+
+const char* PdProfiler::getCounterName(PdProfileCounter counter) {
+    switch (counter) {
+        case PdProfileCounter::MESSAGES_IN:     return "messages_in";
+        case PdProfileCounter::MESSAGES_OUT:    return "messages_out";
+        case PdProfileCounter::DIRTY_AREA:      return "dirty_area";
+        case PdProfileCounter::DRAW_CALLS:      return "draw_calls";
+        case PdProfileCounter::OBJECTS_REDRAWN: return "objects_redrawn";
+        default:                                return "unknown";
+    }
+}
+
+ofColor PdProfiler::getSectionColor(PdProfileSection section) {
+    switch (section) {
+        case PdProfileSection::PARSE:         return ofColor(200, 120, 255);
+        case PdProfileSection::UPDATE:        return ofColor(100, 200, 255);
+        case PdProfileSection::EVENTS:        return ofColor(255, 200, 80);
+        case PdProfileSection::RENDER_DIRECT: return ofColor(255, 100, 100);
+        case PdProfileSection::RENDER_FBO:    return ofColor(120, 230, 120);
+        case PdProfileSection::TEXT:          return ofColor(230, 230, 230);
+        default:                              return ofColor(128);
+    }
+}
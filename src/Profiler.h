@@ -0,0 +1,141 @@
+//
+//  Profiler.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 24/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "RingBuffer.h"
+#include "PrimitiveBatch.h"
+#include "TextRenderer.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Sous-systèmes chronométrés à chaque frame
+enum class PdProfileSection : uint8_t {
+    PARSE,
+    UPDATE,
+    EVENTS,
+    RENDER_DIRECT,
+    RENDER_FBO,
+    TEXT,
+    COUNT
+};
+
+// Compteurs cumulés sur une frame
+enum class PdProfileCounter : uint8_t {
+    MESSAGES_IN,
+    MESSAGES_OUT,
+    DIRTY_AREA,
+    DRAW_CALLS,
+    OBJECTS_REDRAWN,
+    COUNT
+};
+
+static constexpr size_t PD_NUM_PROFILE_SECTIONS = (size_t)PdProfileSection::COUNT;
+static constexpr size_t PD_NUM_PROFILE_COUNTERS = (size_t)PdProfileCounter::COUNT;
+
+struct PdFrameProfile {
+    uint64_t frameIndex = 0;
+    uint64_t startMicros = 0;
+    uint64_t durationMicros = 0;
+    uint32_t sectionMicros[PD_NUM_PROFILE_SECTIONS] = {};
+    uint64_t counters[PD_NUM_PROFILE_COUNTERS] = {};
+};
+
+// Intervalle exporté dans la trace Chrome
+struct PdTraceEvent {
+    uint64_t startMicros;
+    uint32_t durationMicros;
+    PdProfileSection section;
+};
+
+// Instrumentation des chemins chauds. Les mesures ne font ni allocation ni
+// verrou : elles vont dans la frame courante et dans des files circulaires
+// de taille fixe. L'historique récent alimente le graphe, l'enregistrement
+// (startRecording/stopRecording) accumule les frames pour l'export CSV ou
+// trace Chrome (chrome://tracing, Perfetto).
+// Seul le thread principal mesure ; les appels des autres threads sont ignorés.
+// Les threads de chargement et de surveillance chronomètrent eux-mêmes le
+// parsing et le reportent à la réception de la disposition (PARSE).
+class PdProfiler {
+public:
+    static PdProfiler& get();
+    
+    // Début et fin d'une frame (update() puis draw())
+    void beginFrame();
+    void endFrame();
+    
+    void addTime(PdProfileSection section, uint64_t startMicros, uint64_t durationMicros);
+    void addCount(PdProfileCounter counter, uint64_t value);
+    
+    // Enregistrement pour l'export
+    void startRecording();
+    void stopRecording();
+    bool isRecording() const { return recording; }
+    size_t getNumRecordedFrames() const { return recordedFrames.size(); }
+    bool exportCsv(const string& path) const;
+    bool exportChromeTrace(const string& path) const;
+    
+    // Historique : age 0 = dernière frame terminée
+    size_t getHistorySize() const { return historyCount; }
+    const PdFrameProfile& getFrame(size_t age) const;
+    
+    // Graphe empilé par sous-système et moyennes sur l'historique
+    void drawOverlay(PdPrimitiveBatch& batch, float x, float y, float width, float height);
+    
+    static const char* getSectionName(PdProfileSection section);
+    static const char* getCounterName(PdProfileCounter counter);
+    static ofColor getSectionColor(PdProfileSection section);
+    
+private:
+    PdProfiler();
+    
+    static constexpr size_t HISTORY_SIZE = 240;
+    
+    bool isOwnerThread() const { return std::this_thread::get_id() == ownerThread; }
+    
+    std::thread::id ownerThread;
+    uint64_t frameIndex;
+    uint64_t frameStart;
+    PdFrameProfile current;
+    
+    // Historique circulaire pour le graphe
+    PdFrameProfile history[HISTORY_SIZE];
+    size_t historyHead;
+    size_t historyCount;
+    
+    // Intervalles de la frame en cours, vidés à endFrame()
+    PdSpscRing<PdTraceEvent, 4096> traceEvents;
+    
+    bool recording;
+    std::vector<PdFrameProfile> recordedFrames;
+    std::vector<PdTraceEvent> recordedEvents;
+    
+    // Textes du graphe
+    std::vector<PdTextLabel> overlayLabels;
+};
+
+// Chronomètre le bloc courant
+class PdProfileScope {
+public:
+    explicit PdProfileScope(PdProfileSection section)
+        : section(section), start(ofGetElapsedTimeMicros()) {}
+    
+    ~PdProfileScope() {
+        PdProfiler::get().addTime(section, start, ofGetElapsedTimeMicros() - start);
+    }
+    
+    PdProfileScope(const PdProfileScope&) = delete;
+    PdProfileScope& operator=(const PdProfileScope&) = delete;
+    
+private:
+    PdProfileSection section;
+    uint64_t start;
+};
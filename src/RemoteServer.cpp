@@ -0,0 +1,337 @@
+//
+//  RemoteServer.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#include "RemoteServer.h"
+#include "PatchCache.h"
+#include "FrameClock.h"
+#include <cstring>
+
+PdRemoteServer::PdRemoteServer() : numClients(0) {
+}
+
+PdRemoteServer::~PdRemoteServer() {
+    stop();
+}
+
+bool PdRemoteServer::start(int port) {
+    if (isThreadRunning()) {
+        return true;
+    }
+    
+    if (!server.setup(port, false)) {
+        ofLogError("PdRemoteServer") << "Cannot listen on port " << port;
+        return false;
+    }
+    
+    ofLogNotice("PdRemoteServer") << "Listening on port " << port;
+    startThread();
+    return true;
+}
+
+void PdRemoteServer::stop() {
+    if (!isThreadRunning()) {
+        return;
+    }
+    
+    stopThread();
+    waitForThread(false);
+    server.close();
+    clients.clear();
+    numClients.store(0, std::memory_order_relaxed);
+}
+
+void PdRemoteServer::publishLayout(size_t view, const PdPatchLayout& layout) {
+    if (!isThreadRunning() || view > 0xff) {
+        return;
+    }
+    
+    // Sérialisé ici : la disposition peut changer dès la frame suivante
+    auto data = std::make_shared<string>();
+    PdPatchCache::serialize(layout, 0, 0, *data);
+    
+    Outgoing outgoing;
+    outgoing.view = (uint8_t)view;
+    outgoing.layout = std::move(data);
+    outbox.send(std::move(outgoing));
+}
+
+void PdRemoteServer::publishValues(size_t view, std::vector<PdRemoteValue>& values) {
+    if (!isThreadRunning() || view > 0xff || values.empty()) {
+        return;
+    }
+    
+    Outgoing outgoing;
+    outgoing.view = (uint8_t)view;
+    outgoing.values = std::move(values);
+    outbox.send(std::move(outgoing));
+    
+    // Reprendre un tampon déjà alloué ; vide au premier lot seulement
+    values = std::vector<PdRemoteValue>();
+    spareValues.tryReceive(values);
+}
+
+void PdRemoteServer::threadedFunction() {
+    Outgoing outgoing;
+    
+    while (isThreadRunning()) {
+        // Attente courte : les clients doivent aussi être lus sans envoi
+        if (outbox.tryReceive(outgoing, POLL_MILLIS)) {
+            apply(outgoing);
+            recycle(outgoing);
+            while (outbox.tryReceive(outgoing)) {
+                apply(outgoing);
+                recycle(outgoing);
+            }
+        }
+        
+        updateClients();
+    }
+}
+
+void PdRemoteServer::apply(Outgoing& outgoing) {
+    if (outgoing.view >= viewStates.size()) {
+        viewStates.resize(outgoing.view + 1);
+    }
+    ViewState& state = viewStates[outgoing.view];
+    
+    if (outgoing.layout) {
+        PdPatchCacheHeader header;
+        memcpy(&header, outgoing.layout->data(), sizeof(header));
+        state.layout = std::move(outgoing.layout);
+        state.values.assign(header.numWidgets, 0.0f);
+        
+        frame.clear();
+        size_t start = beginFrame(frame, FRAME_LAYOUT, outgoing.view);
+        frame += *state.layout;
+        endFrame(frame, start);
+        broadcast(frame);
+        return;
+    }
+    
+    // Valeurs d'une disposition précédente ou pas encore connue : ignorées
+    std::vector<PdRemoteValue>& values = outgoing.values;
+    values.erase(std::remove_if(values.begin(), values.end(), [&](const PdRemoteValue& v) {
+        return v.widget >= state.values.size();
+    }), values.end());
+    if (values.empty()) {
+        return;
+    }
+    
+    for (const PdRemoteValue& v : values) {
+        state.values[v.widget] = v.value;
+    }
+    
+    if (numClients.load(std::memory_order_relaxed) > 0) {
+        frame.clear();
+        size_t start = beginFrame(frame, FRAME_VALUES, outgoing.view);
+        encodeValues(frame, values);
+        endFrame(frame, start);
+        broadcast(frame);
+    }
+}
+
+void PdRemoteServer::recycle(Outgoing& outgoing) {
+    // Un lot de valeurs rend son tampon, une disposition n'en a pas
+    if (outgoing.values.capacity() == 0) return;
+    outgoing.values.clear();
+    spareValues.send(std::move(outgoing.values));
+    outgoing.values = std::vector<PdRemoteValue>();
+}
+
+void PdRemoteServer::updateClients() {
+    int lastId = server.getLastID();
+    if ((int)clients.size() < lastId) {
+        clients.resize(lastId);
+    }
+    
+    int connected = 0;
+    for (int id = 0; id < lastId; id++) {
+        Client& client = clients[id];
+        
+        if (!server.isClientConnected(id)) {
+            if (client.connected) {
+                ofLogNotice("PdRemoteServer") << "Client " << id << " disconnected";
+                client = Client();
+            }
+            continue;
+        }
+        
+        if (!client.connected) {
+            ofLogNotice("PdRemoteServer") << "Client " << id << " connected";
+            client.connected = true;
+            welcome(id);
+        }
+        
+        receive(id, client);
+        if (client.connected) {
+            connected++;
+        }
+    }
+    
+    numClients.store(connected, std::memory_order_relaxed);
+}
+
+void PdRemoteServer::welcome(int clientId) {
+    for (size_t view = 0; view < viewStates.size(); view++) {
+        const ViewState& state = viewStates[view];
+        if (!state.layout) {
+            continue;
+        }
+        
+        frame.clear();
+        size_t start = beginFrame(frame, FRAME_LAYOUT, (uint8_t)view);
+        frame += *state.layout;
+        endFrame(frame, start);
+        
+        allValues.clear();
+        for (size_t i = 0; i < state.values.size(); i++) {
+            allValues.push_back({(uint32_t)i, state.values[i]});
+        }
+        if (!allValues.empty()) {
+            size_t valuesStart = beginFrame(frame, FRAME_VALUES, (uint8_t)view);
+            encodeValues(frame, allValues);
+            endFrame(frame, valuesStart);
+        }
+        
+        server.sendRawBytes(clientId, frame.data(), (int)frame.size());
+    }
+}
+
+void PdRemoteServer::receive(int clientId, Client& client) {
+    char buffer[4096];
+    int received;
+    while ((received = server.receiveRawBytes(clientId, buffer, sizeof(buffer))) > 0) {
+        client.received.append(buffer, received);
+    }
+    
+    // Trames complètes : longueur u32, puis type, vue et contenu
+    size_t offset = 0;
+    while (client.received.size() - offset >= 4) {
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(client.received.data() + offset);
+        uint32_t length = p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+        
+        if (length < 2 || length > MAX_FRAME_SIZE) {
+            ofLogError("PdRemoteServer") << "Client " << clientId << ": invalid frame length " << length;
+            server.disconnectClient(clientId);
+            client = Client();
+            return;
+        }
+        if (client.received.size() - offset - 4 < length) {
+            break;
+        }
+        
+        parseFrame(clientId, client.received.data() + offset + 4, length);
+        offset += 4 + length;
+    }
+    client.received.erase(0, offset);
+}
+
+void PdRemoteServer::parseFrame(int clientId, const char* data, size_t size) {
+    const char* end = data + size;
+    uint8_t type = (uint8_t)*data++;
+    uint8_t view = (uint8_t)*data++;
+    
+    if (type != FRAME_POINTER) {
+        ofLogWarning("PdRemoteServer") << "Client " << clientId << ": unknown frame type " << (int)type;
+        return;
+    }
+    
+    uint32_t pointer;
+    PdRemoteEvent event;
+    if (data >= end || (uint8_t)*data > PdRemoteEvent::POINTER_CANCEL) {
+        return;
+    }
+    event.type = (PdRemoteEvent::Type)*data++;
+    event.view = view;
+    if (!readVarint(data, end, pointer) || !readFloat(data, end, event.x) || !readFloat(data, end, event.y)) {
+        ofLogWarning("PdRemoteServer") << "Client " << clientId << ": truncated pointer frame";
+        return;
+    }
+    
+    // Identifiant unique sur le serveur : 8 bits de doigt, le reste pour le client
+    event.pointerId = (int32_t)((clientId << 8) | (pointer & 0xff));
+    if (!inbox.push(event)) {
+        ofLogWarning("PdRemoteServer") << "Event inbox full, pointer event dropped";
+        return;
+    }
+    PdFrameClock::wake();
+}
+
+void PdRemoteServer::broadcast(const string& data) {
+    for (int id = 0; id < (int)clients.size(); id++) {
+        if (clients[id].connected && server.isClientConnected(id)) {
+            server.sendRawBytes(id, data.data(), (int)data.size());
+        }
+    }
+}
+
+size_t PdRemoteServer::beginFrame(string& out, FrameType type, uint8_t view) {
+    // Longueur écrite par endFrame
+    size_t start = out.size();
+    out.append(4, '\0');
+    out += (char)type;
+    out += (char)view;
+    return start;
+}
+
+void PdRemoteServer::endFrame(string& out, size_t start) {
+    uint32_t length = (uint32_t)(out.size() - start - 4);
+    for (int i = 0; i < 4; i++) {
+        out[start + i] = (char)((length >> (8 * i)) & 0xff);
+    }
+}
+
+void PdRemoteServer::encodeValues(string& out, const std::vector<PdRemoteValue>& values) {
+    // Index croissants : écarts courts, souvent un seul octet
+    appendVarint(out, (uint32_t)values.size());
+    uint32_t previous = 0;
+    for (const PdRemoteValue& v : values) {
+        appendVarint(out, v.widget - previous);
+        appendFloat(out, v.value);
+        previous = v.widget;
+    }
+}
+
+void PdRemoteServer::appendVarint(string& out, uint32_t value) {
+    while (value >= 0x80) {
+        out += (char)((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    out += (char)value;
+}
+
+bool PdRemoteServer::readVarint(const char*& data, const char* end, uint32_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 35 && data < end; shift += 7) {
+        uint8_t byte = (uint8_t)*data++;
+        value |= (uint32_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void PdRemoteServer::appendFloat(string& out, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 4; i++) {
+        out += (char)((bits >> (8 * i)) & 0xff);
+    }
+}
+
+bool PdRemoteServer::readFloat(const char*& data, const char* end, float& value) {
+    if (end - data < 4) {
+        return false;
+    }
+    
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+    uint32_t bits = p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+    memcpy(&value, &bits, sizeof(value));
+    data += 4;
+    return true;
+}
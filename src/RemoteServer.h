@@ -0,0 +1,130 @@
+//
+//  RemoteServer.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "ofxNetwork.h"
+#include "PatchLayout.h"
+#include "RingBuffer.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Valeur d'un objet pour les clients distants (index dans la disposition)
+struct PdRemoteValue {
+    uint32_t widget;
+    float value;
+};
+
+// Événement pointeur reçu d'un client, en coordonnées du canevas de la vue
+struct PdRemoteEvent {
+    enum Type : uint8_t {
+        POINTER_DOWN,
+        POINTER_MOVE,
+        POINTER_UP,
+        POINTER_CANCEL
+    };
+    
+    Type type;
+    uint8_t view;
+    int32_t pointerId; // Unique sur le serveur (client et doigt combinés)
+    float x;
+    float y;
+};
+
+// Interface distante (tablettes) sur TCP. Trames : longueur u32, type u8,
+// vue u8, contenu ; entiers et flottants petit-boutistes (sauf la
+// disposition, dans l'ordre de la machine indiqué par son champ byteOrder).
+//   Serveur -> client
+//     'L' disposition au format du cache binaire (PdPatchCache::serialize)
+//     'V' valeurs : varint n, puis n fois varint (écart d'index) et float32
+//   Client -> serveur
+//     'P' pointeur : u8 type, varint identifiant, float32 x, float32 y
+// Un nouveau client reçoit la disposition et toutes les valeurs, puis les
+// seules valeurs modifiées, une trame par vue et par frame. L'encodage et les
+// sockets tournent sur le thread du serveur : la boucle de rendu ne fait que
+// déposer des lots et relever les événements.
+class PdRemoteServer : public ofThread {
+public:
+    static constexpr int DEFAULT_PORT = 9001;
+    
+    PdRemoteServer();
+    ~PdRemoteServer();
+    
+    bool start(int port);
+    void stop();
+    bool isRunning() const { return isThreadRunning(); }
+    
+    // Thread principal : nouvelle disposition d'une vue, valeurs modifiées.
+    // publishValues prend le lot et rend à la place un tampon vide déjà
+    // servi, renvoyé par le thread réseau : pas d'allocation par frame.
+    void publishLayout(size_t view, const PdPatchLayout& layout);
+    void publishValues(size_t view, std::vector<PdRemoteValue>& values);
+    bool hasClients() const { return numClients.load(std::memory_order_relaxed) > 0; }
+    
+    // Thread principal : événements reçus depuis la dernière frame
+    template<typename Func>
+    size_t consumeEvents(Func&& func) { return inbox.consumeAll(std::forward<Func>(func)); }
+    bool hasPendingEvents() const { return !inbox.empty(); }
+
+private:
+    static constexpr uint64_t POLL_MILLIS = 5;
+    static constexpr size_t MAX_FRAME_SIZE = 1 << 16; // Trames des clients
+    
+    enum FrameType : uint8_t {
+        FRAME_LAYOUT = 'L',
+        FRAME_VALUES = 'V',
+        FRAME_POINTER = 'P'
+    };
+    
+    // Lot déposé par le thread principal
+    struct Outgoing {
+        uint8_t view;
+        std::shared_ptr<const string> layout; // Sinon des valeurs
+        std::vector<PdRemoteValue> values;
+    };
+    
+    // État du thread réseau
+    struct ViewState {
+        std::shared_ptr<const string> layout;
+        std::vector<float> values; // Dernières valeurs, pour les nouveaux clients
+    };
+    struct Client {
+        bool connected = false;
+        string received;
+    };
+    
+    ofxTCPServer server;
+    ofThreadChannel<Outgoing> outbox;
+    ofThreadChannel<std::vector<PdRemoteValue>> spareValues; // Tampons rendus au thread principal
+    PdSpscRing<PdRemoteEvent, 1024> inbox;
+    std::atomic<int> numClients;
+    
+    std::vector<ViewState> viewStates;
+    std::vector<Client> clients;
+    string frame;
+    std::vector<PdRemoteValue> allValues;
+    
+    void threadedFunction() override;
+    void apply(Outgoing& outgoing);
+    void recycle(Outgoing& outgoing);
+    void updateClients();
+    void welcome(int clientId);
+    void receive(int clientId, Client& client);
+    void parseFrame(int clientId, const char* data, size_t size);
+    void broadcast(const string& data);
+    
+    static size_t beginFrame(string& out, FrameType type, uint8_t view);
+    static void endFrame(string& out, size_t start);
+    static void encodeValues(string& out, const std::vector<PdRemoteValue>& values);
+    static void appendVarint(string& out, uint32_t value);
+    static bool readVarint(const char*& data, const char* end, uint32_t& value);
+    static void appendFloat(string& out, float value);
+    static bool readFloat(const char*& data, const char* end, float& value);
+};
@@ -0,0 +1,356 @@
+//
+//  RenderTarget.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#include "RenderTarget.h"
+
+#if !defined(TARGET_OF_IOS) && !defined(TARGET_ANDROID) && !defined(TARGET_EMSCRIPTEN)
+#define PD_RENDER_TARGET_GLFW
+#endif
+
+PdDisplayScale PdDisplayScale::query() {
+    PdDisplayScale scale;
+#ifdef PD_RENDER_TARGET_GLFW
+    // Tailles en points et en pixels fournies par GLFW pour la fenêtre courante
+    ofAppGLFWWindow* window = dynamic_cast<ofAppGLFWWindow*>(ofGetWindowPtr());
+    if (window && window->getGLFWWindow()) {
+        int windowWidth, windowHeight, framebufferWidth, framebufferHeight;
+        glfwGetWindowSize(window->getGLFWWindow(), &windowWidth, &windowHeight);
+        glfwGetFramebufferSize(window->getGLFWWindow(), &framebufferWidth, &framebufferHeight);
+        if (windowWidth > 0 && framebufferWidth > 0) {
+            scale.pixelDensity = (float)framebufferWidth / windowWidth;
+            scale.contentScale = (float)ofGetWidth() / windowWidth;
+        }
+    }
+#endif
+    return scale;
+}
+
+size_t PdTiledTarget::budget = PdTiledTarget::DEFAULT_BUDGET;
+size_t PdTiledTarget::totalBytes = 0;
+bool PdTiledTarget::overBudgetWarned = false;
+
+PdTiledTarget::~PdTiledTarget() {
+    clear();
+}
+
+void PdTiledTarget::setBudget(size_t bytes) {
+    // Appliqué par chaque vue à sa prochaine update()
+    budget = bytes;
+    overBudgetWarned = false;
+}
+
+void PdTiledTarget::setPixelDensity(float density) {
+    if (density == pixelDensity) return;
+    clear();
+    pixelDensity = density;
+}
+
+uint64_t PdTiledTarget::tileKey(int col, int row) {
+    return ((uint64_t)(uint32_t)row << 32) | (uint32_t)col;
+}
+
+size_t PdTiledTarget::getTileBytes() const {
+    size_t side = (size_t)ceil(TILE_SIZE * pixelDensity);
+    return side * side * 4;
+}
+
+size_t PdTiledTarget::getBytes(const Tile& tile) const {
+    return getTileBytes() * (tile.hasStatic ? 2 : 1);
+}
+
+void PdTiledTarget::clear() {
+    for (auto& entry : tiles) {
+        totalBytes -= getBytes(*entry.second);
+    }
+    tiles.clear();
+    visibleTiles.clear();
+}
+
+void PdTiledTarget::setStaticLayer(CoverFunction covers, DrawFunction drawStatic) {
+    staticCovers = std::move(covers);
+    staticDraw = std::move(drawStatic);
+    invalidate();
+}
+
+size_t PdTiledTarget::getNumStaticTiles() const {
+    size_t count = 0;
+    for (auto& entry : tiles) {
+        if (entry.second->hasStatic) count++;
+    }
+    return count;
+}
+
+void PdTiledTarget::invalidate() {
+    for (auto& entry : tiles) {
+        entry.second->valid = false;
+    }
+}
+
+PdTiledTarget::Tile* PdTiledTarget::findLeastRecentlyUsed() {
+    // Quelques centaines de tuiles au plus : un parcours suffit
+    Tile* oldest = nullptr;
+    for (auto& entry : tiles) {
+        Tile* tile = entry.second.get();
+        if (tile->lastUsed == frame) continue; // Visible à cette frame
+        if (!oldest || tile->lastUsed < oldest->lastUsed) {
+            oldest = tile;
+        }
+    }
+    return oldest;
+}
+
+PdTiledTarget::Tile* PdTiledTarget::acquire(int col, int row) {
+    uint64_t key = tileKey(col, row);
+    auto it = tiles.find(key);
+    if (it != tiles.end()) return it->second.get();
+    
+    ofRectangle bounds(col * TILE_SIZE, row * TILE_SIZE, TILE_SIZE, TILE_SIZE);
+    
+    // Budget atteint : recycler l'allocation de la tuile la moins récemment vue
+    if (totalBytes + getTileBytes() > budget) {
+        if (Tile* oldest = findLeastRecentlyUsed()) {
+            std::unique_ptr<Tile> tile = std::move(tiles[oldest->key]);
+            tiles.erase(oldest->key);
+            
+            tile->bounds = bounds;
+            tile->key = key;
+            tile->valid = false;
+            Tile* recycled = tile.get();
+            tiles[key] = std::move(tile);
+            return recycled;
+        }
+        
+        if (!overBudgetWarned) {
+            ofLogWarning("PdTiledTarget") << "Visible tiles exceed the video memory budget ("
+                                          << budget / (1024 * 1024) << " MB)";
+            overBudgetWarned = true;
+        }
+    }
+    
+    auto tile = std::make_unique<Tile>();
+    tile->fbo.allocate(getTileSettings());
+    tile->bounds = bounds;
+    tile->key = key;
+    totalBytes += getTileBytes();
+    
+    Tile* created = tile.get();
+    tiles[key] = std::move(tile);
+    return created;
+}
+
+ofFbo::Settings PdTiledTarget::getTileSettings() const {
+    // Pas de profondeur ni de stencil ; filtrage au plus proche, les tuiles
+    // étant affichées pixel pour pixel
+    ofFbo::Settings settings;
+    settings.width = settings.height = (int)ceil(TILE_SIZE * pixelDensity);
+    settings.internalformat = GL_RGBA;
+    settings.useDepth = false;
+    settings.useStencil = false;
+    settings.minFilter = GL_NEAREST;
+    settings.maxFilter = GL_NEAREST;
+    return settings;
+}
+
+void PdTiledTarget::trim() {
+    // Budget réduit, ou tuiles devenues invisibles après un saut de défilement
+    while (totalBytes > budget) {
+        Tile* oldest = findLeastRecentlyUsed();
+        if (!oldest) return;
+        
+        totalBytes -= getBytes(*oldest);
+        tiles.erase(oldest->key);
+    }
+}
+
+void PdTiledTarget::update(const ofRectangle& area, const DrawFunction& draw) {
+    frame++;
+    visibleTiles.clear();
+    if (area.width <= 0 || area.height <= 0) return;
+    
+    int col1 = (int)floor(area.getMinX() / TILE_SIZE);
+    int row1 = (int)floor(area.getMinY() / TILE_SIZE);
+    int col2 = (int)ceil(area.getMaxX() / TILE_SIZE) - 1;
+    int row2 = (int)ceil(area.getMaxY() / TILE_SIZE) - 1;
+    
+    for (int row = row1; row <= row2; row++) {
+        for (int col = col1; col <= col2; col++) {
+            Tile* tile = acquire(col, row);
+            tile->lastUsed = frame;
+            visibleTiles.push_back(tile);
+        }
+    }
+    
+    for (Tile* tile : visibleTiles) {
+        if (!tile->valid) {
+            renderTile(*tile, draw);
+        }
+    }
+    
+    trim();
+}
+
+void PdTiledTarget::redraw(const std::vector<ofRectangle>& regions, const DrawFunction& draw) {
+    redraw(regions.data(), regions.size(), draw);
+}
+
+void PdTiledTarget::redraw(const ofRectangle& region, const DrawFunction& draw) {
+    redraw(&region, 1, draw);
+}
+
+void PdTiledTarget::redraw(const ofRectangle* regions, size_t numRegions, const DrawFunction& draw) {
+    for (auto& entry : tiles) {
+        Tile& tile = *entry.second;
+        if (!tile.valid) continue;
+        
+        bool visible = tile.lastUsed == frame;
+        bool bound = false;
+        
+        for (size_t i = 0; i < numRegions; i++) {
+            if (!regions[i].intersects(tile.bounds)) continue;
+            
+            // Hors de l'écran : redessinée entière quand elle redeviendra visible
+            if (!visible) {
+                tile.valid = false;
+                break;
+            }
+            
+            // Un seul begin()/end() par tuile pour toutes ses régions
+            if (!bound) {
+                tile.fbo.begin();
+                glEnable(GL_SCISSOR_TEST);
+                bound = true;
+            }
+            renderRegion(tile, regions[i], draw, tile.hasStatic ? &tile.staticFbo : nullptr);
+        }
+        
+        if (bound) {
+            glDisable(GL_SCISSOR_TEST);
+            tile.fbo.end();
+        }
+    }
+}
+
+void PdTiledTarget::redrawStatic(const std::vector<ofRectangle>& regions) {
+    if (!staticDraw) return;
+    
+    for (auto& entry : tiles) {
+        Tile& tile = *entry.second;
+        if (!tile.valid) continue;
+        
+        bool visible = tile.lastUsed == frame;
+        bool bound = false;
+        
+        for (const ofRectangle& region : regions) {
+            if (!region.intersects(tile.bounds)) continue;
+            
+            if (!visible) {
+                tile.valid = false;
+                break;
+            }
+            
+            // Premier objet statique de la tuile : fond complet
+            if (!tile.hasStatic) {
+                if (staticCovers(region)) renderStatic(tile);
+                if (!tile.hasStatic) continue;
+                break;
+            }
+            
+            if (!bound) {
+                tile.staticFbo.begin();
+                glEnable(GL_SCISSOR_TEST);
+                bound = true;
+            }
+            renderRegion(tile, region, staticDraw, nullptr);
+        }
+        
+        if (bound) {
+            glDisable(GL_SCISSOR_TEST);
+            tile.staticFbo.end();
+        }
+    }
+}
+
+void PdTiledTarget::renderTile(Tile& tile, const DrawFunction& draw) {
+    // Fond d'abord : la tuile entière est ensuite composée par-dessus
+    renderStatic(tile);
+    
+    tile.fbo.begin();
+    glEnable(GL_SCISSOR_TEST);
+    renderRegion(tile, tile.bounds, draw, tile.hasStatic ? &tile.staticFbo : nullptr);
+    glDisable(GL_SCISSOR_TEST);
+    tile.fbo.end();
+    tile.valid = true;
+}
+
+void PdTiledTarget::renderStatic(Tile& tile) {
+    // Tuile sans objet statique : pas de seconde texture
+    if (!staticDraw || !staticCovers(tile.bounds)) {
+        releaseStatic(tile);
+        return;
+    }
+    
+    if (!tile.hasStatic) {
+        tile.staticFbo.allocate(getTileSettings());
+        tile.hasStatic = true;
+        totalBytes += getTileBytes();
+    }
+    
+    tile.staticFbo.begin();
+    glEnable(GL_SCISSOR_TEST);
+    renderRegion(tile, tile.bounds, staticDraw, nullptr);
+    glDisable(GL_SCISSOR_TEST);
+    tile.staticFbo.end();
+}
+
+void PdTiledTarget::releaseStatic(Tile& tile) {
+    if (!tile.hasStatic) return;
+    tile.staticFbo.clear();
+    tile.hasStatic = false;
+    totalBytes -= getTileBytes();
+}
+
+void PdTiledTarget::renderRegion(Tile& tile, const ofRectangle& region, const DrawFunction& draw,
+                                 const ofFbo* background) {
+    // À appeler entre fbo.begin() et fbo.end() avec GL_SCISSOR_TEST actif.
+    // Dans un FBO, OF inverse la matrice de projection : l'axe Y d'OF coïncide
+    // avec celui de GL, le rectangle peut donc être passé tel quel à glScissor.
+    const ofRectangle& bounds = tile.bounds;
+    float x1 = max(0.0f, floor((region.getMinX() - bounds.x) * pixelDensity));
+    float y1 = max(0.0f, floor((region.getMinY() - bounds.y) * pixelDensity));
+    float x2 = min(tile.fbo.getWidth(), ceil((region.getMaxX() - bounds.x) * pixelDensity));
+    float y2 = min(tile.fbo.getHeight(), ceil((region.getMaxY() - bounds.y) * pixelDensity));
+    if (x2 <= x1 || y2 <= y1) return;
+    
+    glScissor(x1, y1, x2 - x1, y2 - y1);
+    ofClear(0, 0, 0, 0);
+    
+    // Fond statique recopié tel quel (sans mélange), limité par le scissor
+    if (background) {
+        ofPushStyle();
+        ofDisableAlphaBlending();
+        background->draw(0, 0);
+        ofPopStyle();
+    }
+    
+    // Région alignée sur les pixels de la tuile, en coordonnées du canevas
+    ofRectangle clipped(bounds.x + x1 / pixelDensity, bounds.y + y1 / pixelDensity,
+                        (x2 - x1) / pixelDensity, (y2 - y1) / pixelDensity);
+    
+    ofPushMatrix();
+    ofScale(pixelDensity, pixelDensity);
+    ofTranslate(-bounds.x, -bounds.y);
+    draw(clipped);
+    ofPopMatrix();
+}
+
+void PdTiledTarget::draw(ofVec2f origin, float scale) const {
+    // Positions arrondies : chaque pixel de tuile tombe sur un pixel de l'écran
+    float size = TILE_SIZE * scale;
+    for (const Tile* tile : visibleTiles) {
+        tile->fbo.draw(floor(origin.x + tile->bounds.x * scale), floor(origin.y + tile->bounds.y * scale), size, size);
+    }
+}
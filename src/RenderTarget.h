@@ -0,0 +1,114 @@
+//
+//  RenderTarget.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Échelle de la fenêtre courante. pixelDensity : pixels du framebuffer par point
+// de l'écran (2 sur un écran Retina) ; contentScale : unités OF par point,
+// pour qu'un patch garde sa taille physique quelle que soit la convention d'OF.
+struct PdDisplayScale {
+    float pixelDensity = 1.0f;
+    float contentScale = 1.0f;
+    
+    static PdDisplayScale query();
+};
+
+// Cible de rendu d'une vue découpée en tuiles de taille fixe, en coordonnées
+// du canevas. Seules les tuiles visibles sont redessinées ; elles restent
+// allouées tant que le budget de mémoire vidéo (commun à toutes les vues) le
+// permet, puis la moins récemment vue est recyclée. Un redimensionnement ne
+// réalloue rien : il ne change que l'ensemble des tuiles visibles.
+// Avec une couche statique, les tuiles qui en contiennent gardent une seconde
+// texture où ces objets sont rendus une fois ; un redessin recopie ce fond
+// au lieu d'effacer, puis ne dessine que les objets interactifs.
+class PdTiledTarget {
+public:
+    static constexpr int TILE_SIZE = 512; // Points du canevas
+    static constexpr size_t DEFAULT_BUDGET = 256 * 1024 * 1024;
+    
+    // Dessin d'une région du canevas ; le repère canevas et le scissor sont en place
+    typedef std::function<void(const ofRectangle& region)> DrawFunction;
+    // Vrai si un objet de la couche statique touche la région
+    typedef std::function<bool(const ofRectangle& region)> CoverFunction;
+    
+    ~PdTiledTarget();
+    
+    // Résolution des tuiles : une densité différente libère tout
+    void setPixelDensity(float density);
+    float getPixelDensity() const { return pixelDensity; }
+    
+    // Une fois par frame : rend résidentes les tuiles qui couvrent area, en
+    // redessinant entièrement les nouvelles et les invalidées
+    void update(const ofRectangle& area, const DrawFunction& draw);
+    
+    // Régions sales : redessinées dans les tuiles visibles qui les touchent ;
+    // les tuiles résidentes hors de l'écran sont seulement invalidées
+    void redraw(const std::vector<ofRectangle>& regions, const DrawFunction& draw);
+    void redraw(const ofRectangle& region, const DrawFunction& draw);
+    void invalidate();
+    void clear();
+    
+    // Couche statique : objets dessinés par drawStatic, sous ceux de draw.
+    // Sans fonctions, les tuiles sont effacées avant chaque redessin.
+    void setStaticLayer(CoverFunction covers, DrawFunction drawStatic);
+    // Objets statiques modifiés : fond des régions à refaire, avant redraw()
+    // de ces mêmes régions qui recompose les tuiles
+    void redrawStatic(const std::vector<ofRectangle>& regions);
+    size_t getNumStaticTiles() const;
+    
+    // Tuiles visibles ; origin = position du point (0, 0) du canevas, scale = unités OF par point
+    void draw(ofVec2f origin, float scale) const;
+    
+    size_t getNumResidentTiles() const { return tiles.size(); }
+    size_t getNumVisibleTiles() const { return visibleTiles.size(); }
+    
+    // Budget commun à toutes les vues
+    static void setBudget(size_t bytes);
+    static size_t getBudget() { return budget; }
+    static size_t getTotalBytes() { return totalBytes; }
+    
+private:
+    struct Tile {
+        ofFbo fbo;
+        ofFbo staticFbo; // Couche statique, si la tuile en contient
+        bool hasStatic = false;
+        ofRectangle bounds;
+        uint64_t key = 0;
+        uint64_t lastUsed = 0;
+        bool valid = false;
+    };
+    
+    float pixelDensity = 1.0f;
+    std::unordered_map<uint64_t, std::unique_ptr<Tile>> tiles;
+    std::vector<Tile*> visibleTiles;
+    uint64_t frame = 0;
+    CoverFunction staticCovers;
+    DrawFunction staticDraw;
+    
+    static size_t budget;
+    static size_t totalBytes;
+    static bool overBudgetWarned;
+    
+    static uint64_t tileKey(int col, int row);
+    size_t getTileBytes() const;
+    size_t getBytes(const Tile& tile) const;
+    ofFbo::Settings getTileSettings() const;
+    Tile* acquire(int col, int row);
+    Tile* findLeastRecentlyUsed();
+    void trim();
+    void redraw(const ofRectangle* regions, size_t numRegions, const DrawFunction& draw);
+    void renderTile(Tile& tile, const DrawFunction& draw);
+    void renderStatic(Tile& tile);
+    void releaseStatic(Tile& tile);
+    void renderRegion(Tile& tile, const ofRectangle& region, const DrawFunction& draw, const ofFbo* background);
+};
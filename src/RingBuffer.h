@@ -0,0 +1,76 @@
+//
+//  RingBuffer.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 19/07/2025.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// File circulaire sans verrou, un seul producteur et un seul consommateur.
+// Le producteur (thread audio de Pd) n'alloue ni ne bloque jamais : si la file
+// est pleine, push() échoue et le message est compté comme perdu par l'appelant.
+// Capacity doit être une puissance de deux.
+template<typename T, size_t Capacity>
+class PdSpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "PdSpscRing capacity must be a power of two");
+    
+public:
+    PdSpscRing() : head(0), tail(0) {}
+    
+    // Producteur
+    bool push(const T& item) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= Capacity) {
+            return false; // Pleine
+        }
+        
+        items[h & MASK] = item;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+    
+    // Consommateur
+    bool pop(T& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) {
+            return false; // Vide
+        }
+        
+        item = items[t & MASK];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+    
+    // Consommateur : vide tout ce qui est disponible en un seul lot
+    template<typename Func>
+    size_t consumeAll(Func&& func) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t h = head.load(std::memory_order_acquire);
+        
+        for (size_t i = t; i != h; i++) {
+            func(items[i & MASK]);
+        }
+        
+        tail.store(h, std::memory_order_release);
+        return h - t;
+    }
+    
+    size_t size() const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size() == 0; }
+    static constexpr size_t capacity() { return Capacity; }
+    
+private:
+    static constexpr size_t MASK = Capacity - 1;
+    
+    // Index sur des lignes de cache séparées pour éviter le faux partage
+    alignas(64) std::atomic<size_t> head;
+    alignas(64) std::atomic<size_t> tail;
+    alignas(64) T items[Capacity];
+};
@@ -0,0 +1,105 @@
+//
+//  SelfTest.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#include "SelfTest.h"
+#include "PatchDiff.h"
+#include "SendQueue.h"
+#include "Snapshot.h"
+#include "Toggle.h"
+#include "WidgetStore.h"
+#include <cstdio>
+
+int PdSelfTest::run() {
+    struct Test {
+        const char* name;
+        bool (*func)();
+    };
+    
+    const Test tests[] = {
+        { "reload_move_and_resize", &PdSelfTest::testReloadMoveAndResize },
+        { "snapshot_path", &PdSelfTest::testSnapshotPath },
+        { "send_order", &PdSelfTest::testSendOrder }
+    };
+    
+    int numFailed = 0;
+    for (const Test& test : tests) {
+        bool passed = test.func();
+        printf("  %-32s %s\n", test.name, passed ? "ok" : "FAILED");
+        if (!passed) numFailed++;
+    }
+    
+    printf("self test: %d of %zu failed\n", numFailed, sizeof(tests) / sizeof(tests[0]));
+    return numFailed == 0 ? 0 : 1;
+}
+
+bool PdSelfTest::check(bool condition, const char* name) {
+    if (!condition) printf("    check failed: %s\n", name);
+    return condition;
+}
+
+bool PdSelfTest::testReloadMoveAndResize() {
+    // Rechargement qui déplace et agrandit le même objet, puis change son
+    // ordre z : l'ancienne zone doit rester dans la région à redessiner
+    auto toggle = PdWidgetStore::get().create<PdToggle>(ofVec2f(10, 10), ofVec2f(20, 20),
+                                                        "selftest_send", "selftest_receive");
+    ofRectangle oldBounds = toggle->getDrawBounds();
+    toggle->clearUpdateFlag();
+    
+    PdWidgetDesc desc;
+    desc.type = (uint8_t)GuiType::TOGGLE;
+    desc.x = 200;
+    desc.y = 150;
+    desc.width = 40;
+    desc.height = 40;
+    PdPatchDiff::mutate(*toggle, desc);
+    toggle->markForUpdate();
+    
+    ofRectangle region = toggle->getUpdateRegion();
+    bool passed = check(toggle->needsUpdate(), "object marked");
+    passed &= check(region.inside(oldBounds), "old bounds redrawn");
+    passed &= check(region.inside(toggle->getDrawBounds()), "new bounds redrawn");
+    return passed;
+}
+
+bool PdSelfTest::testSnapshotPath() {
+    // Le chemin de --snapshot n'est jamais passé comme format à printf
+    bool passed = check(PdSnapshotSettings::isValidPath("thumb.png"), "fixed path");
+    passed &= check(PdSnapshotSettings::isValidPath("frames/%05d.png"), "padded number");
+    passed &= check(PdSnapshotSettings::isValidPath("frame%d.jpg"), "plain number");
+    passed &= check(!PdSnapshotSettings::isValidPath("%s.png"), "string conversion rejected");
+    passed &= check(!PdSnapshotSettings::isValidPath("%n.png"), "write conversion rejected");
+    passed &= check(!PdSnapshotSettings::isValidPath("%d_%d.png"), "two numbers rejected");
+    passed &= check(!PdSnapshotSettings::isValidPath("%5d.png"), "space padding rejected");
+    return passed;
+}
+
+bool PdSelfTest::testSendOrder() {
+    // Pd doit finir sur la dernière valeur reçue, quelle que soit la politique
+    PdSymbolId symbolId = PdSymbol("self-test-send").getId();
+    std::vector<float> received;
+    auto receive = [&received](const string&, float value) { received.push_back(value); };
+    
+    PdSendQueue queue;
+    queue.send(symbolId, 1, PdSendPolicy::COALESCE);
+    queue.send(symbolId, 2, PdSendPolicy::IMMEDIATE);
+    queue.send(symbolId, 3, PdSendPolicy::COALESCE);
+    queue.flush(0);
+    queue.consume(receive);
+    bool passed = check(!received.empty() && received.back() == 3, "coalesced value after immediate");
+    
+    // Intervalle non écoulé : la valeur retenue ne doit pas suivre l'immédiate
+    received.clear();
+    queue.setFlushInterval(1000000);
+    queue.send(symbolId, 4, PdSendPolicy::COALESCE);
+    queue.send(symbolId, 5, PdSendPolicy::IMMEDIATE);
+    queue.flush(2);
+    queue.flush(2, true);
+    queue.consume(receive);
+    passed &= check(!received.empty() && received.back() == 5, "held value before immediate");
+    passed &= check(queue.getNumPending() == 0, "queue drained");
+    return passed;
+}
@@ -0,0 +1,23 @@
+//
+//  SelfTest.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#pragma once
+
+// Vérifications sans fenêtre des cas qui ont déjà régressé.
+// Lancé par : pd-gui --self-test
+class PdSelfTest {
+public:
+    // Affiche chaque cas en échec ; retourne le code de sortie du programme
+    static int run();
+
+private:
+    static bool check(bool condition, const char* name);
+    
+    static bool testReloadMoveAndResize();
+    static bool testSnapshotPath();
+    static bool testSendOrder();
+};
@@ -0,0 +1,114 @@
+//
+//  SendQueue.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 19/07/2025.
+//
+
+#include "SendQueue.h"
+
+PdSendQueue::PdSendQueue()
+    : flushInterval(0)
+    , lastFlushTime(0)
+    , currentInput(0)
+    , numSent(0)
+    , numCoalesced(0)
+    , numDropped(0)
+{
+}
+
+void PdSendQueue::reserveSymbol(PdSymbolId symbolId) {
+    if (symbolId >= pendingSlot.size()) {
+        pendingSlot.resize(symbolId + 1, -1);
+    }
+}
+
+void PdSendQueue::setFlushInterval(uint64_t intervalMicros) {
+    flushInterval = intervalMicros;
+}
+
+void PdSendQueue::send(PdSymbolId symbolId, float value, PdSendPolicy policy) {
+    if (symbolId == PD_EMPTY_SYMBOL) return;
+    reserveSymbol(symbolId);
+    
+    if (policy == PdSendPolicy::COALESCE) {
+        int32_t slot = pendingSlot[symbolId];
+        if (slot >= 0) {
+            // Remplacer la valeur en attente, à sa place d'origine dans le lot ;
+            // la latence compte depuis la première entrée qui l'a modifiée
+            PdOutboundMessage& message = pending[slot].message;
+            message.value = value;
+            if (message.inputMicros == 0) message.inputMicros = currentInput;
+            numCoalesced++;
+            return;
+        }
+        
+        pendingSlot[symbolId] = (int32_t)pending.size();
+        pending.push_back({ { symbolId, value, currentInput }, true });
+        return;
+    }
+    
+    // Une valeur fusionnée arrivée ensuite doit partir après ce message :
+    // elle prend un nouvel emplacement au lieu de remplacer l'ancien
+    pendingSlot[symbolId] = -1;
+    pending.push_back({ { symbolId, value, currentInput }, false });
+}
+
+size_t PdSendQueue::flush(uint64_t nowMicros, bool force) {
+    if (pending.empty()) return 0;
+    
+    // Les messages immédiats partent toujours ; les valeurs fusionnées
+    // attendent la fin de l'intervalle
+    bool flushCoalesced = force || flushInterval == 0 || nowMicros - lastFlushTime >= flushInterval;
+    if (flushCoalesced) {
+        lastFlushTime = nowMicros;
+    }
+    
+    size_t published = 0;
+    size_t kept = 0;
+    
+    for (size_t i = 0; i < pending.size(); i++) {
+        PendingMessage& entry = pending[i];
+        
+        if (entry.coalesced && !flushCoalesced) {
+            // Garder pour le prochain lot en compactant le vecteur
+            pendingSlot[entry.message.symbolId] = (int32_t)kept;
+            pending[kept++] = entry;
+            continue;
+        }
+        
+        int32_t& slot = pendingSlot[entry.message.symbolId];
+        if (entry.coalesced) {
+            slot = -1;
+        } else if (slot >= 0 && (size_t)slot < kept) {
+            // Valeur fusionnée retenue plus tôt pour ce symbole : elle part
+            // avant le message immédiat, sans quoi Pd finirait sur elle
+            size_t held = (size_t)slot;
+            slot = -1;
+            if (publish(pending[held].message)) published++;
+            for (size_t j = held + 1; j < kept; j++) {
+                pending[j - 1] = pending[j];
+                pendingSlot[pending[j - 1].message.symbolId] = (int32_t)(j - 1);
+            }
+            kept--;
+        }
+        
+        if (publish(entry.message)) published++;
+    }
+    
+    pending.resize(kept);
+    numSent += published;
+    return published;
+}
+
+bool PdSendQueue::publish(const PdOutboundMessage& message) {
+    if (outbox.push(message)) return true;
+    numDropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void PdSendQueue::resetStats() {
+    numSent = 0;
+    numCoalesced = 0;
+    numDropped.store(0, std::memory_order_relaxed);
+}
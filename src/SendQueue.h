@@ -0,0 +1,97 @@
+//
+//  SendQueue.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 19/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "RingBuffer.h"
+#include "Latency.h"
+#include "Symbol.h"
+#include <atomic>
+#include <vector>
+
+// Politique d'envoi d'un objet GUI
+enum class PdSendPolicy {
+    IMMEDIATE, // Chaque événement est transmis (bang, toggle)
+    COALESCE   // Seule la dernière valeur par symbole et par intervalle est transmise
+};
+
+// Message sortant vers Pure Data
+struct PdOutboundMessage {
+    PdSymbolId symbolId;
+    float value;
+    uint64_t inputMicros; // Événement d'entrée à l'origine du message (0 = aucun)
+};
+
+// File des messages sortants. Les objets y déposent leurs valeurs depuis le
+// thread principal ; flush() publie le lot de la frame dans une file sans
+// verrou consommée par le thread Pd.
+class PdSendQueue {
+public:
+    PdSendQueue();
+    
+    // Configuration (thread principal) : réserver la place d'un symbole
+    // évite toute allocation dans send()
+    void reserveSymbol(PdSymbolId symbolId);
+    void setFlushInterval(uint64_t intervalMicros); // 0 = à chaque frame
+    
+    // Date de l'événement d'entrée en cours, reportée sur les messages émis
+    // jusqu'au prochain appel (0 = hors événement) pour mesurer la latence
+    void setInputTime(uint64_t inputMicros) { currentInput = inputMicros; }
+    
+    // Chemin critique (thread principal) : aucune allocation ni log
+    void send(PdSymbolId symbolId, float value, PdSendPolicy policy);
+    
+    // Une fois par frame : publier les messages prêts vers le thread Pd
+    size_t flush(uint64_t nowMicros, bool force = false);
+    
+    // Thread Pd : consommer les messages publiés, func(symbol, value).
+    // Les messages issus d'une entrée alimentent la latence SEND.
+    template<typename Func>
+    size_t consume(Func&& func) {
+        const PdSymbolTable& symbols = PdSymbolTable::get();
+        PdLatencyTracker& latency = PdLatencyTracker::get();
+        return outbox.consumeAll([&symbols, &func, &latency](const PdOutboundMessage& message) {
+            func(symbols.getName(message.symbolId), message.value);
+            if (message.inputMicros != 0) {
+                latency.record(PdLatencyStage::SEND, message.inputMicros, ofGetElapsedTimeMicros());
+            }
+        });
+    }
+    
+    // Statistiques
+    uint64_t getNumSent() const { return numSent; }
+    uint64_t getNumCoalesced() const { return numCoalesced; }
+    uint64_t getNumDropped() const { return numDropped.load(std::memory_order_relaxed); }
+    size_t getNumPending() const { return pending.size(); }
+    void resetStats();
+    
+private:
+    static constexpr size_t OUTBOX_CAPACITY = 4096;
+    
+    struct PendingMessage {
+        PdOutboundMessage message;
+        bool coalesced;
+    };
+    
+    bool publish(const PdOutboundMessage& message);
+    
+    // Messages de la frame dans l'ordre d'arrivée ; un seul emplacement
+    // par symbole pour les valeurs fusionnées (indexé par PdSymbolId)
+    std::vector<PendingMessage> pending;
+    std::vector<int32_t> pendingSlot;
+    
+    uint64_t flushInterval;
+    uint64_t lastFlushTime;
+    uint64_t currentInput;
+    
+    PdSpscRing<PdOutboundMessage, OUTBOX_CAPACITY> outbox;
+    
+    uint64_t numSent;
+    uint64_t numCoalesced;
+    std::atomic<uint64_t> numDropped;
+};
@@ -6,9 +6,10 @@
 //
 
 #include "Slider.h"
+#include "NumberFormat.h"
 
 PdSlider::PdSlider(GuiType type, ofVec2f position, ofVec2f size,
-                   const string& sendSymbol, const string& receiveSymbol,
+                   PdSymbol sendSymbol, PdSymbol receiveSymbol,
                    float min, float max, float initialValue)
     : PdGuiObject(type, position, size, sendSymbol, receiveSymbol)
     , knobSize(8.0f)
@@ -53,6 +54,50 @@ void PdSlider::draw() {
     ofPopStyle();
 }
 
+ofRectangle PdSlider::getDrawBounds() const {
+    ofRectangle bounds = PdGuiObject::getDrawBounds();
+    
+    // Le texte de valeur du slider vertical déborde à droite de l'objet
+    if (showValue && !isHorizontal) {
+        char buffer[PdNumberFormat::MAX_LENGTH];
+        int maxChars = max(PdNumberFormat::formatFloat(buffer, sizeof(buffer), minValue, 1),
+                           PdNumberFormat::formatFloat(buffer, sizeof(buffer), maxValue, 1));
+        bounds.growToInclude(ofRectangle(position.x + size.x * 0.7f, position.y,
+                                         maxChars * PdGlyphAtlas::estimateCharWidth(fontSize), size.y));
+    }
+    
+    ofRectangle labelBounds = getLabelBounds();
+    if (labelBounds.width > 0) {
+        bounds.growToInclude(labelBounds);
+    }
+    
+    return bounds;
+}
+
+bool PdSlider::drawBatched(PdPrimitiveBatch& batch) {
+    // Même ordre que draw() : fond, piste, knob, valeur, bordure, labels
+    batchBackground(batch);
+    
+    ofRectangle track = getTrackBounds();
+    batch.addRect(track.x, track.y, track.width, track.height,
+                  DEFAULT_BG_COLOR.getLerped(ofColor::black, 0.1f));
+    batch.addRectOutline(track.x, track.y, track.width, track.height, DEFAULT_BORDER_COLOR);
+    
+    ofVec2f knobPos = getKnobPosition();
+    batch.addCircle(knobPos.x, knobPos.y, knobSize * 0.5f, getKnobColor());
+    batch.addCircleOutline(knobPos.x, knobPos.y, knobSize * 0.5f, DEFAULT_BORDER_COLOR);
+    
+    if (showValue) {
+        updateValueLabel();
+        ofVec2f textPos = getValueTextPosition();
+        batch.addText(valueLabel, textPos.x, textPos.y, DEFAULT_FG_COLOR);
+    }
+    
+    batchBorder(batch);
+    batchLabel(batch);
+    return true;
+}
+
 bool PdSlider::onMousePressed(ofMouseEventArgs& args) {
     if (!visible || !enabled) return false;
     
@@ -78,7 +123,7 @@ bool PdSlider::onMousePressed(ofMouseEventArgs& args) {
             setSliderValue(newValue);
         }
         
-        markForUpdate();
+        markIfRenderChanged();
         return true;
     }
     
@@ -139,7 +184,7 @@ void PdSlider::setSliderStyle(float knobSize, bool showValue) {
 
 ofVec2f PdSlider::getKnobPosition() const {
     ofRectangle track = getTrackBounds();
-    float normalizedValue = (currentValue - minValue) / (maxValue - minValue);
+    float normalizedValue = (displayValue - minValue) / (maxValue - minValue);
     
     if (isHorizontal) {
         float x = track.x + normalizedValue * track.width;
@@ -203,9 +248,7 @@ void PdSlider::drawTrack() {
     ofFill();
 }
 
-void PdSlider::drawKnob() {
-    ofVec2f knobPos = getKnobPosition();
-    
+ofColor PdSlider::getKnobColor() const {
     // Couleur du knob selon l'état
     ofColor knobColor = DEFAULT_FG_COLOR;
     if (mousePressed && isDraggingKnob) {
@@ -218,8 +261,14 @@ void PdSlider::drawKnob() {
         knobColor = knobColor * 0.5f;
     }
     
+    return knobColor;
+}
+
+void PdSlider::drawKnob() {
+    ofVec2f knobPos = getKnobPosition();
+    
     // Dessiner le knob
-    ofSetColor(knobColor);
+    ofSetColor(getKnobColor());
     ofDrawCircle(knobPos.x, knobPos.y, knobSize * 0.5f);
     
     // Bordure du knob
@@ -229,23 +278,56 @@ void PdSlider::drawKnob() {
     ofFill();
 }
 
-void PdSlider::drawValueText() {
-    if (!showValue) return;
-    
-    ofSetColor(DEFAULT_FG_COLOR);
+void PdSlider::setFontSize(int fontSize) {
+    PdGuiObject::setFontSize(fontSize);
+    valueLabel.setFontSize(fontSize);
+}
+
+uint64_t PdSlider::computeRenderKey() const {
+    // Knob au demi-point près, couleur du knob, texte à une décimale
+    ofVec2f knobPos = getKnobPosition();
+    uint64_t key = getBaseRenderKey() | ((uint64_t)isDraggingKnob << 4);
+    key = mixRenderKey(key, (uint64_t)(int64_t)round((isHorizontal ? knobPos.x : knobPos.y) * 2.0f));
     
-    // Formater la valeur
-    string valueStr = ofToString(currentValue, 1);
+    if (showValue) {
+        key = mixRenderKey(key, (uint64_t)(int64_t)round(displayValue * 10.0f));
+    }
+    return key;
+}
+
+float PdSlider::getDisplayQuantum() const {
+    // Un demi-point de course du knob (un pixel sur écran Retina)
+    ofRectangle track = getTrackBounds();
+    float length = isHorizontal ? track.width : track.height;
+    float quantum = abs(maxValue - minValue) / max(1.0f, length * 2.0f);
     
-    // Position du texte
-    float textX, textY;
+    // Texte de la valeur à une décimale
+    if (showValue) {
+        quantum = min(quantum, 0.1f);
+    }
+    return quantum;
+}
+
+void PdSlider::updateValueLabel() {
+    // Formatage sans allocation ; le label ignore un texte identique
+    char buffer[PdNumberFormat::MAX_LENGTH];
+    int length = PdNumberFormat::formatFloat(buffer, sizeof(buffer), displayValue, 1);
+    valueLabel.set(buffer, length);
+}
+
+ofVec2f PdSlider::getValueTextPosition() const {
+    // Position du texte, centré avec la largeur réelle mesurée par l'atlas
     if (isHorizontal) {
-        textX = size.x * 0.5f - valueStr.length() * 3; // Approximation de centrage
-        textY = size.y * 0.7f;
+        return ofVec2f(size.x * 0.5f - valueLabel.getWidth() * 0.5f, size.y * 0.7f);
     } else {
-        textX = size.x * 0.7f;
-        textY = size.y * 0.5f;
+        return ofVec2f(size.x * 0.7f, size.y * 0.5f);
     }
+}
+
+void PdSlider::drawValueText() {
+    if (!showValue) return;
     
-    ofDrawBitmapString(valueStr, textX, textY);
+    updateValueLabel();
+    ofVec2f textPos = getValueTextPosition();
+    valueLabel.draw(textPos.x, textPos.y, DEFAULT_FG_COLOR);
 }
@@ -13,12 +13,17 @@ class PdSlider : public PdGuiObject {
 public:
     // Constructeur
     PdSlider(GuiType type, ofVec2f position, ofVec2f size,
-             const string& sendSymbol, const string& receiveSymbol,
+             PdSymbol sendSymbol, PdSymbol receiveSymbol,
              float min = 0.0f, float max = 127.0f, float initialValue = 0.0f);
     
     // Méthodes virtuelles héritées
     virtual void update() override;
     virtual void draw() override;
+    virtual bool drawBatched(PdPrimitiveBatch& batch) override;
+    virtual ofRectangle getDrawBounds() const override;
+    virtual void setFontSize(int fontSize) override;
+    virtual float getDisplayQuantum() const override;
+    virtual bool smoothsDisplay() const override { return true; }
     
     // Gestion spécifique des événements souris pour le slider
     virtual bool onMousePressed(ofMouseEventArgs& args) override;
@@ -39,6 +44,12 @@ protected:
     bool showValue;
     bool isHorizontal;
     
+    // Valeur affichée, remise en forme seulement quand le texte change
+    PdTextLabel valueLabel;
+    
+    // Clé de rendu : knob au demi-point, texte de la valeur, état du knob
+    virtual uint64_t computeRenderKey() const override;
+    
     // Calculs de position
     ofVec2f getKnobPosition() const;
     ofRectangle getKnobBounds() const;
@@ -52,6 +63,9 @@ protected:
     void drawTrack();
     void drawKnob();
     void drawValueText();
+    ofColor getKnobColor() const;
+    void updateValueLabel();
+    ofVec2f getValueTextPosition() const;
     
 private:
     // Variables pour le drag
@@ -0,0 +1,185 @@
+//
+//  Snapshot.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#include "Snapshot.h"
+
+PdSnapshotWriter::PdSnapshotWriter()
+    : numWritten(0)
+    , numDropped(0)
+{
+    for (size_t i = 0; i < POOL_SIZE; i++) {
+        buffers.push_back(std::make_unique<ofPixels>());
+        freeBuffers.push_back(buffers.back().get());
+    }
+}
+
+PdSnapshotWriter::~PdSnapshotWriter() {
+    close();
+}
+
+ofPixels* PdSnapshotWriter::acquire() {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    if (freeBuffers.empty()) return nullptr;
+    
+    ofPixels* pixels = freeBuffers.back();
+    freeBuffers.pop_back();
+    return pixels;
+}
+
+void PdSnapshotWriter::submit(ofPixels* pixels, const string& path) {
+    if (!isThreadRunning()) {
+        startThread();
+    }
+    jobs.send(Job{pixels, path});
+}
+
+void PdSnapshotWriter::close() {
+    // Un travail sans image termine le thread, après les images déjà soumises
+    // (fermer le canal perdrait celles-ci)
+    if (isThreadRunning()) {
+        jobs.send(Job{nullptr, ""});
+        waitForThread(false);
+    }
+}
+
+void PdSnapshotWriter::discard(ofPixels* pixels) {
+    release(pixels);
+    numDropped++;
+}
+
+void PdSnapshotWriter::release(ofPixels* pixels) {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    freeBuffers.push_back(pixels);
+}
+
+void PdSnapshotWriter::threadedFunction() {
+    Job job;
+    while (jobs.receive(job) && job.pixels) {
+        if (ofSaveImage(*job.pixels, job.path)) {
+            numWritten++;
+        } else {
+            ofLogError("PdSnapshotWriter") << "Cannot write " << job.path;
+        }
+        release(job.pixels);
+    }
+}
+
+void PdSnapshotRecorder::setup(const PdSnapshotSettings& settings) {
+    this->settings = settings;
+    enabled = !settings.path.empty();
+    if (!enabled) return;
+    
+    fbo.allocate(settings.width, settings.height, GL_RGBA);
+    
+    size_t bytes = (size_t)settings.width * settings.height * 4;
+    for (auto& buffer : readBuffers) {
+        buffer.allocate(bytes, GL_STREAM_READ);
+    }
+    
+    nextCaptureMicros = 0;
+    numCaptured = 0;
+    pendingBuffer = -1;
+}
+
+void PdSnapshotRecorder::capture(const std::function<void()>& drawScene, uint64_t nowMicros) {
+    if (!enabled || isFinished()) return;
+    
+    // Cadence fixe, sans rattraper les captures manquées
+    nextCaptureMicros = max(nextCaptureMicros + settings.intervalMicros, nowMicros);
+    
+    fbo.begin();
+    ofClear(50, 50, 50, 255);
+    drawScene();
+    fbo.end();
+    
+    // Lecture asynchrone dans le tampon libre, puis lecture de l'image précédente
+    int buffer = pendingBuffer == 0 ? 1 : 0;
+    fbo.getTexture().copyTo(readBuffers[buffer]);
+    
+    if (pendingBuffer >= 0) {
+        collect(pendingBuffer, pendingFrame);
+    }
+    pendingBuffer = buffer;
+    pendingFrame = numCaptured++;
+}
+
+void PdSnapshotRecorder::finish() {
+    if (!enabled) return;
+    
+    if (pendingBuffer >= 0) {
+        collect(pendingBuffer, pendingFrame);
+        pendingBuffer = -1;
+    }
+    writer.close();
+    
+    ofLogNotice("PdSnapshotRecorder") << writer.getNumWritten() << " snapshot(s) written, "
+                                      << writer.getNumDropped() << " dropped";
+}
+
+void PdSnapshotRecorder::collect(int buffer, size_t frame) {
+    ofPixels* pixels = writer.acquire();
+    if (!pixels) {
+        // Encodeur en retard : l'image est perdue plutôt que de bloquer
+        writer.drop();
+        return;
+    }
+    
+    const unsigned char* data = readBuffers[buffer].map<unsigned char>(GL_READ_ONLY);
+    if (data) {
+        pixels->setFromPixels(data, settings.width, settings.height, OF_PIXELS_RGBA);
+    }
+    readBuffers[buffer].unmap();
+    
+    if (data) {
+        writer.submit(pixels, getFramePath(frame));
+    } else {
+        writer.discard(pixels);
+    }
+}
+
+string PdSnapshotRecorder::getFramePath(size_t frame) const {
+    size_t start, end;
+    int width;
+    if (!findFrameNumber(settings.path, start, end, width)) {
+        return settings.path;
+    }
+    
+    // Le chemin n'est jamais une chaîne de format : seul le numéro est formaté
+    char number[32];
+    snprintf(number, sizeof(number), "%0*zu", width, frame);
+    return settings.path.substr(0, start) + number + settings.path.substr(end);
+}
+
+bool PdSnapshotRecorder::findFrameNumber(const string& path, size_t& start, size_t& end, int& width) {
+    start = path.find('%');
+    if (start == string::npos) return false;
+    
+    // "%d" ou "%0Nd", N sur deux chiffres au plus
+    size_t i = start + 1;
+    width = 0;
+    if (i < path.size() && path[i] == '0') {
+        i++;
+        size_t digitsStart = i;
+        while (i < path.size() && isdigit((unsigned char)path[i]) && i - digitsStart < 2) {
+            width = width * 10 + (path[i] - '0');
+            i++;
+        }
+        if (i == digitsStart) return false;
+    }
+    if (i >= path.size() || path[i] != 'd') return false;
+    
+    end = i + 1;
+    return true;
+}
+
+bool PdSnapshotSettings::isValidPath(const string& path) {
+    size_t start, end;
+    int width;
+    if (path.find('%') == string::npos) return true;
+    if (!PdSnapshotRecorder::findFrameNumber(path, start, end, width)) return false;
+    return path.find('%', end) == string::npos;
+}
@@ -0,0 +1,114 @@
+//
+//  Snapshot.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Images d'un patch en cours d'exécution, sans affichage (--snapshot)
+struct PdSnapshotSettings {
+    // "thumb.png" : réécrite à chaque image ; "frames/%05d.jpg" : numérotées.
+    // Le format suit l'extension.
+    string path;
+    
+    // Au plus un numéro "%d" ou "%0Nd", aucun autre '%' (vérifié avant setup)
+    static bool isValidPath(const string& path);
+    uint64_t intervalMicros = 1000000;
+    int maxFrames = 0; // 0 = sans fin, 1 = une vignette puis sortie
+    int width = 1024;
+    int height = 768;
+};
+
+// Encodage PNG/JPEG et écriture sur un thread à part. Les images passent par
+// un pool de tampons : le thread principal n'alloue pas et n'attend jamais,
+// une image sans tampon libre est abandonnée (comptée).
+class PdSnapshotWriter : public ofThread {
+public:
+    static constexpr size_t POOL_SIZE = 4;
+    
+    PdSnapshotWriter();
+    ~PdSnapshotWriter();
+    
+    // Thread principal
+    ofPixels* acquire();
+    void submit(ofPixels* pixels, const string& path);
+    void drop() { numDropped++; }
+    void discard(ofPixels* pixels);
+    
+    // Termine les écritures en attente
+    void close();
+    
+    size_t getNumWritten() const { return numWritten.load(); }
+    size_t getNumDropped() const { return numDropped.load(); }
+
+private:
+    struct Job {
+        ofPixels* pixels;
+        string path;
+    };
+    
+    ofThreadChannel<Job> jobs;
+    std::vector<std::unique_ptr<ofPixels>> buffers;
+    std::vector<ofPixels*> freeBuffers;
+    std::mutex poolMutex;
+    std::atomic<size_t> numWritten;
+    std::atomic<size_t> numDropped;
+    
+    void release(ofPixels* pixels);
+    void threadedFunction() override;
+};
+
+// Rendu hors écran à cadence fixe. La lecture GPU -> CPU passe par deux
+// tampons de pixels : l'image rendue à une capture est lue à la suivante,
+// quand le GPU l'a terminée, sans bloquer la boucle principale.
+class PdSnapshotRecorder {
+public:
+    // Dans le contexte GL (setup de l'application)
+    void setup(const PdSnapshotSettings& settings);
+    bool isEnabled() const { return enabled; }
+    
+    bool isDue(uint64_t nowMicros) const { return enabled && nowMicros >= nextCaptureMicros; }
+    uint64_t getNextDeadline() const { return enabled ? nextCaptureMicros : UINT64_MAX; }
+    
+    // Dessine la scène dans l'image hors écran et lance sa lecture
+    void capture(const std::function<void()>& drawScene, uint64_t nowMicros);
+    
+    // Nombre d'images demandé atteint
+    bool isFinished() const { return settings.maxFrames > 0 && numCaptured >= (size_t)settings.maxFrames; }
+    
+    // Lit la dernière image et attend la fin des écritures
+    void finish();
+    
+    size_t getNumCaptured() const { return numCaptured; }
+    const PdSnapshotWriter& getWriter() const { return writer; }
+    
+    // Position et largeur du numéro "%0Nd" dans le chemin, false s'il n'y en a pas
+    static bool findFrameNumber(const string& path, size_t& start, size_t& end, int& width);
+
+private:
+    PdSnapshotSettings settings;
+    bool enabled = false;
+    
+    ofFbo fbo;
+    ofBufferObject readBuffers[2];
+    int pendingBuffer = -1;   // Tampon dont la lecture est en cours
+    size_t pendingFrame = 0;
+    
+    uint64_t nextCaptureMicros = 0;
+    size_t numCaptured = 0;
+    PdSnapshotWriter writer;
+    
+    void collect(int buffer, size_t frame);
+    string getFramePath(size_t frame) const;
+
+};
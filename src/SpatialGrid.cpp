@@ -0,0 +1,131 @@
+//
+//  SpatialGrid.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 17/07/2025.
+//
+
+#include "SpatialGrid.h"
+
+using namespace std;
+
+PdSpatialGrid::PdSpatialGrid(float cellSize)
+    : cellSize(max(1.0f, cellSize))
+{
+}
+
+void PdSpatialGrid::build(const PdObjectList& objects) {
+    clear();
+    
+    // L'index dans le vecteur est l'ordre z (le dernier est dessiné au-dessus)
+    for (size_t i = 0; i < objects.size(); i++) {
+        insert(objects[i].get(), (int)i);
+    }
+}
+
+void PdSpatialGrid::insert(PdGuiObject* object, int zIndex) {
+    if (!object) return;
+    
+    remove(object);
+    
+    ofRectangle bounds = object->getBounds();
+    indexed[object] = { zIndex, bounds };
+    insertInCells({ zIndex, object }, bounds);
+}
+
+void PdSpatialGrid::remove(PdGuiObject* object) {
+    auto it = indexed.find(object);
+    if (it == indexed.end()) return;
+    
+    removeFromCells(object, it->second.bounds);
+    indexed.erase(it);
+}
+
+void PdSpatialGrid::update(PdGuiObject* object) {
+    auto it = indexed.find(object);
+    if (it == indexed.end()) return;
+    
+    ofRectangle newBounds = object->getBounds();
+    if (newBounds == it->second.bounds) return;
+    
+    // Retirer des anciennes cellules puis réinsérer avec le même ordre z
+    removeFromCells(object, it->second.bounds);
+    it->second.bounds = newBounds;
+    insertInCells({ it->second.zIndex, object }, newBounds);
+}
+
+void PdSpatialGrid::clear() {
+    cells.clear();
+    indexed.clear();
+}
+
+const vector<PdSpatialGrid::Entry>* PdSpatialGrid::getCandidates(float x, float y) const {
+    auto it = cells.find(cellKey(toCell(x), toCell(y)));
+    if (it == cells.end()) return nullptr;
+    return &it->second;
+}
+
+PdGuiObject* PdSpatialGrid::findTopmost(float x, float y, bool enabledOnly) const {
+    const vector<Entry>* candidates = getCandidates(x, y);
+    if (!candidates) return nullptr;
+    
+    for (const Entry& entry : *candidates) {
+        PdGuiObject* obj = entry.object;
+        if (!obj->isVisible()) continue;
+        if (enabledOnly && !obj->isEnabled()) continue;
+        if (obj->isPointInside(x, y)) {
+            return obj;
+        }
+    }
+    
+    return nullptr;
+}
+
+int PdSpatialGrid::toCell(float coord) const {
+    return (int)floor(coord / cellSize);
+}
+
+uint64_t PdSpatialGrid::cellKey(int cx, int cy) {
+    return ((uint64_t)(uint32_t)cx << 32) | (uint32_t)cy;
+}
+
+void PdSpatialGrid::insertInCells(const Entry& entry, const ofRectangle& bounds) {
+    int cx1 = toCell(bounds.getMinX());
+    int cy1 = toCell(bounds.getMinY());
+    int cx2 = toCell(bounds.getMaxX());
+    int cy2 = toCell(bounds.getMaxY());
+    
+    for (int cy = cy1; cy <= cy2; cy++) {
+        for (int cx = cx1; cx <= cx2; cx++) {
+            vector<Entry>& cell = cells[cellKey(cx, cy)];
+            
+            // Garder la cellule triée par z décroissant
+            auto pos = upper_bound(cell.begin(), cell.end(), entry,
+                                   [](const Entry& a, const Entry& b) { return a.zIndex > b.zIndex; });
+            cell.insert(pos, entry);
+        }
+    }
+}
+
+void PdSpatialGrid::removeFromCells(const PdGuiObject* object, const ofRectangle& bounds) {
+    int cx1 = toCell(bounds.getMinX());
+    int cy1 = toCell(bounds.getMinY());
+    int cx2 = toCell(bounds.getMaxX());
+    int cy2 = toCell(bounds.getMaxY());
+    
+    for (int cy = cy1; cy <= cy2; cy++) {
+        for (int cx = cx1; cx <= cx2; cx++) {
+            auto it = cells.find(cellKey(cx, cy));
+            if (it == cells.end()) continue;
+            
+            vector<Entry>& cell = it->second;
+            cell.erase(remove_if(cell.begin(), cell.end(),
+                                 [object](const Entry& e) { return e.object == object; }),
+                       cell.end());
+            
+            if (cell.empty()) {
+                cells.erase(it);
+            }
+        }
+    }
+}
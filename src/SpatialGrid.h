@@ -0,0 +1,58 @@
+//
+//  SpatialGrid.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 17/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "PdGuiObject.h"
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+// Grille uniforme des bornes des objets GUI pour le hit-testing souris.
+// Chaque cellule liste les objets qui la recouvrent, triés du plus haut
+// (dernier dessiné) au plus bas dans l'ordre z.
+class PdSpatialGrid {
+public:
+    struct Entry {
+        int zIndex;
+        PdGuiObject* object;
+    };
+    
+    PdSpatialGrid(float cellSize = 64.0f);
+    
+    // Construction / mise à jour
+    void build(const PdObjectList& objects);
+    void insert(PdGuiObject* object, int zIndex);
+    void remove(PdGuiObject* object);
+    void update(PdGuiObject* object); // Après déplacement ou redimensionnement
+    void clear();
+    
+    // Candidats sous le point, du plus haut au plus bas (nullptr si aucun)
+    const std::vector<Entry>* getCandidates(float x, float y) const;
+    
+    // Premier objet visible contenant le point, en partant du dessus
+    PdGuiObject* findTopmost(float x, float y, bool enabledOnly = true) const;
+    
+    size_t size() const { return indexed.size(); }
+    float getCellSize() const { return cellSize; }
+    
+private:
+    struct IndexedObject {
+        int zIndex;
+        ofRectangle bounds;
+    };
+    
+    float cellSize;
+    std::unordered_map<uint64_t, std::vector<Entry>> cells;
+    std::unordered_map<const PdGuiObject*, IndexedObject> indexed;
+    
+    int toCell(float coord) const;
+    static uint64_t cellKey(int cx, int cy);
+    void insertInCells(const Entry& entry, const ofRectangle& bounds);
+    void removeFromCells(const PdGuiObject* object, const ofRectangle& bounds);
+};
@@ -0,0 +1,91 @@
+//
+//  Subpatch.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 21/07/2025.
+//
+
+#include "Subpatch.h"
+#include "PatchParser.h"
+
+const ofColor PdSubpatch::GOP_BORDER_COLOR = ofColor(150, 150, 150);
+
+PdSubpatch::PdSubpatch(ofVec2f position, const string& name, string source,
+                       const PdGraphOnParent& graphOnParent, int patchFontSize)
+    : PdGuiObject(GuiType::SUBPATCH, position, ofVec2f(0, 0), PdSymbol(), PdSymbol())
+    , name(name)
+    , source(move(source))
+    , graphOnParent(graphOnParent)
+    , patchFontSize(patchFontSize)
+    , instantiated(false)
+    , nameLabel(patchFontSize)
+{
+    nameLabel.set("pd " + name);
+    setFontSize(patchFontSize);
+    
+    if (graphOnParent.enabled) {
+        // Le rectangle GOP a la taille de la fenêtre exposée
+        setSize(ofVec2f(graphOnParent.window.width, graphOnParent.window.height));
+    } else {
+        // Boîte d'objet : largeur estimée du texte "pd nom"
+        float charWidth = PdGlyphAtlas::estimateCharWidth(patchFontSize);
+        setSize(ofVec2f(charWidth * (name.length() + 3) + 4, patchFontSize + 7));
+    }
+}
+
+void PdSubpatch::update() {
+    // Rien à animer
+}
+
+void PdSubpatch::draw() {
+    ofPushStyle();
+    
+    if (graphOnParent.enabled) {
+        // Les objets exposés sont dessinés par-dessus le rectangle
+        ofSetColor(GOP_BORDER_COLOR);
+        ofNoFill();
+        ofDrawRectangle(0, 0, size.x, size.y);
+        ofFill();
+    } else {
+        drawBackground();
+        drawBorder();
+        nameLabel.draw(2, patchFontSize + 2, DEFAULT_FG_COLOR);
+    }
+    
+    ofPopStyle();
+}
+
+bool PdSubpatch::drawBatched(PdPrimitiveBatch& batch) {
+    if (graphOnParent.enabled) {
+        batch.addRectOutline(0, 0, size.x, size.y, GOP_BORDER_COLOR);
+    } else {
+        batchBackground(batch);
+        batchBorder(batch);
+        batch.addText(nameLabel, 2, patchFontSize + 2, DEFAULT_FG_COLOR);
+    }
+    
+    return true;
+}
+
+bool PdSubpatch::onMousePressed(ofMouseEventArgs& args) {
+    if (!enabled || !visible) return false;
+    
+    if (onOpen) {
+        onOpen(*this);
+    }
+    return true;
+}
+
+PdObjectList& PdSubpatch::instantiate() {
+    if (!instantiated) {
+        PdPatchParser parser;
+        objects = parser.parseSubpatch(*this);
+        instantiated = true;
+    }
+    return objects;
+}
+
+void PdSubpatch::release() {
+    objects.clear();
+    instantiated = false;
+}
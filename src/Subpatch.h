@@ -0,0 +1,73 @@
+//
+//  Subpatch.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 21/07/2025.
+//
+
+#pragma once
+
+#include "PdGuiObject.h"
+#include <memory>
+#include <vector>
+
+// Fenêtre graph-on-parent d'un sous-patch (#X coords x1 y1 x2 y2 w h gop xmargin ymargin)
+struct PdGraphOnParent {
+    bool enabled = false;
+    bool hideName = false;
+    ofRectangle window; // Région exposée, en coordonnées du sous-patch
+    
+    // Objet entièrement dans la fenêtre : affiché dans le parent
+    bool exposes(const ofRectangle& bounds) const { return enabled && window.inside(bounds); }
+};
+
+// Boîte "pd nom" (ou rectangle GOP) d'un sous-patch dans son parent.
+// Le contenu est conservé sous forme de texte et n'est instancié qu'à la
+// première ouverture, sans les objets exposés par graph-on-parent : ceux-ci
+// n'existent qu'une fois, dans le parent.
+class PdSubpatch : public PdGuiObject {
+public:
+    PdSubpatch(ofVec2f position, const string& name, string source,
+               const PdGraphOnParent& graphOnParent, int patchFontSize);
+    
+    // Méthodes virtuelles héritées
+    virtual void update() override;
+    virtual void draw() override;
+    virtual bool drawBatched(PdPrimitiveBatch& batch) override;
+    
+    // Un clic ouvre le sous-patch
+    virtual bool onMousePressed(ofMouseEventArgs& args) override;
+    virtual bool onMouseDragged(ofMouseEventArgs& args) override { return false; }
+    virtual bool onMouseReleased(ofMouseEventArgs& args) override { return false; }
+    
+    // Un sous-patch n'a pas de valeur
+    virtual void receiveFloat(float value) override {}
+    virtual void receiveBang() override {}
+    
+    const string& getName() const { return name; }
+    const string& getSource() const { return source; }
+    const PdGraphOnParent& getGraphOnParent() const { return graphOnParent; }
+    int getPatchFontSize() const { return patchFontSize; }
+    
+    // Contenu du sous-patch, parsé à la demande
+    bool isInstantiated() const { return instantiated; }
+    PdObjectList& instantiate();
+    PdObjectList& getObjects() { return objects; }
+    void release();
+    
+    // Appelé quand l'utilisateur ouvre le sous-patch
+    std::function<void(PdSubpatch&)> onOpen;
+    
+private:
+    string name;
+    string source;
+    PdGraphOnParent graphOnParent;
+    int patchFontSize;
+    
+    bool instantiated;
+    PdObjectList objects;
+    
+    PdTextLabel nameLabel;
+    
+    static const ofColor GOP_BORDER_COLOR;
+};
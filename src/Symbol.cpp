@@ -0,0 +1,121 @@
+//
+//  Symbol.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 20/07/2025.
+//
+
+#include "Symbol.h"
+#include <functional>
+
+PdSymbolTable& PdSymbolTable::get() {
+    static PdSymbolTable table;
+    return table;
+}
+
+PdSymbolTable::PdSymbolTable()
+    : count(0)
+    , index(nullptr)
+{
+    for (auto& chunk : chunks) chunk.store(nullptr, std::memory_order_relaxed);
+    
+    // L'id 0 est réservé au symbole vide
+    chunks[0].store(new string[CHUNK_SIZE], std::memory_order_relaxed);
+    count.store(1, std::memory_order_release);
+    
+    indices.push_back(std::make_unique<Index>());
+    Index& first = *indices.back();
+    first.mask = 1024 - 1;
+    first.slots.reset(new std::atomic<PdSymbolId>[first.mask + 1]);
+    for (size_t i = 0; i <= first.mask; i++) first.slots[i].store(PD_EMPTY_SYMBOL, std::memory_order_relaxed);
+    index.store(&first, std::memory_order_release);
+}
+
+PdSymbolTable::~PdSymbolTable() {
+    for (auto& chunk : chunks) delete[] chunk.load(std::memory_order_relaxed);
+}
+
+bool PdSymbolTable::isEmptyName(std::string_view name) {
+    return name.empty() || name == "empty" || name == "-";
+}
+
+PdSymbolId PdSymbolTable::intern(const string& name) {
+    return intern(std::string_view(name));
+}
+
+PdSymbolId PdSymbolTable::intern(std::string_view name) {
+    if (isEmptyName(name)) return PD_EMPTY_SYMBOL;
+    
+    PdSymbolId id = find(name);
+    if (id != PD_EMPTY_SYMBOL) return id;
+    
+    id = count.load(std::memory_order_relaxed);
+    size_t chunkIndex = id >> CHUNK_BITS;
+    if (chunkIndex >= MAX_CHUNKS) {
+        ofLogError("PdSymbolTable") << "Symbol table full, ignoring " << name;
+        return PD_EMPTY_SYMBOL;
+    }
+    
+    string* chunk = chunks[chunkIndex].load(std::memory_order_relaxed);
+    if (!chunk) {
+        chunk = new string[CHUNK_SIZE];
+        chunks[chunkIndex].store(chunk, std::memory_order_release);
+    }
+    chunk[id & (CHUNK_SIZE - 1)].assign(name.data(), name.size());
+    
+    // Le nom est publié avant l'id : un lecteur qui trouve l'id lit un nom complet
+    count.store(id + 1, std::memory_order_release);
+    
+    // Au plus une case sur deux occupée
+    const Index* current = index.load(std::memory_order_relaxed);
+    if ((size_t)(id + 1) * 2 > current->mask + 1) {
+        grow();
+    } else {
+        insert(*indices.back(), id, name);
+    }
+    return id;
+}
+
+void PdSymbolTable::insert(Index& target, PdSymbolId id, std::string_view name) {
+    size_t slot = std::hash<std::string_view>()(name) & target.mask;
+    while (target.slots[slot].load(std::memory_order_relaxed) != PD_EMPTY_SYMBOL) {
+        slot = (slot + 1) & target.mask;
+    }
+    target.slots[slot].store(id, std::memory_order_release);
+}
+
+void PdSymbolTable::grow() {
+    // Nouvel index rempli à part, puis publié ; l'ancien reste lisible
+    const Index& current = *indices.back();
+    auto next = std::make_unique<Index>();
+    next->mask = (current.mask << 1) | 1;
+    next->slots.reset(new std::atomic<PdSymbolId>[next->mask + 1]);
+    for (size_t i = 0; i <= next->mask; i++) next->slots[i].store(PD_EMPTY_SYMBOL, std::memory_order_relaxed);
+    
+    PdSymbolId numSymbols = count.load(std::memory_order_relaxed);
+    for (PdSymbolId id = 1; id < numSymbols; id++) {
+        insert(*next, id, getName(id));
+    }
+    
+    index.store(next.get(), std::memory_order_release);
+    indices.push_back(std::move(next));
+}
+
+PdSymbolId PdSymbolTable::find(std::string_view name) const {
+    if (isEmptyName(name)) return PD_EMPTY_SYMBOL;
+    
+    const Index* current = index.load(std::memory_order_acquire);
+    size_t slot = std::hash<std::string_view>()(name) & current->mask;
+    while (true) {
+        PdSymbolId id = current->slots[slot].load(std::memory_order_acquire);
+        if (id == PD_EMPTY_SYMBOL) return PD_EMPTY_SYMBOL;
+        if (getName(id) == name) return id;
+        slot = (slot + 1) & current->mask;
+    }
+}
+
+const string& PdSymbolTable::getName(PdSymbolId id) const {
+    if (id >= count.load(std::memory_order_acquire)) id = PD_EMPTY_SYMBOL;
+    const string* chunk = chunks[id >> CHUNK_BITS].load(std::memory_order_acquire);
+    return chunk[id & (CHUNK_SIZE - 1)];
+}
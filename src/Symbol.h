@@ -0,0 +1,95 @@
+//
+//  Symbol.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 20/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Identifiant d'un symbole interné ; 0 est le symbole vide
+typedef uint32_t PdSymbolId;
+static constexpr PdSymbolId PD_EMPTY_SYMBOL = 0;
+
+// Table globale des symboles, équivalent de gensym() dans Pd.
+// Un seul écrivain : intern() n'est appelé que depuis le thread principal
+// (chargement, rechargement, presets), à tout moment. find() et getName()
+// sont lisibles depuis n'importe quel thread (audio, Pd, réseau) sans verrou
+// ni allocation : les noms sont rangés dans des blocs jamais déplacés, et
+// l'index de recherche agrandi est une copie publiée atomiquement, l'ancienne
+// restant valide pour les lecteurs en cours.
+class PdSymbolTable {
+public:
+    static PdSymbolTable& get();
+    ~PdSymbolTable();
+    
+    // Thread principal. "", "empty" (iemgui) et "-" (atomes) donnent le symbole vide
+    PdSymbolId intern(const string& name);
+    PdSymbolId intern(std::string_view name);
+    
+    // N'importe quel thread : recherche sans créer ; PD_EMPTY_SYMBOL si inconnu
+    PdSymbolId find(std::string_view name) const;
+    
+    const string& getName(PdSymbolId id) const;
+    size_t size() const { return count.load(std::memory_order_acquire); }
+    
+    static bool isEmptyName(std::string_view name);
+    
+private:
+    PdSymbolTable();
+    
+    // Noms par blocs de CHUNK_SIZE, alloués à la demande (4 M symboles au plus)
+    static constexpr size_t CHUNK_BITS = 10;
+    static constexpr size_t CHUNK_SIZE = 1 << CHUNK_BITS;
+    static constexpr size_t MAX_CHUNKS = 4096;
+    
+    // Adressage ouvert, ids rangés par hachage du nom (0 = case libre)
+    struct Index {
+        size_t mask;
+        std::unique_ptr<std::atomic<PdSymbolId>[]> slots;
+    };
+    
+    std::atomic<string*> chunks[MAX_CHUNKS];
+    std::atomic<uint32_t> count;
+    std::atomic<const Index*> index;
+    std::vector<std::unique_ptr<Index>> indices; // Index remplacés, libérés avec la table
+    
+    void insert(Index& target, PdSymbolId id, std::string_view name);
+    void grow();
+};
+
+// Symbole interné, passé par valeur (un entier)
+class PdSymbol {
+public:
+    PdSymbol() : id(PD_EMPTY_SYMBOL) {}
+    PdSymbol(const string& name) : id(PdSymbolTable::get().intern(name)) {}
+    PdSymbol(const char* name) : id(PdSymbolTable::get().intern(std::string_view(name))) {}
+    PdSymbol(std::string_view name) : id(PdSymbolTable::get().intern(name)) {}
+    
+    static PdSymbol fromId(PdSymbolId id) { PdSymbol s; s.id = id; return s; }
+    
+    PdSymbolId getId() const { return id; }
+    bool isEmpty() const { return id == PD_EMPTY_SYMBOL; }
+    const string& getName() const { return PdSymbolTable::get().getName(id); }
+    
+    bool operator==(const PdSymbol& other) const { return id == other.id; }
+    bool operator!=(const PdSymbol& other) const { return id != other.id; }
+    
+private:
+    PdSymbolId id;
+};
+
+inline PdSymbol gensym(const string& name) {
+    return PdSymbol(name);
+}
+
+inline PdSymbol gensym(std::string_view name) {
+    return PdSymbol(name);
+}
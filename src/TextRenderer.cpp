@@ -0,0 +1,138 @@
+//
+//  TextRenderer.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 18/07/2025.
+//
+
+#include "TextRenderer.h"
+
+const int PdGlyphAtlas::DEFAULT_FONT_SIZE = 12;
+
+PdGlyphAtlas& PdGlyphAtlas::get() {
+    static PdGlyphAtlas atlas;
+    return atlas;
+}
+
+PdGlyphAtlas::PdGlyphAtlas()
+    : fontFile("DejaVuSansMono.ttf")
+    , fontMissing(false)
+{
+}
+
+void PdGlyphAtlas::setFontFile(const string& fontFile) {
+    this->fontFile = fontFile;
+    fontMissing = false;
+    fonts.clear();
+}
+
+const ofTrueTypeFont* PdGlyphAtlas::getFont(int fontSize) {
+    if (fontMissing) return nullptr;
+    
+    auto it = fonts.find(fontSize);
+    if (it != fonts.end()) return it->second.get();
+    
+    if (!ofFile::doesFileExist(fontFile)) {
+        ofLogWarning("PdGlyphAtlas") << "Font not found: " << fontFile << ", using bitmap font";
+        fontMissing = true;
+        return nullptr;
+    }
+    
+    // 72 dpi : la taille de police Pd correspond à la hauteur en pixels
+    auto font = make_unique<ofTrueTypeFont>();
+    if (!font->load(fontFile, fontSize, true, false, false, 0.3f, 72)) {
+        ofLogWarning("PdGlyphAtlas") << "Cannot load font " << fontFile << ", using bitmap font";
+        fontMissing = true;
+        return nullptr;
+    }
+    
+    const ofTrueTypeFont* result = font.get();
+    fonts[fontSize] = move(font);
+    return result;
+}
+
+const ofTexture* PdGlyphAtlas::layout(const string& text, int fontSize, ofMesh& mesh, float& width) {
+    const ofTrueTypeFont* font = getFont(fontSize);
+    
+    if (font) {
+        mesh = font->getStringMesh(text, 0, 0);
+        width = font->stringWidth(text);
+        return &font->getFontTexture();
+    }
+    
+    // Même maillage que ofDrawBitmapString (glyphes de 8 pixels)
+    mesh = bitmapFont.getMesh(text, 0, 0, OF_BITMAPMODE_MODEL);
+    width = text.length() * 8;
+    return &bitmapFont.getTexture();
+}
+
+float PdGlyphAtlas::getStringWidth(const string& text, int fontSize) {
+    const ofTrueTypeFont* font = getFont(fontSize);
+    return font ? font->stringWidth(text) : text.length() * 8;
+}
+
+float PdGlyphAtlas::estimateCharWidth(int fontSize) {
+    // DejaVu Sans Mono avance de 0.6 em, la police bitmap fait 8 pixels
+    return max(8.0f, ceil(fontSize * 0.61f));
+}
+
+PdTextLabel::PdTextLabel(int fontSize)
+    : fontSize(fontSize)
+    , texture(nullptr)
+    , width(0)
+    , layoutDirty(true)
+{
+}
+
+void PdTextLabel::set(const string& text) {
+    set(text.data(), text.length());
+}
+
+void PdTextLabel::set(const char* text, size_t length) {
+    if (this->text.length() == length && this->text.compare(0, length, text, length) == 0) return;
+    
+    // assign() réutilise la capacité existante de la chaîne
+    this->text.assign(text, length);
+    layoutDirty = true;
+}
+
+void PdTextLabel::setFontSize(int fontSize) {
+    if (this->fontSize == fontSize) return;
+    this->fontSize = fontSize;
+    layoutDirty = true;
+}
+
+const ofMesh& PdTextLabel::getMesh() const {
+    if (layoutDirty) layout();
+    return mesh;
+}
+
+const ofTexture* PdTextLabel::getTexture() const {
+    if (layoutDirty) layout();
+    return texture;
+}
+
+float PdTextLabel::getWidth() const {
+    if (layoutDirty) layout();
+    return width;
+}
+
+void PdTextLabel::draw(float x, float y, const ofColor& color) const {
+    if (text.empty()) return;
+    if (layoutDirty) layout();
+    
+    ofPushMatrix();
+    ofTranslate(x, y);
+    ofSetColor(color);
+    texture->bind();
+    mesh.draw();
+    texture->unbind();
+    ofPopMatrix();
+}
+
+void PdTextLabel::layout() const {
+    mesh.clear();
+    width = 0;
+    texture = PdGlyphAtlas::get().layout(text, fontSize, mesh, width);
+    layoutDirty = false;
+}
@@ -0,0 +1,81 @@
+//
+//  TextRenderer.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 18/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include <map>
+#include <memory>
+#include <string>
+
+// Atlas de glyphes partagé par tous les objets (et toutes les fenêtres).
+// Charge la police de Pure Data (DejaVu Sans Mono) à chaque taille demandée,
+// ou retombe sur la police bitmap d'openFrameworks si le fichier est absent.
+class PdGlyphAtlas {
+public:
+    static PdGlyphAtlas& get();
+    
+    // Police TrueType à charger depuis bin/data
+    void setFontFile(const string& fontFile);
+    
+    // Met le texte en forme dans mesh (quads de glyphes, origine sur la ligne de base).
+    // Retourne la texture de l'atlas utilisé.
+    const ofTexture* layout(const string& text, int fontSize, ofMesh& mesh, float& width);
+    
+    float getStringWidth(const string& text, int fontSize);
+    bool hasTrueTypeFont() const { return !fontMissing; }
+    
+    // Majorant de la largeur d'un caractère, sans contexte GL (calcul des zones sales)
+    static float estimateCharWidth(int fontSize);
+    
+    static const int DEFAULT_FONT_SIZE;
+    
+private:
+    PdGlyphAtlas();
+    
+    const ofTrueTypeFont* getFont(int fontSize);
+    
+    string fontFile;
+    bool fontMissing;
+    std::map<int, std::unique_ptr<ofTrueTypeFont>> fonts;
+    ofBitmapFont bitmapFont;
+};
+
+// Texte mis en forme une seule fois puis mis en cache.
+// La mise en page n'est refaite que lorsque la chaîne ou la taille change.
+class PdTextLabel {
+public:
+    PdTextLabel(int fontSize = PdGlyphAtlas::DEFAULT_FONT_SIZE);
+    
+    // Mettre à jour le texte (sans effet si identique)
+    void set(const string& text);
+    void set(const char* text, size_t length);
+    void setFontSize(int fontSize);
+    
+    const string& getText() const { return text; }
+    int getFontSize() const { return fontSize; }
+    bool empty() const { return text.empty(); }
+    
+    // Données mises en forme (calculées à la première utilisation)
+    const ofMesh& getMesh() const;
+    const ofTexture* getTexture() const;
+    float getWidth() const;
+    
+    // Dessin immédiat, y = ligne de base
+    void draw(float x, float y, const ofColor& color) const;
+    
+private:
+    string text;
+    int fontSize;
+    
+    mutable ofMesh mesh;
+    mutable const ofTexture* texture;
+    mutable float width;
+    mutable bool layoutDirty;
+    
+    void layout() const;
+};
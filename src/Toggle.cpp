@@ -15,13 +15,16 @@ const ofColor PdToggle::TOGGLE_OFF_COLOR = ofColor(220, 220, 220);
 const ofColor PdToggle::TOGGLE_HOVER_COLOR = ofColor(250, 250, 250);
 
 PdToggle::PdToggle(ofVec2f position, ofVec2f size,
-                   const string& sendSymbol, const string& receiveSymbol)
+                   PdSymbol sendSymbol, PdSymbol receiveSymbol)
     : PdGuiObject(GuiType::TOGGLE, position, size, sendSymbol, receiveSymbol)
 {
     // Initialiser les valeurs spécifiques au toggle
     minValue = 0.0f;
     maxValue = 1.0f;
     currentValue = 0.0f;
+    
+    // Chaque changement d'état doit arriver à Pd
+    sendPolicy = PdSendPolicy::IMMEDIATE;
 }
 
 void PdToggle::update() {
@@ -41,6 +44,19 @@ void PdToggle::draw() {
     //drawLabel();
 }
 
+bool PdToggle::drawBatched(PdPrimitiveBatch& batch) {
+    batch.addRect(0, 0, size.x, size.y, getStateColor());
+    
+    if (isOn()) {
+        float margin = 2.0f;
+        batch.addRect(margin, margin, size.x - 2 * margin, size.y - 2 * margin,
+                      TOGGLE_ON_COLOR * 0.7f);
+    }
+    
+    batch.addRectOutline(0, 0, size.x, size.y, getBorderColor());
+    return true;
+}
+
 bool PdToggle::onMousePressed(ofMouseEventArgs& args) {
     // Appeler la méthode de base pour la gestion générale
     bool handled = PdGuiObject::onMousePressed(args);
@@ -61,12 +77,27 @@ bool PdToggle::onMouseReleased(ofMouseEventArgs& args) {
     return PdGuiObject::onMouseReleased(args);
 }
 
+void PdToggle::receiveFloat(float value) {
+    // Toute valeur non nulle allume le toggle
+    setOn(value != 0.0f);
+}
+
+void PdToggle::receiveBang() {
+    // Un bang inverse l'état et le renvoie, comme dans Pd
+    toggle();
+    sendToPd(currentValue);
+}
+
 void PdToggle::toggle() {
     // Inverser l'état
     setOn(!isOn());
 }
 
-void PdToggle::drawToggleState() {
+uint64_t PdToggle::computeRenderKey() const {
+    return getBaseRenderKey() | ((uint64_t)isOn() << 4);
+}
+
+ofColor PdToggle::getStateColor() const {
     // Déterminer la couleur de fond selon l'état
     ofColor bgColor;
     
@@ -88,8 +119,27 @@ void PdToggle::drawToggleState() {
         bgColor = bgColor * 0.5f;
     }
     
+    return bgColor;
+}
+
+ofColor PdToggle::getBorderColor() const {
+    // Couleur de bordure selon l'état
+    ofColor borderColor = TOGGLE_BORDER_COLOR;
+    
+    if (mouseOver) {
+        borderColor = borderColor * 0.7f; // Plus sombre au survol
+    }
+    
+    if (!enabled) {
+        borderColor = borderColor * 0.5f;
+    }
+    
+    return borderColor;
+}
+
+void PdToggle::drawToggleState() {
     // Dessiner le rectangle de fond
-    ofSetColor(bgColor);
+    ofSetColor(getStateColor());
     ofFill();
     ofDrawRectangle(0, 0, size.x, size.y);
     
@@ -106,19 +156,8 @@ void PdToggle::drawToggleState() {
 }
 
 void PdToggle::drawToggleBorder() {
-    // Couleur de bordure selon l'état
-    ofColor borderColor = TOGGLE_BORDER_COLOR;
-    
-    if (mouseOver) {
-        borderColor = borderColor * 0.7f; // Plus sombre au survol
-    }
-    
-    if (!enabled) {
-        borderColor = borderColor * 0.5f;
-    }
-    
     // Dessiner la bordure
-    ofSetColor(borderColor);
+    ofSetColor(getBorderColor());
     ofNoFill();
     ofSetLineWidth(1.0f);
     ofDrawRectangle(0, 0, size.x, size.y);
@@ -14,16 +14,21 @@ class PdToggle : public PdGuiObject {
 public:
     // Constructeur
     PdToggle(ofVec2f position, ofVec2f size,
-             const string& sendSymbol, const string& receiveSymbol);
+             PdSymbol sendSymbol, PdSymbol receiveSymbol);
     
     // Méthodes virtuelles obligatoires
     void update() override;
     void draw() override;
+    bool drawBatched(PdPrimitiveBatch& batch) override;
     
     // Gestion des événements souris (surcharge)
     bool onMousePressed(ofMouseEventArgs& args) override;
     bool onMouseReleased(ofMouseEventArgs& args) override;
     
+    // Messages reçus de Pure Data
+    void receiveFloat(float value) override;
+    void receiveBang() override;
+    
     // Méthodes spécifiques au toggle
     void toggle();
     bool isOn() const { return currentValue > 0.5f; }
@@ -40,4 +45,9 @@ private:
     // Méthodes de dessin privées
     void drawToggleState();
     void drawToggleBorder();
+    ofColor getStateColor() const;
+    ofColor getBorderColor() const;
+    
+    // Clé de rendu : allumé/éteint et états de la souris
+    uint64_t computeRenderKey() const override;
 };
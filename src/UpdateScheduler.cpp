@@ -0,0 +1,45 @@
+//
+//  UpdateScheduler.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 23/07/2025.
+//
+
+#include "UpdateScheduler.h"
+#include "WidgetStore.h"
+#include <algorithm>
+
+PdUpdateScheduler& PdUpdateScheduler::get() {
+    static PdUpdateScheduler scheduler;
+    return scheduler;
+}
+
+void PdUpdateScheduler::schedule(const PdWidgetHandle& handle, uint64_t deadlineMicros) {
+    if (!handle.isValid()) return;
+    
+    heap.push_back({deadlineMicros, handle});
+    std::push_heap(heap.begin(), heap.end(), Later());
+}
+
+size_t PdUpdateScheduler::run(uint64_t nowMicros) {
+    due.clear();
+    while (!heap.empty() && heap.front().deadlineMicros <= nowMicros) {
+        due.push_back(heap.front().handle);
+        std::pop_heap(heap.begin(), heap.end(), Later());
+        heap.pop_back();
+    }
+    
+    PdWidgetStore& store = PdWidgetStore::get();
+    for (auto& handle : due) {
+        // Objet détruit depuis : handle périmé, rien à faire
+        if (PdGuiObject* object = store.resolve(handle)) {
+            object->update();
+        }
+    }
+    
+    return due.size();
+}
+
+void PdUpdateScheduler::clear() {
+    heap.clear();
+}
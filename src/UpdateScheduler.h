@@ -0,0 +1,51 @@
+//
+//  UpdateScheduler.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 23/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "WidgetHandle.h"
+#include <cstdint>
+#include <vector>
+
+// Échéance enregistrée par un objet (fin de flash d'un bang, animation...)
+struct PdScheduledUpdate {
+    uint64_t deadlineMicros;
+    PdWidgetHandle handle;
+};
+
+// Tas min des échéances : à chaque frame, seuls les objets dont l'échéance
+// est passée reçoivent update(). Un objet inactif ne coûte rien.
+class PdUpdateScheduler {
+public:
+    static PdUpdateScheduler& get();
+    
+    // Plusieurs échéances par objet sont permises : update() revérifie l'état
+    void schedule(const PdWidgetHandle& handle, uint64_t deadlineMicros);
+    
+    // Appelle update() sur les objets échus, retourne leur nombre
+    size_t run(uint64_t nowMicros);
+    
+    bool empty() const { return heap.empty(); }
+    size_t getNumPending() const { return heap.size(); }
+    uint64_t getNextDeadline() const { return heap.empty() ? UINT64_MAX : heap.front().deadlineMicros; }
+    void clear();
+    
+private:
+    PdUpdateScheduler() = default;
+    
+    struct Later {
+        bool operator()(const PdScheduledUpdate& a, const PdScheduledUpdate& b) const {
+            return a.deadlineMicros > b.deadlineMicros;
+        }
+    };
+    
+    std::vector<PdScheduledUpdate> heap;
+    
+    // Échéances sorties du tas avant l'appel à update(), qui peut en reprogrammer
+    std::vector<PdWidgetHandle> due;
+};
@@ -0,0 +1,173 @@
+//
+//  ValueSmoother.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#include "ValueSmoother.h"
+#include "PdGuiObject.h"
+#include "WidgetStore.h"
+#include "JobSystem.h"
+#include <cmath>
+
+PdValueSmoother& PdValueSmoother::get() {
+    static PdValueSmoother smoother;
+    return smoother;
+}
+
+void PdValueSmoother::setTarget(PdGuiObject& object, float target, float quantum, bool smooth) {
+    float inverseQuantum = 1.0f / quantum;
+    
+    if (object.smootherEntry >= 0) {
+        size_t entry = object.smootherEntry;
+        targets[entry] = target;
+        inverseQuanta[entry] = inverseQuantum;
+        return;
+    }
+    
+    object.smootherEntry = (int)handles.size();
+    handles.push_back(object.getStoreHandle());
+    targets.push_back(target);
+    displayed.push_back(object.displayValue);
+    minCoefficients.push_back(smooth ? 0.0f : 1.0f);
+    inverseQuanta.push_back(inverseQuantum);
+    displayedSteps.push_back(std::floor(object.displayValue * inverseQuantum + 0.5f));
+    changed.push_back(0);
+}
+
+void PdValueSmoother::cancel(PdGuiObject& object) {
+    if (object.smootherEntry < 0) return;
+    
+    removeAt(object.smootherEntry);
+    object.smootherEntry = -1;
+}
+
+size_t PdValueSmoother::run(uint64_t nowMicros) {
+    // Après une pause (rendu à la demande), le coefficient vaut 1 : l'affichage
+    // rejoint directement la cible
+    float dt = lastRunMicros > 0 ? (nowMicros - lastRunMicros) * 1e-6f : 0.0f;
+    lastRunMicros = nowMicros;
+    
+    size_t count = handles.size();
+    if (count == 0) return 0;
+    
+    float coefficient = dt > 0.0f ? 1.0f - std::exp(-dt / TIME_CONSTANT) : 1.0f;
+    
+    // Lissage et clés de rendu par tranches, sur les threads de PdJobSystem :
+    // chaque tranche n'écrit que dans ses entrées et dans displayValue
+    objects.resize(count);
+    renderKeys.resize(count);
+    PdJobSystem::get().parallelFor(count, MIN_CHUNK, [this, coefficient](size_t begin, size_t end) {
+        advance(begin, end, coefficient);
+    });
+    
+    // Objets dont le rendu change, entrées arrivées à la cible. En partant de
+    // la fin, une entrée déplacée par removeAt() a déjà été traitée.
+    size_t numRedrawn = 0;
+    
+    for (size_t i = count; i-- > 0;) {
+        PdGuiObject* object = objects[i];
+        if (!object) {
+            // Objet détruit depuis : handle périmé
+            removeAt(i);
+            continue;
+        }
+        
+        // Le pas du lissage peut ne pas tomber sur une limite de pixel de
+        // l'objet : à l'arrivée, la clé de rendu tranche
+        bool settled = displayed[i] == targets[i];
+        if ((changed[i] || settled) && object->markIfRenderChanged(renderKeys[i])) {
+            numRedrawn++;
+        }
+        
+        if (settled) {
+            removeAt(i);
+            object->smootherEntry = -1;
+        }
+    }
+    
+    return numRedrawn;
+}
+
+void PdValueSmoother::advance(size_t begin, size_t end, float coefficient) {
+    // Passe sans branche ni appel sur les tableaux contigus : vectorisée par
+    // le compilateur (SSE/NEON selon la cible)
+    const float* __restrict target = targets.data();
+    float* __restrict value = displayed.data();
+    const float* __restrict minCoefficient = minCoefficients.data();
+    const float* __restrict inverseQuantum = inverseQuanta.data();
+    float* __restrict steps = displayedSteps.data();
+    uint8_t* __restrict stepChanged = changed.data();
+    
+    for (size_t i = begin; i < end; i++) {
+        float k = std::max(coefficient, minCoefficient[i]);
+        float next = value[i] + (target[i] - value[i]) * k;
+        
+        // À moins d'un demi-quantum de la cible : rien ne bougera plus à l'écran
+        float remaining = (target[i] - next) * inverseQuantum[i];
+        next = (remaining > -0.5f && remaining < 0.5f) ? target[i] : next;
+        value[i] = next;
+        
+        float step = std::floor(next * inverseQuantum[i] + 0.5f);
+        stepChanged[i] = step != steps[i];
+        steps[i] = step;
+    }
+    
+    // Valeur affichée et clé de rendu (position du knob, texte formaté) des
+    // objets qui bougent d'un pas ou arrivent à la cible
+    const PdWidgetStore& store = PdWidgetStore::get();
+    for (size_t i = begin; i < end; i++) {
+        PdGuiObject* object = store.resolve(handles[i]);
+        objects[i] = object;
+        if (!object) continue;
+        
+        object->displayValue = value[i];
+        if (stepChanged[i] || value[i] == target[i]) {
+            renderKeys[i] = object->computeRenderKey();
+        }
+    }
+}
+
+void PdValueSmoother::clear() {
+    PdWidgetStore& store = PdWidgetStore::get();
+    for (auto& handle : handles) {
+        if (PdGuiObject* object = store.resolve(handle)) {
+            object->smootherEntry = -1;
+        }
+    }
+    
+    handles.clear();
+    targets.clear();
+    displayed.clear();
+    minCoefficients.clear();
+    inverseQuanta.clear();
+    displayedSteps.clear();
+    changed.clear();
+}
+
+void PdValueSmoother::removeAt(size_t index) {
+    size_t last = handles.size() - 1;
+    
+    if (index != last) {
+        handles[index] = handles[last];
+        targets[index] = targets[last];
+        displayed[index] = displayed[last];
+        minCoefficients[index] = minCoefficients[last];
+        inverseQuanta[index] = inverseQuanta[last];
+        displayedSteps[index] = displayedSteps[last];
+        changed[index] = changed[last];
+        
+        if (PdGuiObject* moved = PdWidgetStore::get().resolve(handles[index])) {
+            moved->smootherEntry = (int)index;
+        }
+    }
+    
+    handles.pop_back();
+    targets.pop_back();
+    displayed.pop_back();
+    minCoefficients.pop_back();
+    inverseQuanta.pop_back();
+    displayedSteps.pop_back();
+    changed.pop_back();
+}
@@ -0,0 +1,63 @@
+//
+//  ValueSmoother.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "WidgetHandle.h"
+#include <cstdint>
+#include <vector>
+
+class PdGuiObject;
+
+// Valeurs reçues de Pd à haute cadence (enveloppes, vu-mètres) : un message
+// ne fait que déplacer la cible de l'objet. Une fois par frame, run() rapproche
+// toutes les valeurs affichées de leur cible en une passe sur des tableaux
+// contigus, et ne marque sale qu'un objet dont le rendu change (position du
+// knob, texte de la valeur). Objets du store seulement, comme PdUpdateScheduler.
+class PdValueSmoother {
+public:
+    static PdValueSmoother& get();
+    
+    // Constante de temps du lissage exponentiel (sliders)
+    static constexpr float TIME_CONSTANT = 0.03f;
+    // Entrées par tranche de PdJobSystem : un seul patch reste sur le thread principal
+    static constexpr size_t MIN_CHUNK = 2048;
+    
+    // quantum : plus petit écart de valeur visible. Sans lissage, l'affichage
+    // prend la dernière cible reçue à la frame suivante.
+    void setTarget(PdGuiObject& object, float target, float quantum, bool smooth);
+    void cancel(PdGuiObject& object);
+    
+    // Avance les valeurs affichées, retourne le nombre d'objets marqués sales
+    size_t run(uint64_t nowMicros);
+    
+    bool empty() const { return handles.empty(); }
+    size_t getNumActive() const { return handles.size(); }
+    void clear();
+
+private:
+    PdValueSmoother() = default;
+    
+    void removeAt(size_t index);
+    void advance(size_t begin, size_t end, float coefficient);
+    
+    // Une entrée par objet en cours de lissage (tableaux parallèles)
+    std::vector<PdWidgetHandle> handles;
+    std::vector<float> targets;
+    std::vector<float> displayed;
+    std::vector<float> minCoefficients;   // 1 = sans lissage
+    std::vector<float> inverseQuanta;
+    std::vector<float> displayedSteps;    // Valeur affichée en quanta, arrondie
+    std::vector<uint8_t> changed;
+    
+    // Résultats de la passe parallèle, appliqués ensuite sur le thread principal
+    std::vector<PdGuiObject*> objects;
+    std::vector<uint64_t> renderKeys;
+    
+    uint64_t lastRunMicros = 0;
+};
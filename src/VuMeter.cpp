@@ -0,0 +1,157 @@
+//
+//  VuMeter.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#include "VuMeter.h"
+
+// Couleurs des segments : vert, jaune à partir de -12 dB, rouge au-dessus de 0 dB
+const ofColor PdVuMeter::VU_BG_COLOR = ofColor(64, 64, 64);
+const ofColor PdVuMeter::VU_LOW_COLOR = ofColor(40, 200, 40);
+const ofColor PdVuMeter::VU_MID_COLOR = ofColor(230, 210, 40);
+const ofColor PdVuMeter::VU_HIGH_COLOR = ofColor(220, 40, 40);
+
+PdVuMeter::PdVuMeter(ofVec2f position, ofVec2f size, PdSymbol receiveSymbol, bool showScale)
+    : PdGuiObject(GuiType::VU_METER, position, size, PdSymbol(), receiveSymbol)
+    , showScale(showScale)
+    , peakLeds(0)
+    , peakTimeMicros(0)
+    , peakWakeMicros(0)
+{
+    // [vu] accepte de -100 dB (silence) à +12 dB
+    setValueRange(-100.0f, MAX_DB);
+    setValue(-100.0f);
+}
+
+void PdVuMeter::update() {
+    uint64_t now = ofGetElapsedTimeMicros();
+    if (peakWakeMicros != 0 && now >= peakWakeMicros) {
+        peakWakeMicros = 0;
+    }
+    
+    // Fin du maintien : le pic redescend au niveau courant
+    int litLeds = levelToLeds(displayValue);
+    if (peakLeds > litLeds && now - peakTimeMicros >= PEAK_HOLD_MICROS) {
+        peakLeds = litLeds;
+        markIfRenderChanged();
+    }
+    schedulePeakRelease(now);
+}
+
+void PdVuMeter::receiveFloat(float value) {
+    PdGuiObject::receiveFloat(value);
+    
+    // Le pic suit la cible, le maintien repart à chaque nouveau pic ou
+    // quand le niveau l'atteint de nouveau
+    uint64_t now = ofGetElapsedTimeMicros();
+    int leds = levelToLeds(currentValue);
+    if (leds > peakLeds) {
+        peakLeds = leds;
+        markIfRenderChanged();
+    }
+    if (leds == peakLeds) {
+        peakTimeMicros = now;
+    }
+    schedulePeakRelease(now);
+}
+
+void PdVuMeter::schedulePeakRelease(uint64_t nowMicros) {
+    // Une seule échéance à la fois, même à la cadence de l'audio ; rien à
+    // relâcher tant que le niveau reste au pic
+    if (peakWakeMicros != 0 || peakLeds <= levelToLeds(currentValue)) return;
+    
+    uint64_t elapsed = nowMicros - peakTimeMicros;
+    uint64_t delay = elapsed >= PEAK_HOLD_MICROS ? 0 : PEAK_HOLD_MICROS - elapsed;
+    peakWakeMicros = nowMicros + delay;
+    scheduleUpdate(delay);
+}
+
+void PdVuMeter::draw() {
+    ofFill();
+    ofSetColor(VU_BG_COLOR);
+    ofDrawRectangle(0, 0, size.x, size.y);
+    
+    int litLeds = levelToLeds(displayValue);
+    for (int led = 0; led < litLeds; led++) {
+        ofSetColor(getLedColor(led));
+        ofDrawRectangle(getLedBounds(led));
+    }
+    if (peakLeds > litLeds) {
+        ofSetColor(getLedColor(peakLeds - 1));
+        ofDrawRectangle(getLedBounds(peakLeds - 1));
+    }
+    
+    ofSetColor(DEFAULT_BORDER_COLOR);
+    if (showScale) {
+        // Repères à -48, -24, -12, 0 et +12 dB
+        for (float db = MAX_DB; db > MIN_DB; db -= 12.0f) {
+            if (db == -36.0f) continue;
+            float y = size.y * (MAX_DB - db) / (MAX_DB - MIN_DB);
+            ofDrawLine(size.x, y, size.x + SCALE_TICK_LENGTH, y);
+        }
+    }
+    
+    ofNoFill();
+    ofDrawRectangle(0, 0, size.x, size.y);
+    ofFill();
+}
+
+bool PdVuMeter::drawBatched(PdPrimitiveBatch& batch) {
+    // Même ordre que draw() : fond, segments, pic, repères, bordure
+    batch.addRect(0, 0, size.x, size.y, VU_BG_COLOR);
+    
+    int litLeds = levelToLeds(displayValue);
+    for (int led = 0; led < litLeds; led++) {
+        ofRectangle bounds = getLedBounds(led);
+        batch.addRect(bounds.x, bounds.y, bounds.width, bounds.height, getLedColor(led));
+    }
+    if (peakLeds > litLeds) {
+        ofRectangle bounds = getLedBounds(peakLeds - 1);
+        batch.addRect(bounds.x, bounds.y, bounds.width, bounds.height, getLedColor(peakLeds - 1));
+    }
+    
+    if (showScale) {
+        for (float db = MAX_DB; db > MIN_DB; db -= 12.0f) {
+            if (db == -36.0f) continue;
+            float y = size.y * (MAX_DB - db) / (MAX_DB - MIN_DB);
+            batch.addLine(size.x, y, size.x + SCALE_TICK_LENGTH, y, DEFAULT_BORDER_COLOR);
+        }
+    }
+    
+    batch.addRectOutline(0, 0, size.x, size.y, DEFAULT_BORDER_COLOR);
+    return true;
+}
+
+ofRectangle PdVuMeter::getDrawBounds() const {
+    ofRectangle bounds = PdGuiObject::getDrawBounds();
+    if (showScale) {
+        bounds.width += SCALE_TICK_LENGTH;
+    }
+    return bounds;
+}
+
+uint64_t PdVuMeter::computeRenderKey() const {
+    // Segments allumés et segment du pic
+    uint64_t key = mixRenderKey(getBaseRenderKey(), (uint64_t)levelToLeds(displayValue));
+    return mixRenderKey(key, (uint64_t)peakLeds);
+}
+
+int PdVuMeter::levelToLeds(float db) {
+    return (int)ofClamp(floor((db - MIN_DB) / DB_PER_LED + 0.5f), 0, NUM_LEDS);
+}
+
+ofColor PdVuMeter::getLedColor(int led) const {
+    float db = MIN_DB + (led + 1) * DB_PER_LED;
+    if (db > 0.0f) return VU_HIGH_COLOR;
+    if (db > -12.0f) return VU_MID_COLOR;
+    return VU_LOW_COLOR;
+}
+
+ofRectangle PdVuMeter::getLedBounds(int led) const {
+    // Segments empilés depuis le bas, séparés d'un point
+    float ledHeight = size.y / NUM_LEDS;
+    float y = size.y - (led + 1) * ledHeight;
+    return ofRectangle(2, y + 1, size.x - 4, max(1.0f, ledHeight - 1));
+}
@@ -0,0 +1,65 @@
+//
+//  VuMeter.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#pragma once
+
+#include "PdGuiObject.h"
+
+// Vu-mètre de Pd ([vu]) : niveau en dB reçu sur le symbole receive, affiché
+// en segments, avec maintien du pic. Objet d'affichage seulement.
+class PdVuMeter : public PdGuiObject {
+public:
+    // Niveaux affichés, en dB (0 = pleine échelle, comme [vu])
+    static constexpr float MIN_DB = -60.0f;
+    static constexpr float MAX_DB = 12.0f;
+    static constexpr int NUM_LEDS = 36;
+    static constexpr float DB_PER_LED = (MAX_DB - MIN_DB) / NUM_LEDS;
+    static constexpr uint64_t PEAK_HOLD_MICROS = 1500000;
+    
+    PdVuMeter(ofVec2f position, ofVec2f size, PdSymbol receiveSymbol, bool showScale = false);
+    
+    // Méthodes virtuelles de PdGuiObject
+    void update() override;
+    void draw() override;
+    bool drawBatched(PdPrimitiveBatch& batch) override;
+    ofRectangle getDrawBounds() const override;
+    
+    // Un segment par quantum, sans lissage : la balistique est celle de Pd
+    float getDisplayQuantum() const override { return DB_PER_LED; }
+    
+    // Affichage seulement : les clics passent à travers
+    bool onMousePressed(ofMouseEventArgs& args) override { return false; }
+    bool onMouseDragged(ofMouseEventArgs& args) override { return false; }
+    bool onMouseReleased(ofMouseEventArgs& args) override { return false; }
+    bool onMouseMoved(ofMouseEventArgs& args) override { return false; }
+    
+    void receiveFloat(float value) override;
+    void receiveBang() override {}
+    
+    int getNumLitLeds() const { return levelToLeds(displayValue); }
+    int getPeakLeds() const { return peakLeds; }
+
+protected:
+    uint64_t computeRenderKey() const override;
+
+private:
+    static const ofColor VU_BG_COLOR;
+    static const ofColor VU_LOW_COLOR;
+    static const ofColor VU_MID_COLOR;
+    static const ofColor VU_HIGH_COLOR;
+    static constexpr float SCALE_TICK_LENGTH = 4.0f;
+    
+    bool showScale;
+    int peakLeds;
+    uint64_t peakTimeMicros;
+    uint64_t peakWakeMicros; // Échéance en attente dans PdUpdateScheduler (0 = aucune)
+    
+    void schedulePeakRelease(uint64_t nowMicros);
+    static int levelToLeds(float db);
+    ofColor getLedColor(int led) const;
+    ofRectangle getLedBounds(int led) const;
+};
@@ -0,0 +1,184 @@
+//
+//  WidgetClasses.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 25/07/2025.
+//
+
+#pragma once
+
+#include "PdGuiObject.h"
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+// Champ d'un enregistrement Pd lu dans un PdWidgetDesc
+enum class PdField : uint8_t {
+    WIDTH,
+    HEIGHT,
+    SIZE,          // Largeur et hauteur (objet carré)
+    CHAR_WIDTH,    // Largeur en caractères (floatatom)
+    MIN_VALUE,
+    MAX_VALUE,
+    SLIDER_VALUE,  // Position enregistrée en 1/100 de pixel, si l'init (aux) est actif
+    SEND,
+    RECEIVE,
+    LABEL,
+    FONT_SIZE,
+    BACKGROUND,    // Couleur "#rrggbb"
+    FOREGROUND,
+    VU_SCALE
+};
+
+struct PdFieldSpec {
+    PdField field;
+    uint8_t index;         // Atome de l'enregistrement (le nom de classe est l'atome 4)
+    bool optional = false; // Absent : valeur par défaut de la classe
+    uint8_t aux = 0;       // Second atome (SLIDER_VALUE : drapeau init)
+};
+
+// Symboles exigés : sans eux, l'objet est ignoré
+enum class PdSymbolRule : uint8_t {
+    NONE,
+    SEND_OR_RECEIVE,
+    RECEIVE,
+    GENERATED  // Symbole construit depuis la position s'il n'y en a aucun
+};
+
+// Description d'une classe Pd : champs lus et valeurs par défaut. Ajouter
+// un type d'objet revient à ajouter une ligne à PD_WIDGET_CLASSES.
+struct PdWidgetClass {
+    std::string_view name;
+    GuiType type;
+    PdSymbolRule symbols;
+    const PdFieldSpec* fields;
+    uint8_t numFields;
+    
+    uint8_t minTokens;          // Un de plus que le dernier champ obligatoire
+    
+    bool isObject = true;       // "#X obj x y name ..." ; sinon "#X name x y ..."
+    bool patchFont = false;     // Police du patch, sauf champ FONT_SIZE
+    bool defaultRange = false;  // Plage ±1e6 si min == max == 0
+    float width = 0, height = 0;
+    uint32_t backgroundColor = 0, foregroundColor = 0;
+};
+
+namespace PdWidgetFields {
+    // #X obj x y hsl|vsl width height min max log init send receive label x_off y_off font font_size bg fg label_color value steady
+    inline constexpr PdFieldSpec SLIDER[] = {
+        { PdField::WIDTH, 5 }, { PdField::HEIGHT, 6 },
+        { PdField::MIN_VALUE, 7 }, { PdField::MAX_VALUE, 8 },
+        { PdField::SEND, 11 }, { PdField::RECEIVE, 12 },
+        { PdField::FONT_SIZE, 17, true },
+        { PdField::SLIDER_VALUE, 21, true, 10 }
+    };
+    // #X obj x y tgl size init send receive label x_off y_off font font_size bg fg label_color init_value nonzero
+    inline constexpr PdFieldSpec TOGGLE[] = {
+        { PdField::SIZE, 5 }, { PdField::SEND, 7 }, { PdField::RECEIVE, 8 }
+    };
+    // #X obj x y bng size hold interrupt init send receive label x_off y_off font font_size bg fg label_color
+    inline constexpr PdFieldSpec BANG[] = {
+        { PdField::SIZE, 5 }, { PdField::SEND, 9 }, { PdField::RECEIVE, 10 }
+    };
+    // #X obj x y cnv selectable_size width height send receive label x_off y_off font font_size bg label_color 0
+    inline constexpr PdFieldSpec CANVAS[] = {
+        { PdField::WIDTH, 6 }, { PdField::HEIGHT, 7 },
+        { PdField::LABEL, 10, true }, { PdField::FONT_SIZE, 14, true },
+        { PdField::BACKGROUND, 15, true }, { PdField::FOREGROUND, 16, true }
+    };
+    // #X obj x y vu width height receive label x_off y_off font font_size bg label_color scale 0
+    inline constexpr PdFieldSpec VU_METER[] = {
+        { PdField::WIDTH, 5 }, { PdField::HEIGHT, 6 }, { PdField::RECEIVE, 7 },
+        { PdField::VU_SCALE, 15, true }
+    };
+    // #X floatatom x y width min max label_pos label receive send font_size
+    inline constexpr PdFieldSpec NUMBER_BOX[] = {
+        { PdField::CHAR_WIDTH, 4 }, { PdField::MIN_VALUE, 5 }, { PdField::MAX_VALUE, 6 },
+        { PdField::RECEIVE, 9, true }, { PdField::SEND, 10, true }
+    };
+}
+
+template<size_t N>
+constexpr PdWidgetClass makeWidgetClass(std::string_view name, GuiType type, PdSymbolRule symbols,
+                                        const PdFieldSpec (&fields)[N]) {
+    uint8_t minTokens = 5;
+    for (size_t i = 0; i < N; i++) {
+        if (!fields[i].optional && fields[i].index + 1 > minTokens) minTokens = fields[i].index + 1;
+    }
+    
+    PdWidgetClass widgetClass{ name, type, symbols, fields, (uint8_t)N, minTokens };
+    return widgetClass;
+}
+
+constexpr PdWidgetClass makeNumberBoxClass() {
+    PdWidgetClass widgetClass = makeWidgetClass("floatatom", GuiType::NUMBER_BOX, PdSymbolRule::GENERATED,
+                                                PdWidgetFields::NUMBER_BOX);
+    widgetClass.isObject = false;
+    widgetClass.patchFont = true;
+    widgetClass.defaultRange = true;
+    widgetClass.height = 20;
+    return widgetClass;
+}
+
+constexpr PdWidgetClass makeCanvasClass() {
+    PdWidgetClass widgetClass = makeWidgetClass("cnv", GuiType::CANVAS, PdSymbolRule::NONE, PdWidgetFields::CANVAS);
+    widgetClass.backgroundColor = 0xe0e0e0;
+    widgetClass.foregroundColor = 0x000000;
+    return widgetClass;
+}
+
+constexpr PdWidgetClass makeSliderClass(std::string_view name, GuiType type) {
+    PdWidgetClass widgetClass = makeWidgetClass(name, type, PdSymbolRule::SEND_OR_RECEIVE, PdWidgetFields::SLIDER);
+    widgetClass.patchFont = true;
+    return widgetClass;
+}
+
+inline constexpr PdWidgetClass PD_WIDGET_CLASSES[] = {
+    makeSliderClass("hsl", GuiType::HORIZONTAL_SLIDER),
+    makeSliderClass("vsl", GuiType::VERTICAL_SLIDER),
+    makeWidgetClass("tgl", GuiType::TOGGLE, PdSymbolRule::SEND_OR_RECEIVE, PdWidgetFields::TOGGLE),
+    makeWidgetClass("bng", GuiType::BANG, PdSymbolRule::SEND_OR_RECEIVE, PdWidgetFields::BANG),
+    makeCanvasClass(),
+    makeWidgetClass("vu", GuiType::VU_METER, PdSymbolRule::RECEIVE, PdWidgetFields::VU_METER),
+    makeNumberBoxClass()
+};
+
+inline constexpr size_t PD_NUM_WIDGET_CLASSES = sizeof(PD_WIDGET_CLASSES) / sizeof(PD_WIDGET_CLASSES[0]);
+
+// Recherche d'une classe par hachage parfait : première lettre, dernière
+// lettre et longueur suffisent à séparer les noms de la table, vérifié à la
+// compilation. Un seul accès et une seule comparaison par enregistrement.
+class PdWidgetClasses {
+public:
+    static constexpr size_t NUM_SLOTS = 16;
+    static constexpr unsigned MULTIPLIER = 3;
+    
+    static constexpr size_t hash(std::string_view name) {
+        if (name.empty()) return 0;
+        return ((unsigned char)name.front() * MULTIPLIER + (unsigned char)name.back() + name.size()) & (NUM_SLOTS - 1);
+    }
+    
+    static constexpr std::array<int8_t, NUM_SLOTS> makeSlots() {
+        std::array<int8_t, NUM_SLOTS> slots{};
+        for (size_t i = 0; i < NUM_SLOTS; i++) slots[i] = -1;
+        for (size_t i = 0; i < PD_NUM_WIDGET_CLASSES; i++) slots[hash(PD_WIDGET_CLASSES[i].name)] = (int8_t)i;
+        return slots;
+    }
+    
+    static constexpr bool isPerfect() {
+        std::array<int8_t, NUM_SLOTS> slots = makeSlots();
+        for (size_t i = 0; i < PD_NUM_WIDGET_CLASSES; i++) {
+            if (slots[hash(PD_WIDGET_CLASSES[i].name)] != (int8_t)i) return false;
+        }
+        return true;
+    }
+    
+    static const PdWidgetClass* find(std::string_view name) {
+        static constexpr std::array<int8_t, NUM_SLOTS> SLOTS = makeSlots();
+        int8_t slot = SLOTS[hash(name)];
+        if (slot < 0 || PD_WIDGET_CLASSES[slot].name != name) return nullptr;
+        return &PD_WIDGET_CLASSES[slot];
+    }
+};
+
+static_assert(PdWidgetClasses::isPerfect(), "Widget class names collide: change MULTIPLIER or NUM_SLOTS");
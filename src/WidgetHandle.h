@@ -0,0 +1,46 @@
+//
+//  WidgetHandle.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 23/07/2025.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class PdGuiObject;
+
+// Référence stable vers un objet du PdWidgetStore. La génération change à
+// chaque réutilisation d'un emplacement : un handle périmé ne résout plus.
+struct PdWidgetHandle {
+    static constexpr uint16_t INVALID_POOL = 0xffff;
+    
+    uint16_t pool = INVALID_POOL;
+    uint32_t index = 0;
+    uint32_t generation = 0;
+    
+    bool isValid() const { return pool != INVALID_POOL; }
+    bool operator==(const PdWidgetHandle& other) const {
+        return pool == other.pool && index == other.index && generation == other.generation;
+    }
+    bool operator!=(const PdWidgetHandle& other) const { return !(*this == other); }
+};
+
+// Rend un objet à son pool, ou le détruit avec delete s'il a été créé
+// hors du store (objets personnalisés, make_unique)
+struct PdWidgetDeleter {
+    PdWidgetDeleter() = default;
+    template<typename T>
+    PdWidgetDeleter(const std::default_delete<T>&) {}
+    
+    void operator()(PdGuiObject* object) const;
+};
+
+template<typename T>
+using PdWidgetPtr = std::unique_ptr<T, PdWidgetDeleter>;
+
+typedef PdWidgetPtr<PdGuiObject> PdGuiObjectPtr;
+typedef std::vector<PdGuiObjectPtr> PdObjectList;
@@ -0,0 +1,142 @@
+//
+//  WidgetStore.cpp
+//  pd-gui
+//
+//  Created by Aurélien Conil on 23/07/2025.
+//
+
+#include "WidgetStore.h"
+
+void PdWidgetDeleter::operator()(PdGuiObject* object) const {
+    if (!object) return;
+    
+    if (object->isPooled()) {
+        PdWidgetStore::get().destroy(object);
+    } else {
+        delete object;
+    }
+}
+
+uint32_t PdWidgetPoolBase::allocateSlot() {
+    uint32_t index;
+    
+    if (!freeSlots.empty()) {
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        index = (uint32_t)flags.size();
+        flags.push_back(0);
+        values.push_back(0.0f);
+        bounds.emplace_back();
+        generations.push_back(0);
+        owners.push_back(NO_OWNER);
+    }
+    
+    flags[index] = ALIVE;
+    owners[index] = NO_OWNER;
+    numAlive++;
+    return index;
+}
+
+void PdWidgetPoolBase::releaseSlot(uint32_t index) {
+    flags[index] = 0;
+    // Les handles encore en circulation deviennent périmés
+    generations[index]++;
+    freeSlots.push_back(index);
+    numAlive--;
+}
+
+PdWidgetStore& PdWidgetStore::get() {
+    // Jamais détruit : des listes d'objets peuvent être libérées après la
+    // destruction des statiques (fermeture de l'application)
+    static PdWidgetStore* store = new PdWidgetStore();
+    return *store;
+}
+
+uint16_t PdWidgetStore::registerPool(std::unique_ptr<PdWidgetPoolBase> pool) {
+    pools.push_back(std::move(pool));
+    return (uint16_t)(pools.size() - 1);
+}
+
+PdGuiObject* PdWidgetStore::resolve(const PdWidgetHandle& handle) const {
+    if (!handle.isValid() || handle.pool >= pools.size()) return nullptr;
+    
+    PdWidgetPoolBase& pool = *pools[handle.pool];
+    if (handle.index >= pool.getCapacity()) return nullptr;
+    if (!(pool.flags[handle.index] & PdWidgetPoolBase::ALIVE)) return nullptr;
+    if (pool.generations[handle.index] != handle.generation) return nullptr;
+    
+    return pool.getObject(handle.index);
+}
+
+void PdWidgetStore::destroy(PdGuiObject* object) {
+    if (resolve(object->getStoreHandle()) != object) {
+        ofLogError("PdWidgetStore") << "Destruction d'un objet inconnu du store";
+        return;
+    }
+    
+    const PdWidgetHandle& handle = object->getStoreHandle();
+    pools[handle.pool]->destroy(handle.index);
+}
+
+void PdWidgetStore::update() {
+    for (auto& pool : pools) {
+        pool->updateAnimated();
+    }
+}
+
+void PdWidgetStore::setOwner(const PdGuiObject& object, uint16_t owner) {
+    const PdWidgetHandle& handle = object.getStoreHandle();
+    if (resolve(handle) != &object) return;
+    
+    pools[handle.pool]->owners[handle.index] = owner;
+}
+
+void PdWidgetStore::collectDirtyRegions(uint16_t owner, std::vector<ofRectangle>& regions,
+                                        std::vector<ofRectangle>* staticRegions) {
+    const uint8_t wanted = PdWidgetPoolBase::ALIVE | PdWidgetPoolBase::DIRTY;
+    
+    for (auto& pool : pools) {
+        std::vector<uint8_t>& flags = pool->flags;
+        const std::vector<uint16_t>& owners = pool->owners;
+        
+        for (uint32_t i = 0; i < flags.size(); i++) {
+            if ((flags[i] & wanted) != wanted || owners[i] != owner) continue;
+            
+            PdGuiObject* object = pool->getObject(i);
+            if (object->needsUpdate()) {
+                bool isStatic = staticRegions && object->isStatic();
+                (isStatic ? *staticRegions : regions).push_back(object->getUpdateRegion());
+                object->clearUpdateFlag();
+            }
+            flags[i] &= ~PdWidgetPoolBase::DIRTY;
+        }
+    }
+}
+
+void PdWidgetStore::publish(const PdGuiObject& object) {
+    const PdWidgetHandle& handle = object.getStoreHandle();
+    if (!handle.isValid() || handle.pool >= pools.size()) return;
+    
+    PdWidgetPoolBase& pool = *pools[handle.pool];
+    uint32_t i = handle.index;
+    if (i >= pool.getCapacity() || pool.generations[i] != handle.generation) return;
+    
+    uint8_t flags = PdWidgetPoolBase::ALIVE;
+    if (object.isVisible()) flags |= PdWidgetPoolBase::VISIBLE;
+    if (object.isEnabled()) flags |= PdWidgetPoolBase::ENABLED;
+    if (object.needsUpdate()) flags |= PdWidgetPoolBase::DIRTY;
+    if (object.isAnimating()) flags |= PdWidgetPoolBase::ANIMATING;
+    
+    pool.flags[i] = flags;
+    pool.values[i] = object.getValue();
+    pool.bounds[i] = object.getBounds();
+}
+
+size_t PdWidgetStore::getNumWidgets() const {
+    size_t total = 0;
+    for (auto& pool : pools) {
+        total += pool->getNumAlive();
+    }
+    return total;
+}
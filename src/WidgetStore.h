@@ -0,0 +1,160 @@
+//
+//  WidgetStore.h
+//  pd-gui
+//
+//  Created by Aurélien Conil on 23/07/2025.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "PdGuiObject.h"
+#include "WidgetHandle.h"
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Emplacements d'un type d'objet et leur état chaud en structure de tableaux
+class PdWidgetPoolBase {
+public:
+    static constexpr uint16_t NO_OWNER = 0;
+    
+    enum Flags : uint8_t {
+        ALIVE     = 1 << 0,
+        VISIBLE   = 1 << 1,
+        ENABLED   = 1 << 2,
+        DIRTY     = 1 << 3,
+        ANIMATING = 1 << 4
+    };
+    
+    virtual ~PdWidgetPoolBase() = default;
+    
+    virtual PdGuiObject* getObject(uint32_t index) = 0;
+    virtual void destroy(uint32_t index) = 0;
+    virtual void updateAnimated() = 0;
+    
+    size_t getNumAlive() const { return numAlive; }
+    size_t getCapacity() const { return flags.size(); }
+    
+    // État chaud, indexé par emplacement
+    std::vector<uint8_t> flags;
+    std::vector<float> values;
+    std::vector<ofRectangle> bounds;
+    std::vector<uint32_t> generations;
+    std::vector<uint16_t> owners; // Vue propriétaire (PdPatchView), NO_OWNER sinon
+    
+protected:
+    uint32_t allocateSlot();
+    void releaseSlot(uint32_t index);
+    
+    std::vector<uint32_t> freeSlots;
+    size_t numAlive = 0;
+};
+
+// Objets d'un même type stockés par blocs contigus : les adresses restent
+// stables quand le pool grandit
+template<typename T>
+class PdWidgetPool : public PdWidgetPoolBase {
+public:
+    static constexpr size_t CHUNK_SIZE = 256;
+    
+    ~PdWidgetPool() override {
+        for (uint32_t i = 0; i < flags.size(); i++) {
+            if (flags[i] & ALIVE) get(i)->~T();
+        }
+    }
+    
+    template<typename... Args>
+    T* create(uint32_t& index, Args&&... args) {
+        index = allocateSlot();
+        if (index / CHUNK_SIZE >= chunks.size()) {
+            chunks.push_back(std::make_unique<Chunk>());
+        }
+        return new (&chunks[index / CHUNK_SIZE]->slots[index % CHUNK_SIZE]) T(std::forward<Args>(args)...);
+    }
+    
+    T* get(uint32_t index) {
+        return reinterpret_cast<T*>(&chunks[index / CHUNK_SIZE]->slots[index % CHUNK_SIZE]);
+    }
+    
+    PdGuiObject* getObject(uint32_t index) override { return get(index); }
+    
+    void destroy(uint32_t index) override {
+        get(index)->~T();
+        releaseSlot(index);
+    }
+    
+    void updateAnimated() override {
+        // Boucle serrée sur les drapeaux ; appel direct, sans dispatch virtuel
+        const uint8_t wanted = ALIVE | ANIMATING;
+        for (uint32_t i = 0; i < flags.size(); i++) {
+            if ((flags[i] & wanted) == wanted) {
+                get(i)->T::update();
+            }
+        }
+    }
+    
+private:
+    struct Chunk {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type slots[CHUNK_SIZE];
+    };
+    
+    std::vector<std::unique_ptr<Chunk>> chunks;
+};
+
+// Propriétaire de tous les objets GUI créés depuis un patch, un pool par type
+class PdWidgetStore {
+public:
+    static PdWidgetStore& get();
+    
+    template<typename T, typename... Args>
+    PdWidgetPtr<T> create(Args&&... args) {
+        uint16_t poolId = getPoolId<T>();
+        PdWidgetPool<T>& pool = static_cast<PdWidgetPool<T>&>(*pools[poolId]);
+        
+        uint32_t index;
+        T* object = pool.create(index, std::forward<Args>(args)...);
+        
+        PdWidgetHandle handle;
+        handle.pool = poolId;
+        handle.index = index;
+        handle.generation = pool.generations[index];
+        object->attachToStore(handle);
+        
+        return PdWidgetPtr<T>(object);
+    }
+    
+    // nullptr si le handle est périmé
+    PdGuiObject* resolve(const PdWidgetHandle& handle) const;
+    void destroy(PdGuiObject* object);
+    
+    // Boucles par type : update() des seuls objets animés
+    void update();
+    
+    // Les objets d'une vue sont marqués à son identifiant : chaque vue ne
+    // collecte (et n'efface) que ses propres régions sales (drapeaux DIRTY).
+    // Avec staticRegions, celles des objets statiques y sont rangées à part.
+    void setOwner(const PdGuiObject& object, uint16_t owner);
+    void collectDirtyRegions(uint16_t owner, std::vector<ofRectangle>& regions,
+                             std::vector<ofRectangle>* staticRegions = nullptr);
+    
+    // Recopie de l'état chaud d'un objet (appelé par PdGuiObject)
+    void publish(const PdGuiObject& object);
+    
+    size_t getNumWidgets() const;
+    size_t getNumPools() const { return pools.size(); }
+    
+private:
+    PdWidgetStore() = default;
+    
+    template<typename T>
+    uint16_t getPoolId() {
+        static_assert(std::is_base_of<PdGuiObject, T>::value, "PdWidgetStore only holds PdGuiObject");
+        static const uint16_t id = registerPool(std::make_unique<PdWidgetPool<T>>());
+        return id;
+    }
+    
+    uint16_t registerPool(std::unique_ptr<PdWidgetPoolBase> pool);
+    
+    std::vector<std::unique_ptr<PdWidgetPoolBase>> pools;
+};
@@ -1,17 +1,122 @@
 #include "ofMain.h"
 #include "ofApp.h"
+#include "ParserBenchmark.h"
+#include "BenchmarkSuite.h"
+#include "PatchCache.h"
+#include "RenderTarget.h"
+#include "Snapshot.h"
+#include "RemoteServer.h"
+#include "JobSystem.h"
+#include "SelfTest.h"
 
 //========================================================================
-int main( ){
+int main(int argc, char* argv[]){
+
+	// Modes ligne de commande (sans fenêtre)
+	if(argc > 1 && string(argv[1]) == "--bench-parser"){
+		size_t numObjects = argc > 2 ? (size_t)ofToInt(argv[2]) : 50000;
+		int iterations = argc > 3 ? ofToInt(argv[3]) : 10;
+		return PdParserBenchmark::run(numObjects, iterations);
+	}
+	if(argc > 1 && string(argv[1]) == "--bench"){
+		size_t numObjects = argc > 2 ? (size_t)ofToInt(argv[2]) : 10000;
+		int iterations = argc > 3 ? ofToInt(argv[3]) : 10;
+		return PdBenchmarkSuite::run(numObjects, iterations, argc > 4 ? argv[4] : "");
+	}
+	if(argc > 1 && string(argv[1]) == "--self-test"){
+		return PdSelfTest::run();
+	}
+	if(argc > 2 && string(argv[1]) == "--precompile"){
+		return PdPatchCache::precompile(argv[2], argc > 3 ? argv[3] : "");
+	}
+
+	// Patchs à ouvrir : pd-gui [--tile] [--vram-budget Mo] mixer.pd fx.pd cues.pd
+	// Sans affichage : pd-gui --snapshot thumbs/%05d.png [--snapshot-interval ms]
+	//                         [--snapshot-count n] [--snapshot-size 800x600] patch.pd
+	// Tablettes sur le réseau : pd-gui --remote [port] patch.pd (9001 par défaut)
+	// Threads de calcul en plus du principal : --jobs n (0 = aucun)
+	// Envoi à Pd dès l'événement d'entrée, sans attendre la frame : --low-latency
+	bool benchRender = argc > 1 && string(argv[1]) == "--bench-render";
+	bool tiled = false;
+	vector<string> patches;
+	PdSnapshotSettings snapshot;
+	int remotePort = 0;
+	bool lowLatency = false;
+	for(int i = 1; i < argc && !benchRender; i++){
+		string arg = argv[i];
+		if(arg == "--tile") tiled = true;
+		else if(arg == "--vram-budget" && i + 1 < argc) PdTiledTarget::setBudget((size_t)ofToInt(argv[++i]) * 1024 * 1024);
+		else if(arg == "--snapshot" && i + 1 < argc) snapshot.path = argv[++i];
+		else if(arg == "--snapshot-interval" && i + 1 < argc) snapshot.intervalMicros = (uint64_t)max(1, ofToInt(argv[++i])) * 1000;
+		else if(arg == "--snapshot-count" && i + 1 < argc) snapshot.maxFrames = max(0, ofToInt(argv[++i]));
+		else if(arg == "--snapshot-size" && i + 1 < argc){
+			vector<string> size = ofSplitString(argv[++i], "x");
+			if(size.size() == 2){
+				snapshot.width = max(1, ofToInt(size[0]));
+				snapshot.height = max(1, ofToInt(size[1]));
+			}
+		}
+		else if(arg == "--jobs" && i + 1 < argc) PdJobSystem::get().setNumWorkers((size_t)max(0, ofToInt(argv[++i])));
+		else if(arg == "--low-latency") lowLatency = true;
+		else if(arg == "--remote"){
+			remotePort = PdRemoteServer::DEFAULT_PORT;
+			if(i + 1 < argc && isdigit((unsigned char)argv[i + 1][0])) remotePort = ofToInt(argv[++i]);
+		}
+		else patches.push_back(arg);
+	}
+	bool headless = !snapshot.path.empty();
+	if(headless && !PdSnapshotSettings::isValidPath(snapshot.path)){
+		fprintf(stderr, "--snapshot: expected a path with at most one %%d or %%0Nd frame number\n");
+		return 1;
+	}
 
 	//Use ofGLFWWindowSettings for more options like multi-monitor fullscreen
+#if !defined(TARGET_OF_IOS) && !defined(TARGET_ANDROID) && !defined(TARGET_EMSCRIPTEN)
+	ofGLFWWindowSettings settings;
+	// Sans affichage : fenêtre invisible, seulement pour son contexte GL
+	settings.visible = !headless;
+#else
 	ofGLWindowSettings settings;
-	settings.setSize(1024, 768);
+#endif
+	settings.setSize(headless ? snapshot.width : 1024, headless ? snapshot.height : 768);
 	settings.windowMode = OF_WINDOW; //can also be OF_FULLSCREEN
 
 	auto window = ofCreateWindow(settings);
+	auto app = make_shared<ofApp>();
+
+	// Mesure du rendu : demande une fenêtre et un contexte GL
+	if(benchRender){
+		size_t numObjects = argc > 2 ? (size_t)ofToInt(argv[2]) : 10000;
+		int frames = argc > 3 ? ofToInt(argv[3]) : 200;
+		app->setRenderBenchmark(numObjects, frames, argc > 4 ? argv[4] : "");
+	}else{
+		// Images sans affichage : tous les patchs côte à côte dans une seule image
+		if(headless){
+			tiled = true;
+			app->setSnapshotMode(snapshot);
+		}
+		if(!patches.empty()) app->setPatches(patches, tiled);
+		app->setRemotePort(remotePort);
+		app->setLowLatency(lowLatency);
+	}
+
+	ofRunApp(window, app);
+
+#if !defined(TARGET_OF_IOS) && !defined(TARGET_ANDROID) && !defined(TARGET_EMSCRIPTEN)
+	// Une fenêtre par patch supplémentaire (un écran chacun), contexte GL partagé
+	// avec la fenêtre principale : atlas de glyphes et tampons du batch communs
+	if(!tiled){
+		for(size_t i = 1; i < app->getNumViews(); i++){
+			ofGLFWWindowSettings windowSettings;
+			windowSettings.setSize(1024, 768);
+			windowSettings.setPosition(glm::vec2(40 + 60 * i, 40 + 60 * i));
+			windowSettings.shareContextWith = window;
+			auto patchWindow = ofCreateWindow(windowSettings);
+			ofRunApp(patchWindow, app->createPatchWindow(i));
+		}
+	}
+#endif
 
-	ofRunApp(window, make_shared<ofApp>());
 	ofRunMainLoop();
 
 }
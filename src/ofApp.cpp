@@ -1,131 +1,721 @@
 #include "ofApp.h"
+#include "NumberFormat.h"
+#include "BenchmarkSuite.h"
+#include "ParserBenchmark.h"
+#include "ValueSmoother.h"
 
 void ofApp::setup() {
-    ofSetFrameRate(60);
+    // Premier appel : le thread principal devient le thread mesuré
+    PdProfiler::get();
+    frameClock.setup(ACTIVE_FRAME_RATE, IDLE_FRAME_RATE);
     ofBackground(50);
     ofSetWindowTitle("Pure Data Toggle Test");
     
-    // Créer une liste de toggles
-    //createToggles();
+    // Les valeurs continues (sliders, number box) sont fusionnées par frame
+    sendQueue.setFlushInterval(0);
+    
+    // Sans patch en ligne de commande : patch.pd seul
+    if (views.empty()) {
+        setPatches({ PATCH_PATH }, true);
+    }
+    focusedView = tiledViews.front();
+    
+    // Zones et tuiles des vues de cette fenêtre (dans son contexte GL)
+    layoutViews();
+    
+    // Mode sans affichage : image hors écran à la taille de la fenêtre invisible
+    snapshotRecorder.setup(snapshotSettings);
+    
+    if (remotePort > 0) {
+        remoteServer.start(remotePort);
+    }
     
-    PdPatchParser parser;
-    guiObjects = parser.parseFile("patch.pd");
+    titleLabel.set(focusedView->getTitle());
+    controlLabels.resize(11);
     
+    if (renderBenchmark.frames > 0) {
+        // Patch synthétique de la mesure de rendu (--bench-render)
+        string patch = PdParserBenchmark::generatePatch(renderBenchmark.numObjects);
+        PdPatchParser parser;
+        focusedView->setObjects(parser.parseBuffer(patch.data(), patch.size()));
+        return;
+    }
+    
+    // Créer une liste de toggles
+    //focusedView->setObjects(createToggles());
     
-    // Configurer les callbacks pour tous les objets
-    setupCallbacks();
+    // Presets à côté du premier patch (patch.pd -> patch.pdpresets)
+    presetBank.load(PdPresetBank::getPresetPath(patchPaths.empty() ? PATCH_PATH : patchPaths.front()));
     
-    // Créer le FBO pour le rendu optimisé
-    setupFbo();
+    // Cache binaire .pdc, régénéré seulement si le patch a changé.
+    // Les objets apparaissent au fil des frames, patch par patch.
+    for (size_t i = 0; i < views.size(); i++) {
+        views[i]->load(patchPaths[i]);
+    }
+}
+
+void ofApp::setPatches(const vector<string>& paths, bool tiled) {
+    patchPaths = paths;
+    for (size_t i = 0; i < paths.size(); i++) {
+        PdPatchView& view = addView();
+        
+        // La première vue reste dans la fenêtre principale
+        if (tiled || i == 0) {
+            tiledViews.push_back(&view);
+        }
+    }
+}
+
+std::shared_ptr<PdPatchWindow> ofApp::createPatchWindow(size_t index) {
+    auto window = std::make_shared<PdPatchWindow>(*views[index], primitiveBatch);
+    window->onKeyPressed = [this](PdPatchView& view, int key) {
+        handleKey(view, key);
+    };
+    window->onInputBegin = [this]() {
+        beginInput();
+    };
+    window->onInputEnd = [this]() {
+        endInput();
+    };
+    return window;
+}
+
+PdPatchView& ofApp::addView() {
+    views.push_back(std::make_unique<PdPatchView>(resources));
+    PdPatchView& view = *views.back();
+    view.setFboRenderer(useFboRenderer);
+    view.setBatchRenderer(useBatchRenderer);
     
-    ofLogNotice("ofApp") << "Created " << guiObjects.size() << " toggles";
+    view.onActivity = [this](PdPatchView&) {
+        markActive();
+    };
+    view.onRedrawn = [this](PdPatchView& redrawn) {
+        // Les compteurs affichés ne concernent que la vue courante
+        if (&redrawn == focusedView) {
+            activeStateDirty = true;
+        }
+    };
+    return view;
+}
+
+void ofApp::layoutViews() {
+    // Colonnes de même largeur dans la fenêtre principale
+    float width = (float)ofGetWidth() / tiledViews.size();
+    for (size_t i = 0; i < tiledViews.size(); i++) {
+        float x = floor(i * width);
+        tiledViews[i]->setViewport(ofRectangle(x, 0, floor((i + 1) * width) - x, ofGetHeight()));
+    }
+}
+
+PdPatchView* ofApp::findView(float x, float y) {
+    for (PdPatchView* view : tiledViews) {
+        if (view->contains(x, y)) return view;
+    }
+    return nullptr;
+}
+
+PdPatchView* ofApp::findPointerView(int pointerId) {
+    for (PointerView& pointer : pointerViews) {
+        if (pointer.pointerId == pointerId) return pointer.view;
+    }
+    return nullptr;
+}
+
+void ofApp::capturePointer(int pointerId, PdPatchView* view) {
+    releasePointer(pointerId);
+    pointerViews.push_back({ pointerId, view });
+}
+
+void ofApp::releasePointer(int pointerId) {
+    pointerViews.erase(remove_if(pointerViews.begin(), pointerViews.end(),
+                                 [pointerId](const PointerView& p) { return p.pointerId == pointerId; }),
+                       pointerViews.end());
+}
+
+PdObjectList& ofApp::getVisibleObjects() {
+    return focusedView->getVisibleObjects();
 }
 
 void ofApp::update() {
-    // Mettre à jour tous les objets GUI
-    for (auto& obj : guiObjects) {
-        obj->update();
+    // La frame précédente vient d'être échangée : fin de la latence PRESENT
+    PdLatencyTracker::get().framePresented(ofGetElapsedTimeMicros());
+    
+    // Rendu à la demande : dormir jusqu'au prochain événement, message ou échéance
+    uint64_t nextDeadline = min(PdUpdateScheduler::get().getNextDeadline(), snapshotRecorder.getNextDeadline());
+    frameClock.waitForWork(nextDeadline, [this]() {
+        if (messageRouter.hasPendingMessages()) return true;
+        if (!PdValueSmoother::get().empty()) return true;
+        if (remoteServer.hasPendingEvents()) return true;
+        if (morph.active) return true;
+        for (auto& view : views) {
+            if (view->hasPendingWork()) return true;
+        }
+        return false;
+    });
+    
+    PdProfiler& profiler = PdProfiler::get();
+    profiler.beginFrame();
+    PdProfileScope scope(PdProfileSection::UPDATE);
+    
+    // Rechargements à chaud, chargements progressifs, sous-patchs cliqués
+    for (auto& view : views) {
+        view->update();
     }
+    titleLabel.set(focusedView->getTitle());
+    
+    // Pointeurs des tablettes, comme des événements locaux
+    applyRemoteEvents();
+    
+    // Distribuer en un seul lot les messages reçus de Pd depuis la dernière frame
+    size_t numReceived = messageRouter.processMessages();
+    if (numReceived > 0) {
+        profiler.addCount(PdProfileCounter::MESSAGES_IN, numReceived);
+        markActive();
+    }
+    
+    // Valeurs continues : un pas de lissage par frame pour tous les objets,
+    // redessin des seuls objets dont le rendu change
+    PdValueSmoother& smoother = PdValueSmoother::get();
+    smoother.run(ofGetElapsedTimeMicros());
+    if (!smoother.empty()) {
+        markActive();
+    }
+    
+    // Réveiller les seuls objets dont l'échéance est passée (fin de flash...)
+    PdUpdateScheduler& scheduler = PdUpdateScheduler::get();
+    scheduler.run(ofGetElapsedTimeMicros());
+    if (!scheduler.empty()) {
+        markActive();
+    }
+    
+    // Animations continues : boucles par type du store sur les objets animés
+    // de toutes les vues, update() virtuel pour les objets créés hors du store
+    PdWidgetStore::get().update();
+    for (auto& view : views) {
+        view->updateObjects();
+    }
+    
+    // Fondu entre deux presets : une passe par frame sur tous les objets
+    updateMorph();
+    
+    // Publier en un seul lot les messages émis pendant la frame
+    sendQueue.flush(ofGetElapsedTimeMicros());
+    
+    sendPendingToPd();
+    
+    // Valeurs de la frame vers les tablettes (encodage sur le thread réseau)
+    publishRemoteState();
     
     // Simulation : changer automatiquement quelques toggles
     //simulateAutomaticChanges();
 }
 
 void ofApp::draw() {
-    // Dessiner le titre
-    ofSetColor(255);
-    ofDrawBitmapString("Pure Data Toggle Test - Click on toggles", 20, 30);
-    ofDrawBitmapString("Total toggles: " + ofToString(guiObjects.size()), 20, 50);
-    ofDrawBitmapString("Active toggles: " + ofToString(countActiveToggles()), 20, 70);
+    if (renderBenchmark.frames > 0) {
+        runRenderBenchmark();
+        ofExit(0);
+        return;
+    }
     
-    // Dessiner tous les objets GUI
-    drawGuiObjects();
+    if (snapshotRecorder.isEnabled()) {
+        drawSnapshot();
+        frameClock.endFrame();
+        PdProfiler::get().endFrame();
+        return;
+    }
     
-    // Afficher les informations de debug
-    drawDebugInfo();
+    // Dessiner les vues de la fenêtre principale
+    for (PdPatchView* view : tiledViews) {
+        view->draw();
+    }
+    
+    {
+        PdProfileScope scope(PdProfileSection::TEXT);
+        
+        // Compteurs et liste des symboles actifs recalculés seulement quand
+        // une région a été redessinée (une valeur a pu changer)
+        if (activeStateDirty || !useFboRenderer) {
+            updateActiveState();
+            activeStateDirty = false;
+        }
+        
+        // Dessiner le titre (textes en cache, un seul appel de dessin)
+        float titleX = focusedView->getViewport().x + 20;
+        primitiveBatch.begin();
+        primitiveBatch.addText(titleLabel, titleX, 30, ofColor(255));
+        primitiveBatch.addText(totalLabel, titleX, 50, ofColor(255));
+        primitiveBatch.addText(activeLabel, titleX, 70, ofColor(255));
+        primitiveBatch.draw();
+        
+        // Afficher les informations de debug
+        drawDebugInfo();
+        
+        if (showProfiler) {
+            primitiveBatch.begin();
+            PdProfiler::get().drawOverlay(primitiveBatch, ofGetWidth() - 500, 10, 480, 160);
+            primitiveBatch.draw();
+        }
+    }
+    
+    PdLatencyTracker::get().frameDrawn();
+    frameClock.endFrame();
+    PdProfiler::get().endFrame();
 }
 
-void ofApp::mousePressed(int x, int y, int button) {
-    ofMouseEventArgs args;
-    args.x = x;
-    args.y = y;
-    args.button = button;
-    
-    // Propager l'événement à tous les objets
-    for (auto& obj : guiObjects) {
-        if (obj->onMousePressed(args)) {
-            ofLogNotice("ofApp") << "Toggle clicked: " << obj->getSendSymbol();
-            break; // Arrêter après le premier objet qui gère l'événement
+void ofApp::exit() {
+    // Dernière image et écritures en attente
+    snapshotRecorder.finish();
+    remoteServer.stop();
+    PdJobSystem::get().shutdown();
+}
+
+void ofApp::setSnapshotMode(const PdSnapshotSettings& settings) {
+    snapshotSettings = settings;
+}
+
+void ofApp::drawSnapshot() {
+    // Première image une fois les patchs chargés : pas de vignette à moitié vide
+    for (auto& view : views) {
+        if (view->isLoading()) return;
+    }
+    
+    uint64_t now = ofGetElapsedTimeMicros();
+    if (snapshotRecorder.isDue(now)) {
+        snapshotRecorder.capture([this]() {
+            for (PdPatchView* view : tiledViews) {
+                view->draw();
+            }
+        }, now);
+    }
+    
+    if (snapshotRecorder.isFinished()) {
+        ofExit(0);
+    }
+}
+
+void ofApp::setRenderBenchmark(size_t numObjects, int frames, const string& jsonPath) {
+    renderBenchmark.numObjects = numObjects;
+    renderBenchmark.frames = frames;
+    renderBenchmark.jsonPath = jsonPath;
+}
+
+void ofApp::runRenderBenchmark() {
+    // Chaque mode redessine le même patch, 1 % des objets étant salis à chaque frame.
+    // glFinish() attend la fin du travail GPU pour chronométrer la frame entière.
+    PdPatchView& view = *focusedView;
+    PdObjectList& objects = view.getVisibleObjects();
+    size_t numDirty = std::max<size_t>(1, objects.size() / 100);
+    size_t dirtyOffset = 0;
+    
+    auto dirtySome = [&]() {
+        for (size_t i = 0; i < numDirty && !objects.empty(); i++) {
+            objects[(dirtyOffset + i * 97) % objects.size()]->markForUpdate();
         }
+        dirtyOffset += numDirty;
+    };
+    
+    struct Mode {
+        const char* name;
+        bool batched;
+        std::function<void()> draw;
+    };
+    
+    std::vector<Mode> modes = {
+        { "direct_batched",   true,  [&view]() { view.drawDirect(); } },
+        { "direct_immediate", false, [&view]() { view.drawDirect(); } },
+        { "fbo_full",         true,  [&view]() { view.invalidate(); view.drawToFboMerged(); } },
+        { "fbo_per_object",   true,  [&view]() { view.drawToFbo(); } },
+        { "fbo_scissor",      true,  [&view]() { view.drawToFboWithScissor(); } },
+        { "fbo_merged",       true,  [&view]() { view.drawToFboMerged(); } }
+    };
+    
+    std::vector<PdBenchmarkResult> results;
+    
+    for (auto& mode : modes) {
+        view.setBatchRenderer(mode.batched);
+        mode.draw();
+        
+        results.push_back(PdBenchmarkSuite::measure(mode.name, renderBenchmark.frames, numDirty, [&]() {
+            dirtySome();
+            mode.draw();
+            glFinish();
+        }));
+    }
+    
+    view.setBatchRenderer(useBatchRenderer);
+    
+    printf("render benchmark: %zu GUI objects, %zu dirty per frame, %d frames\n",
+           objects.size(), numDirty, renderBenchmark.frames);
+    for (auto& result : results) {
+        PdBenchmarkSuite::print(result);
+    }
+    
+    if (!renderBenchmark.jsonPath.empty()) {
+        PdBenchmarkSuite::writeJson(renderBenchmark.jsonPath, "render", renderBenchmark.numObjects, results);
     }
 }
 
-void ofApp::mouseDragged(int x, int y, int button) {
-    ofMouseEventArgs args;
-    args.x = x;
-    args.y = y;
-    args.button = button;
+void ofApp::markActive() {
+    frameClock.requestFrame();
+}
+
+void ofApp::beginInput() {
+    sendQueue.setInputTime(PdLatencyTracker::get().inputReceived());
+}
+
+void ofApp::endInput() {
+    sendQueue.setInputTime(0);
+    if (!lowLatency) return;
     
-    for (auto& obj : guiObjects) {
-        obj->onMouseDragged(args);
+    // Chemin rapide : publier tout de suite les messages de l'événement,
+    // fusionnés ou non, puis présenter la frame dès qu'elle est dessinée
+    sendQueue.flush(ofGetElapsedTimeMicros(), true);
+    sendPendingToPd();
+    frameClock.requestEarlyFrame();
+}
+
+void ofApp::sendPendingToPd() {
+    // Sans thread Pd, vider la file ici ; avec ofxPd ce serait :
+    // sendQueue.consume([&](const string& s, float v) { pd.sendFloat(s, v); });
+    size_t numSent = sendQueue.consume([](const string& symbol, float value) {
+        ofLogVerbose("PD Send") << symbol << " = " << value;
+    });
+    PdProfiler::get().addCount(PdProfileCounter::MESSAGES_OUT, numSent);
+}
+
+void ofApp::mousePressed(int x, int y, int button) {
+    PdProfileScope scope(PdProfileSection::EVENTS);
+    InputScope input(*this);
+    markActive();
+    PdPatchView* view = findView(x, y);
+    if (!view) return;
+    
+    // La vue cliquée devient la vue courante (clavier, compteurs)
+    if (view != focusedView) {
+        focusedView = view;
+        activeStateDirty = true;
+    }
+    capturePointer(PdEventRouter::MOUSE_POINTER_ID, view);
+    
+    if (view->pointerPressed(PdEventRouter::MOUSE_POINTER_ID, x, y, button)) {
+        PdGuiObject* obj = view->getActiveObject(PdEventRouter::MOUSE_POINTER_ID);
+        ofLogNotice("ofApp") << "Object clicked: " << obj->getSendSymbol();
+    }
+}
+
+void ofApp::mouseDragged(int x, int y, int button) {
+    PdProfileScope scope(PdProfileSection::EVENTS);
+    InputScope input(*this);
+    markActive();
+    if (PdPatchView* view = findPointerView(PdEventRouter::MOUSE_POINTER_ID)) {
+        view->pointerDragged(PdEventRouter::MOUSE_POINTER_ID, x, y, button);
     }
 }
 
 void ofApp::mouseReleased(int x, int y, int button) {
-    ofMouseEventArgs args;
-    args.x = x;
-    args.y = y;
-    args.button = button;
-    
-    for (auto& obj : guiObjects) {
-        obj->onMouseReleased(args);
+    PdProfileScope scope(PdProfileSection::EVENTS);
+    InputScope input(*this);
+    markActive();
+    if (PdPatchView* view = findPointerView(PdEventRouter::MOUSE_POINTER_ID)) {
+        view->pointerReleased(PdEventRouter::MOUSE_POINTER_ID, x, y, button);
     }
+    releasePointer(PdEventRouter::MOUSE_POINTER_ID);
 }
 
 void ofApp::mouseMoved(int x, int y) {
-    ofMouseEventArgs args;
-    args.x = x;
-    args.y = y;
+    PdProfileScope scope(PdProfileSection::EVENTS);
+    markActive();
+    // Chaque vue perd son survol quand la souris la quitte
+    for (PdPatchView* view : tiledViews) {
+        view->pointerMoved(x, y);
+    }
+}
+
+void ofApp::mouseScrolled(int x, int y, float scrollX, float scrollY) {
+    PdProfileScope scope(PdProfileSection::EVENTS);
+    if (PdPatchView* view = findView(x, y)) {
+        view->scroll(-scrollX * PdPatchView::SCROLL_STEP, -scrollY * PdPatchView::SCROLL_STEP);
+    }
+}
+
+void ofApp::touchDown(ofTouchEventArgs& touch) {
+    PdProfileScope scope(PdProfileSection::EVENTS);
+    InputScope input(*this);
+    markActive();
+    if (PdPatchView* view = findView(touch.x, touch.y)) {
+        capturePointer(touch.id, view);
+        view->pointerPressed(touch.id, touch.x, touch.y);
+    }
+}
+
+void ofApp::touchMoved(ofTouchEventArgs& touch) {
+    PdProfileScope scope(PdProfileSection::EVENTS);
+    InputScope input(*this);
+    markActive();
+    if (PdPatchView* view = findPointerView(touch.id)) {
+        view->pointerDragged(touch.id, touch.x, touch.y);
+    }
+}
+
+void ofApp::touchUp(ofTouchEventArgs& touch) {
+    PdProfileScope scope(PdProfileSection::EVENTS);
+    InputScope input(*this);
+    markActive();
+    if (PdPatchView* view = findPointerView(touch.id)) {
+        view->pointerReleased(touch.id, touch.x, touch.y);
+    }
+    releasePointer(touch.id);
+}
+
+void ofApp::touchCancelled(ofTouchEventArgs& touch) {
+    PdProfileScope scope(PdProfileSection::EVENTS);
+    InputScope input(*this);
+    markActive();
+    if (PdPatchView* view = findPointerView(touch.id)) {
+        view->pointerCancelled(touch.id);
+    }
+    releasePointer(touch.id);
+}
+
+void ofApp::applyRemoteEvents() {
+    size_t numEvents = remoteServer.consumeEvents([this](const PdRemoteEvent& event) {
+        if (event.view >= views.size()) return;
+        InputScope input(*this);
+        PdPatchView& view = *views[event.view];
+        int pointerId = REMOTE_POINTER_BASE + event.pointerId;
+        
+        // Les tablettes ne montrent que le patch principal
+        if (&view.getVisibleObjects() != &view.getObjects()) {
+            view.pointerCancelled(pointerId);
+            return;
+        }
+        
+        ofVec2f point = view.toWindow(event.x, event.y);
+        switch (event.type) {
+            case PdRemoteEvent::POINTER_DOWN:
+                view.pointerPressed(pointerId, point.x, point.y);
+                break;
+            case PdRemoteEvent::POINTER_MOVE:
+                view.pointerDragged(pointerId, point.x, point.y);
+                break;
+            case PdRemoteEvent::POINTER_UP:
+                view.pointerReleased(pointerId, point.x, point.y);
+                break;
+            case PdRemoteEvent::POINTER_CANCEL:
+                view.pointerCancelled(pointerId);
+                break;
+        }
+    });
     
-    for (auto& obj : guiObjects) {
-        obj->onMouseMoved(args);
+    if (numEvents > 0) {
+        markActive();
+    }
+}
+
+void ofApp::publishRemoteState() {
+    if (!remoteServer.isRunning()) return;
+    remoteViews.resize(views.size());
+    
+    for (size_t i = 0; i < views.size(); i++) {
+        PdPatchView& view = *views[i];
+        RemoteViewState& remote = remoteViews[i];
+        const PdPatchLayout* layout = view.getLayout();
+        PdObjectList& objects = view.getObjects();
+        
+        // Disposition complète (objets tous créés) envoyée une fois par version
+        if (!layout || layout->getNumWidgets() != objects.size()) continue;
+        if (!remote.published || remote.layoutVersion != view.getLayoutVersion()) {
+            remoteServer.publishLayout(i, *layout);
+            remote.layoutVersion = view.getLayoutVersion();
+            remote.published = true;
+            remote.values.assign(objects.size(), NAN);
+        }
+        
+        // Une entrée par objet modifié depuis la frame précédente : plusieurs
+        // messages vers un même symbole pendant la frame n'en font qu'une.
+        // Même sans client : le serveur garde les valeurs pour les suivants.
+        remoteValues.clear();
+        for (size_t j = 0; j < objects.size(); j++) {
+            float value = objects[j]->getValue();
+            if (value != remote.values[j]) {
+                remote.values[j] = value;
+                remoteValues.push_back({ (uint32_t)j, value });
+            }
+        }
+        remoteServer.publishValues(i, remoteValues);
     }
 }
 
 void ofApp::keyPressed(int key) {
+    handleKey(*focusedView, key);
+}
+
+void ofApp::handleKey(PdPatchView& view, int key) {
+    InputScope input(*this);
+    markActive();
     if (key == 'r') {
         // Reset tous les toggles
-        for (auto& obj : guiObjects) {
-            obj->setValue(0.0f);
-        }
+        setToggles(view, false);
         ofLogNotice("ofApp") << "All toggles reset";
     }
     else if (key == 'a') {
         // Activer tous les toggles
-        for (auto& obj : guiObjects) {
-            obj->setValue(1.0f);
-        }
+        setToggles(view, true);
         ofLogNotice("ofApp") << "All toggles activated";
     }
     else if (key == 't') {
-        // Toggle aléatoire
-        if (!guiObjects.empty()) {
-            int randomIndex = ofRandom(guiObjects.size());
-            PdToggle* toggle = static_cast<PdToggle*>(guiObjects[randomIndex].get());
+        // Toggle aléatoire, parmi les seuls toggles du canvas
+        vector<PdToggle*> toggles;
+        for (auto& obj : view.getVisibleObjects()) {
+            if (obj->getType() == GuiType::TOGGLE) toggles.push_back(static_cast<PdToggle*>(obj.get()));
+        }
+        if (!toggles.empty()) {
+            PdToggle* toggle = toggles[(size_t)ofRandom(toggles.size()) % toggles.size()];
             toggle->toggle();
+            sendQueue.send(toggle->getSendSymbolId(), toggle->getValue(), PdSendPolicy::IMMEDIATE);
             ofLogNotice("ofApp") << "Random toggle: " << toggle->getSendSymbol();
         }
     }
+    else if (key >= '1' && key <= '9') {
+        recallPreset(key - '1');
+    }
+    else if (key == 'S') {
+        capturePreset(presetSlot);
+    }
+    else if (key == 'm') {
+        // Le prochain chiffre lance un fondu au lieu d'un rappel direct
+        morphArmed = true;
+    }
+    else if (key == OF_KEY_BACKSPACE) {
+        // Revenir au canvas parent
+        view.closeSubpatch();
+    }
+    else if (key == 'b') {
+        // Basculer entre le dessin groupé et draw() par objet
+        useBatchRenderer = !useBatchRenderer;
+        for (auto& v : views) {
+            v->setBatchRenderer(useBatchRenderer);
+        }
+        ofLogNotice("ofApp") << "Batch rendering: " << (useBatchRenderer ? "on" : "off");
+    }
+    else if (key == 'f') {
+        // Basculer entre le rendu FBO et le dessin direct
+        useFboRenderer = !useFboRenderer;
+        for (auto& v : views) {
+            v->setFboRenderer(useFboRenderer);
+        }
+        ofLogNotice("ofApp") << "Renderer: " << (useFboRenderer ? "FBO" : "direct");
+    }
+    else if (key == 'p') {
+        // Graphe des temps par sous-système
+        showProfiler = !showProfiler;
+    }
+    else if (key == 'P') {
+        // Enregistrer puis exporter pour comparer les modes de rendu
+        PdProfiler& profiler = PdProfiler::get();
+        if (!profiler.isRecording()) {
+            profiler.startRecording();
+            ofLogNotice("ofApp") << "Profiler recording started";
+        } else {
+            profiler.stopRecording();
+            profiler.exportCsv("profile.csv");
+            profiler.exportChromeTrace("profile.json");
+        }
+    }
+    else if (key == 'l') {
+        lowLatency = !lowLatency;
+        ofLogNotice("ofApp") << "Low-latency input: " << (lowLatency ? "on" : "off");
+    }
+    else if (key == 'L') {
+        // Percentiles depuis le dernier rapport
+        PdLatencyTracker::get().logReport();
+        PdLatencyTracker::get().reset();
+    }
+    else if (key == 'c') {
+        // Forcer le rendu continu (débogage)
+        frameClock.setMode(frameClock.isContinuous() ? PdFrameClock::Mode::ON_DEMAND
+                                                     : PdFrameClock::Mode::CONTINUOUS);
+        ofLogNotice("ofApp") << "Rendering: " << (frameClock.isContinuous() ? "continuous" : "on demand");
+    }
+}
+
+void ofApp::setToggles(PdPatchView& view, bool on) {
+    for (auto& obj : view.getVisibleObjects()) {
+        if (obj->getType() != GuiType::TOGGLE) continue;
+        
+        PdToggle& toggle = static_cast<PdToggle&>(*obj);
+        if (toggle.isOn() == on) continue;
+        toggle.setOn(on);
+        sendQueue.send(toggle.getSendSymbolId(), toggle.getValue(), PdSendPolicy::IMMEDIATE);
+    }
 }
 
-void ofApp::createToggles() {
+vector<PdGuiObject*>& ofApp::collectPresetObjects() {
+    // Patchs principaux de toutes les vues (et objets graph-on-parent)
+    presetObjects.clear();
+    for (auto& view : views) {
+        for (auto& obj : view->getObjects()) {
+            presetObjects.push_back(obj.get());
+        }
+    }
+    return presetObjects;
+}
+
+void ofApp::recallPreset(size_t slot) {
+    if (!presetBank.hasSlot(slot)) {
+        ofLogNotice("ofApp") << "Preset " << slot + 1 << " is empty (S stores the current values)";
+        presetSlot = slot;
+        morphArmed = false;
+        return;
+    }
+    
+    if (morphArmed && presetBank.hasSlot(presetSlot) && presetSlot != slot) {
+        morph.active = true;
+        morph.from = presetSlot;
+        morph.to = slot;
+        morph.startMicros = ofGetElapsedTimeMicros();
+        ofLogNotice("ofApp") << "Morphing preset " << morph.from + 1 << " -> " << slot + 1;
+    } else {
+        morph.active = false;
+        uint64_t start = ofGetElapsedTimeMicros();
+        size_t numChanged = presetRecall.apply(presetBank, slot, slot, 0.0f, collectPresetObjects(), sendQueue);
+        ofLogNotice("ofApp") << "Preset " << slot + 1 << ": " << numChanged << " values in "
+                             << ofGetElapsedTimeMicros() - start << " us";
+    }
+    
+    presetSlot = slot;
+    morphArmed = false;
+}
+
+void ofApp::capturePreset(size_t slot) {
+    presetBank.capture(slot, collectPresetObjects());
+    if (presetBank.save()) {
+        ofLogNotice("ofApp") << "Preset " << slot + 1 << " stored (" << presetBank.getNumSymbols() << " symbols)";
+    }
+}
+
+void ofApp::updateMorph() {
+    if (!morph.active) return;
+    
+    float t = (float)(ofGetElapsedTimeMicros() - morph.startMicros) / MORPH_MICROS;
+    if (t >= 1.0f) {
+        t = 1.0f;
+        morph.active = false;
+    }
+    presetRecall.apply(presetBank, morph.from, morph.to, t, collectPresetObjects(), sendQueue);
+    markActive();
+}
+
+PdObjectList ofApp::createToggles() {
+    PdObjectList guiObjects;
+    
     // Créer 4 toggles avec différentes tailles
     float startX = 100.0f;
     float startY = 100.0f;
     float spacing = 80.0f;
     
     // Toggle 1 - Petit
-    auto toggle1 = make_unique<PdToggle>(
+    auto toggle1 = PdWidgetStore::get().create<PdToggle>(
         ofVec2f(startX, startY),
         ofVec2f(25, 25),
         "toggle_1_send",
@@ -134,7 +724,7 @@ void ofApp::createToggles() {
     guiObjects.push_back(move(toggle1));
     
     // Toggle 2 - Moyen
-    auto toggle2 = make_unique<PdToggle>(
+    auto toggle2 = PdWidgetStore::get().create<PdToggle>(
         ofVec2f(startX + spacing, startY),
         ofVec2f(40, 40),
         "toggle_2_send",
@@ -143,7 +733,7 @@ void ofApp::createToggles() {
     guiObjects.push_back(move(toggle2));
     
     // Toggle 3 - Grand
-    auto toggle3 = make_unique<PdToggle>(
+    auto toggle3 = PdWidgetStore::get().create<PdToggle>(
         ofVec2f(startX + spacing * 2, startY),
         ofVec2f(55, 55),
         "toggle_3_send",
@@ -152,23 +742,23 @@ void ofApp::createToggles() {
     guiObjects.push_back(move(toggle3));
     
     // Toggle 4 - Très grand
-    auto toggle4 = make_unique<PdToggle>(
+    auto toggle4 = PdWidgetStore::get().create<PdToggle>(
         ofVec2f(startX + spacing * 3, startY),
         ofVec2f(70, 70),
         "toggle_4_send",
         "toggle_4_receive"
     );
     guiObjects.push_back(move(toggle4));
-
-
-
+    
+    
+    
     // Créer 4 bangs avec différentes tailles
     startX = 100.0f;
     startY = 220.0f;  // En dessous des toggles
     spacing = 80.0f;
     
     // Bang 1 - Petit
-    auto bang1 = make_unique<PdBang>(
+    auto bang1 = PdWidgetStore::get().create<PdBang>(
         ofVec2f(startX, startY),
         ofVec2f(25, 25),
         "bang_1_send",
@@ -177,7 +767,7 @@ void ofApp::createToggles() {
     guiObjects.push_back(move(bang1));
     
     // Bang 2 - Moyen
-    auto bang2 = make_unique<PdBang>(
+    auto bang2 = PdWidgetStore::get().create<PdBang>(
         ofVec2f(startX + spacing, startY),
         ofVec2f(40, 40),
         "bang_2_send",
@@ -186,7 +776,7 @@ void ofApp::createToggles() {
     guiObjects.push_back(move(bang2));
     
     // Bang 3 - Grand
-    auto bang3 = make_unique<PdBang>(
+    auto bang3 = PdWidgetStore::get().create<PdBang>(
         ofVec2f(startX + spacing * 2, startY),
         ofVec2f(55, 55),
         "bang_3_send",
@@ -195,99 +785,35 @@ void ofApp::createToggles() {
     guiObjects.push_back(move(bang3));
     
     // Bang 4 - Très grand
-    auto bang4 = make_unique<PdBang>(
+    auto bang4 = PdWidgetStore::get().create<PdBang>(
         ofVec2f(startX + spacing * 3, startY),
         ofVec2f(70, 70),
         "bang_4_send",
         "bang_4_receive"
     );
     guiObjects.push_back(move(bang4));
+    
+    return guiObjects;
 }
 
-void ofApp::setupCallbacks() {
-    for (auto& obj : guiObjects) {
-        // Callback pour l'envoi vers Pure Data
-        obj->onSendToPd = [this](const string& symbol, float value) {
-            ofLogNotice("PD Send") << symbol << " = " << value;
-            // Ici on appellerait ofxPd::sendFloat(symbol, value);
-        };
-        
-        // Callback pour l'envoi de strings vers Pure Data
-        obj->onSendToPdString = [this](const string& symbol, const string& message) {
-            ofLogNotice("PD Send String") << symbol << " = " << message;
-            // Ici on appellerait ofxPd::sendSymbol(symbol, message);
-        };
-    }
-}
-
-void ofApp::setupFbo() {
-    guiFbo.allocate(ofGetWidth(), ofGetHeight());
-    guiFbo.begin();
-    ofClear(0, 0, 0, 0);
-    guiFbo.end();
+void ofApp::windowResized(int w, int h) {
+    // Les tuiles déjà dessinées sont gardées, seules les nouvelles sont dessinées
+    markActive();
+    layoutViews();
 }
 
-void ofApp::drawGuiObjects() {
-    // Méthode 1: Dessin direct (plus simple pour le test)
-    for (auto& obj : guiObjects) {
-        if (obj->isVisible()) {
-            ofPushMatrix();
-            ofTranslate(obj->getPosition().x, obj->getPosition().y);
-            obj->draw();
-            ofPopMatrix();
-        }
-    }
-    
-    // Méthode 2: Dessin via FBO (pour l'optimisation future)
-    // drawGuiObjectsToFbo();
-}
-
-void ofApp::drawGuiObjectsToFbo() {
-    // Vérifier quels objets ont besoin d'être redessinés
-    bool anyObjectNeedsUpdate = false;
-    
-    for (auto& obj : guiObjects) {
-        if (obj->needsUpdate()) {
-            anyObjectNeedsUpdate = true;
-            break;
-        }
-    }
+void ofApp::dragEvent(ofDragInfo dragInfo) {
+    // Le premier fichier .pd déposé remplace le patch de la vue visée,
+    // même pendant un chargement
+    PdPatchView* view = findView(dragInfo.position.x, dragInfo.position.y);
+    if (!view) view = focusedView;
     
-    // Si des objets ont changé ou si c'est la première fois
-    if (anyObjectNeedsUpdate || fboNeedsUpdate) {
-        guiFbo.begin();
-        
-        // Parcourir tous les objets et redessiner seulement ceux qui ont changé
-        for (auto& obj : guiObjects) {
-            if (obj->needsUpdate() && obj->isVisible()) {
-                // Récupérer la zone de mise à jour spécifique
-                ofRectangle updateRect = obj->getUpdateRegion();
-                
-                // Effacer la zone de l'objet GUI avec une petite marge
-                float margin = 1.0f;
-                ofEnableBlendMode(OF_BLENDMODE_ALPHA);
-                ofSetColor(0, 0, 0, 0); // Transparent
-                ofDrawRectangle(updateRect.x - margin, updateRect.y - margin,
-                               updateRect.width + 2 * margin, updateRect.height + 2 * margin);
-                
-                // Restaurer le blending normal et redessiner l'objet
-                ofEnableBlendMode(OF_BLENDMODE_ALPHA);
-                ofSetColor(255);
-                
-                // Utiliser la méthode drawToFbo de l'objet
-                obj->drawToFbo(guiFbo);
-                
-                // Marquer l'objet comme mis à jour
-                obj->clearUpdateFlag();
-            }
+    for (auto& file : dragInfo.files) {
+        if (ofToLower(ofFilePath::getFileExt(file)) == "pd") {
+            view->load(file);
+            return;
         }
-        
-        guiFbo.end();
-        fboNeedsUpdate = false;
     }
-    
-    // Dessiner le FBO
-    guiFbo.draw(0, 0);
 }
 
 void ofApp::simulateAutomaticChanges() {
@@ -297,9 +823,12 @@ void ofApp::simulateAutomaticChanges() {
     if (simulationTime > 2.0f) {
         simulationTime = 0.0f;
         
-        if (!guiObjects.empty() && ofRandom(1.0f) < 0.3f) { // 30% de chance
-            int randomIndex = ofRandom(guiObjects.size());
-            PdToggle* toggle = static_cast<PdToggle*>(guiObjects[randomIndex].get());
+        vector<PdToggle*> toggles;
+        for (auto& obj : getVisibleObjects()) {
+            if (obj->getType() == GuiType::TOGGLE) toggles.push_back(static_cast<PdToggle*>(obj.get()));
+        }
+        if (!toggles.empty() && ofRandom(1.0f) < 0.3f) { // 30% de chance
+            PdToggle* toggle = toggles[(size_t)ofRandom(toggles.size()) % toggles.size()];
             toggle->toggle();
         }
     }
@@ -307,7 +836,7 @@ void ofApp::simulateAutomaticChanges() {
 
 int ofApp::countActiveToggles() {
     int count = 0;
-    for (auto& obj : guiObjects) {
+    for (auto& obj : getVisibleObjects()) {
         if (obj->getValue() > 0.5f) {
             count++;
         }
@@ -316,20 +845,80 @@ int ofApp::countActiveToggles() {
 }
 
 void ofApp::drawDebugInfo() {
-    ofSetColor(255, 255, 0);
-    ofDrawBitmapString("Controls:", 20, ofGetHeight() - 80);
-    ofDrawBitmapString("'r' - Reset all toggles", 20, ofGetHeight() - 60);
-    ofDrawBitmapString("'a' - Activate all toggles", 20, ofGetHeight() - 40);
-    ofDrawBitmapString("'t' - Toggle random", 20, ofGetHeight() - 20);
+    const char* controls[] = {
+        "Controls:",
+        useBatchRenderer ? "'b' - Toggle batching (on)" : "'b' - Toggle batching (off)",
+        useFboRenderer ? "'f' - Toggle renderer (FBO)" : "'f' - Toggle renderer (direct)",
+        frameClock.isContinuous() ? "'c' - Toggle rendering (continuous)" : "'c' - Toggle rendering (on demand)",
+        "'r' - Reset all toggles",
+        "'a' - Activate all toggles",
+        "'t' - Toggle random",
+        "'p' - Toggle profiler, 'P' - Record/export profile",
+        lowLatency ? "'l' - Low-latency input (on), 'L' - Latency report" : "'l' - Low-latency input (off), 'L' - Latency report",
+        "'1'-'9' - Recall preset, 'S' - Store preset, 'm' - Morph to next recall",
+        "Backspace - Close subpatch"
+    };
+    
+    primitiveBatch.begin();
+    
+    ofColor controlColor(255, 255, 0);
+    for (size_t i = 0; i < controlLabels.size(); i++) {
+        controlLabels[i].set(controls[i], strlen(controls[i]));
+        primitiveBatch.addText(controlLabels[i], 20, ofGetHeight() - 220 + 20 * (int)i, controlColor);
+    }
+    
+    // Compteurs de la file sortante (remplacent un log par message)
+    setCountLabel(sentLabel, "Sent to Pd: ", (long long)sendQueue.getNumSent());
+    setCountLabel(coalescedLabel, "Coalesced: ", (long long)sendQueue.getNumCoalesced());
+    primitiveBatch.addText(sentLabel, 20, ofGetHeight() - 260, controlColor);
+    primitiveBatch.addText(coalescedLabel, 20, ofGetHeight() - 240, controlColor);
+    
+    // Latences entrée → Pd et entrée → image
+    char latencyText[128];
+    PdLatencyTracker& latency = PdLatencyTracker::get();
+    sendLatencyLabel.set(latencyText, latency.formatSummary(PdLatencyStage::SEND, latencyText, sizeof(latencyText)));
+    presentLatencyLabel.set(latencyText, latency.formatSummary(PdLatencyStage::PRESENT, latencyText, sizeof(latencyText)));
+    primitiveBatch.addText(sendLatencyLabel, 20, ofGetHeight() - 300, controlColor);
+    primitiveBatch.addText(presentLatencyLabel, 20, ofGetHeight() - 280, controlColor);
     
     // Afficher les informations sur les objets qui ont le focus
-    ofSetColor(200, 200, 255);
+    ofColor activeColor(200, 200, 255);
+    for (size_t i = 0; i < numActiveSymbolLabels; i++) {
+        primitiveBatch.addText(activeSymbolLabels[i], 400, 300 + 15 * (int)i, activeColor);
+    }
+    
+    primitiveBatch.draw();
+}
+
+void ofApp::updateActiveState() {
+    setCountLabel(totalLabel, "Total toggles: ", getVisibleObjects().size());
+    setCountLabel(activeLabel, "Active toggles: ", countActiveToggles());
+    
+    // Labels "Active: symbole" des objets actifs, tant qu'ils tiennent à l'écran
     int yPos = 300;
-    for (auto& obj : guiObjects) {
+    numActiveSymbolLabels = 0;
+    for (auto& obj : getVisibleObjects()) {
         if (obj->getValue() > 0.5f) {
-            ofDrawBitmapString("Active: " + obj->getSendSymbol(), 400, yPos);
+            if (numActiveSymbolLabels == activeSymbolLabels.size()) {
+                activeSymbolLabels.emplace_back();
+            }
+            
+            // Chaîne de travail réutilisée : pas d'allocation une fois la capacité atteinte
+            scratchText.assign("Active: ");
+            scratchText.append(obj->getSendSymbol());
+            activeSymbolLabels[numActiveSymbolLabels].set(scratchText);
+            numActiveSymbolLabels++;
+            
             yPos += 15;
             if (yPos > ofGetHeight() - 50) break;
         }
     }
 }
+
+void ofApp::setCountLabel(PdTextLabel& label, const char* prefix, long long count) {
+    char buffer[64];
+    size_t prefixLength = min(strlen(prefix), sizeof(buffer) - PdNumberFormat::MAX_LENGTH);
+    memcpy(buffer, prefix, prefixLength);
+    int length = PdNumberFormat::formatInt(buffer + prefixLength, sizeof(buffer) - prefixLength, count);
+    label.set(buffer, prefixLength + length);
+}
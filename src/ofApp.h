@@ -5,48 +5,205 @@
 #include "Toggle.h"
 #include "Bang.h"
 #include "PatchParser.h"
+#include "PatchCache.h"
 #include "Slider.h"
+#include "Subpatch.h"
+#include "SpatialGrid.h"
+#include "EventRouter.h"
+#include "PrimitiveBatch.h"
+#include "TextRenderer.h"
+#include "MessageRouter.h"
+#include "SendQueue.h"
+#include "WidgetStore.h"
+#include "UpdateScheduler.h"
+#include "FrameClock.h"
+#include "Profiler.h"
+#include "PatchWatcher.h"
+#include "PatchDiff.h"
+#include "PatchLoader.h"
+#include "PatchView.h"
+#include "PatchWindow.h"
+#include "Snapshot.h"
+#include "RemoteServer.h"
+#include "JobSystem.h"
+#include "Presets.h"
+#include "Latency.h"
 #include <memory>
 
 class ofApp : public ofBaseApp {
 public:
     void setup() override;
+    
+    // Mesure des chemins de rendu sur un patch synthétique, puis sortie (--bench-render)
+    void setRenderBenchmark(size_t numObjects, int frames, const string& jsonPath);
+    
+    // Sans affichage (--snapshot) : images des patchs à cadence fixe, écrites
+    // par un thread d'encodage ; sortie après settings.maxFrames images
+    void setSnapshotMode(const PdSnapshotSettings& settings);
+    
+    // Interface distante sur le port donné (--remote), 0 = désactivée
+    void setRemotePort(int port) { remotePort = port; }
+    
+    // Chemin rapide (--low-latency, touche 'l') : les messages d'une entrée
+    // partent vers Pd dès l'événement, sans attendre la fin de la frame, et la
+    // frame suivante est présentée sans attendre la période
+    void setLowLatency(bool enabled) { lowLatency = enabled; }
+    
     void update() override;
     void draw() override;
+    void exit() override;
     
     // Événements souris
     void mousePressed(int x, int y, int button) override;
     void mouseDragged(int x, int y, int button) override;
     void mouseReleased(int x, int y, int button) override;
     void mouseMoved(int x, int y) override;
+    void mouseScrolled(int x, int y, float scrollX, float scrollY) override;
+    
+    // Événements tactiles (une capture par identifiant de doigt)
+    void touchDown(ofTouchEventArgs& touch) override;
+    void touchMoved(ofTouchEventArgs& touch) override;
+    void touchUp(ofTouchEventArgs& touch) override;
+    void touchCancelled(ofTouchEventArgs& touch) override;
     
     // Événements clavier
     void keyPressed(int key) override;
     
+    // Événements fenêtre
+    void windowResized(int w, int h) override;
+    void dragEvent(ofDragInfo dragInfo) override; // Déposer un .pd pour l'ouvrir
+    
+    // Patchs à ouvrir (avant ofRunApp) : un par fenêtre, ou tous côte à côte
+    // dans la fenêtre principale ; sans appel, patch.pd seul
+    void setPatches(const vector<string>& paths, bool tiled);
+    size_t getNumViews() const { return views.size(); }
+    // Application d'une fenêtre secondaire affichant la vue index
+    std::shared_ptr<PdPatchWindow> createPatchWindow(size_t index);
+
 private:
-    // Vecteur de pointeurs vers les objets GUI
-    vector<unique_ptr<PdGuiObject>> guiObjects;
+    // Messages entrants de Pd. Les callbacks ofxPd (receiveFloat/receiveBang)
+    // appellent messageRouter.pushFloat()/pushBang() depuis le thread audio.
+    // Un seul routeur pour tous les patchs : un symbole peut viser plusieurs vues.
+    PdMessageRouter messageRouter;
+    
+    // Messages sortants vers Pd, fusionnés puis publiés une fois par frame
+    PdSendQueue sendQueue;
+    
+    // Tampon de primitives partagé par tous les objets (dessin groupé)
+    PdPrimitiveBatch primitiveBatch;
+    bool useBatchRenderer = true;
+    bool useFboRenderer = true;
     
-    // FBO pour le rendu optimisé
-    ofFbo guiFbo;
-    bool fboNeedsUpdate = true;
+    // Patchs affichés, déclarés après les ressources qu'ils partagent
+    static constexpr const char* PATCH_PATH = "patch.pd";
+    PdPatchResources resources{messageRouter, sendQueue, primitiveBatch};
+    vector<string> patchPaths;
+    vector<std::unique_ptr<PdPatchView>> views;
+    vector<PdPatchView*> tiledViews; // Vues de la fenêtre principale
+    PdPatchView* focusedView = nullptr;
+    
+    // Vue qui a reçu l'appui de chaque pointeur (drag hors de sa zone)
+    struct PointerView {
+        int pointerId;
+        PdPatchView* view;
+    };
+    vector<PointerView> pointerViews;
+    
+    // Rendu à la demande ; cadence réduite seulement quand la boucle ne peut pas bloquer
+    static constexpr int ACTIVE_FRAME_RATE = 60;
+    static constexpr int IDLE_FRAME_RATE = 10;
+    PdFrameClock frameClock;
+    
+    struct RenderBenchmark {
+        size_t numObjects = 0;
+        int frames = 0;
+        string jsonPath;
+    } renderBenchmark;
+    
+    PdSnapshotSettings snapshotSettings;
+    PdSnapshotRecorder snapshotRecorder;
+    
+    // Tablettes : disposition puis valeurs modifiées de chaque vue, une fois
+    // par frame ; leurs pointeurs passent par le même routage que la souris
+    static constexpr int REMOTE_POINTER_BASE = 1 << 20; // Hors des identifiants de doigts locaux
+    PdRemoteServer remoteServer;
+    int remotePort = 0;
+    struct RemoteViewState {
+        uint32_t layoutVersion = 0;
+        bool published = false;
+        vector<float> values;
+    };
+    vector<RemoteViewState> remoteViews;
+    vector<PdRemoteValue> remoteValues;
+    
+    // Presets de tous les objets des patchs (touches 1-9, S pour capturer,
+    // m puis un chiffre pour un fondu de MORPH_MICROS depuis le preset courant)
+    static constexpr uint64_t MORPH_MICROS = 2000000;
+    PdPresetBank presetBank;
+    PdPresetRecall presetRecall;
+    vector<PdGuiObject*> presetObjects;
+    size_t presetSlot = 0;
+    bool morphArmed = false;
+    struct Morph {
+        bool active = false;
+        size_t from = 0;
+        size_t to = 0;
+        uint64_t startMicros = 0;
+    } morph;
+    
+    // Latence des entrées : datation des événements, envoi immédiat en mode rapide
+    bool lowLatency = false;
+    struct InputScope {
+        ofApp& app;
+        explicit InputScope(ofApp& app) : app(app) { app.beginInput(); }
+        ~InputScope() { app.endInput(); }
+    };
+    
+    // Textes de l'interface, mis en forme une seule fois et remis en page
+    // seulement quand leur contenu change
+    PdTextLabel titleLabel;
+    PdTextLabel totalLabel;
+    PdTextLabel activeLabel;
+    PdTextLabel sentLabel;
+    PdTextLabel coalescedLabel;
+    PdTextLabel sendLatencyLabel;
+    PdTextLabel presentLatencyLabel;
+    vector<PdTextLabel> controlLabels;
+    vector<PdTextLabel> activeSymbolLabels;
+    size_t numActiveSymbolLabels = 0;
+    bool activeStateDirty = true;
+    bool showProfiler = false;
+    string scratchText;
     
     // Compteur pour la simulation
     float simulationTime = 0.0f;
     
     // Méthodes privées
-    void createToggles();
-    void setupCallbacks();
-    void setupFbo();
-    void drawGuiObjects();
-    void drawGuiObjectsToFbo();
-    void drawGuiObjectsToFboWithScissor();
-    void drawGuiObjectsToFboOptimized();
+    PdObjectList createToggles();
+    PdPatchView& addView();
+    void layoutViews();
+    PdPatchView* findView(float x, float y);
+    PdPatchView* findPointerView(int pointerId);
+    void capturePointer(int pointerId, PdPatchView* view);
+    void releasePointer(int pointerId);
+    void handleKey(PdPatchView& view, int key);
+    void setToggles(PdPatchView& view, bool on);
+    vector<PdGuiObject*>& collectPresetObjects();
+    void recallPreset(size_t slot);
+    void capturePreset(size_t slot);
+    void updateMorph();
+    PdObjectList& getVisibleObjects();
+    void markActive();
+    void beginInput();
+    void endInput();
+    void sendPendingToPd();
+    void runRenderBenchmark();
+    void drawSnapshot();
+    void applyRemoteEvents();
+    void publishRemoteState();
     void simulateAutomaticChanges();
     int countActiveToggles();
     void drawDebugInfo();
-    
-    // Méthodes utilitaires pour l'optimisation FBO
-    vector<ofRectangle> mergeAdjacentRectangles(const vector<ofRectangle>& rectangles);
-    bool areAdjacent(const ofRectangle& a, const ofRectangle& b);
+    void updateActiveState();
+    void setCountLabel(PdTextLabel& label, const char* prefix, long long count);
 };